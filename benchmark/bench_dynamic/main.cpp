@@ -0,0 +1,148 @@
+﻿/// \example bench_dynamic/main.cpp
+/// 本例子测量动力学中小矩阵核函数以及整个求解器的耗时:
+/// screw 中连续存储的版本在 USE_AVX2 打开时使用 AVX2 实现，与带行间距的通用版本比较
+/// matrix 中编译期确定维数的版本，与运行期维数的版本比较
+/// 大矩阵的分块乘法与分解，与逐项计算的版本比较
+/// 实时循环中连续变化的位置，kinPos 热启动与否的比较
+///
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "aris.hpp"
+
+using namespace aris::dynamic;
+
+auto bench(const std::string &name, const std::function<void(int)> &func, int count = 1000000)->void
+{
+	func(0);
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)func(i);
+	auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / count;
+
+	if (ns < 1e6)
+		std::cout << std::setw(40) << std::left << name << std::fixed << std::setprecision(2) << ns << " ns" << std::endl;
+	else
+		std::cout << std::setw(40) << std::left << name << std::fixed << std::setprecision(2) << ns / 1e6 << " ms" << std::endl;
+}
+
+int main()
+{
+#ifdef ARIS_USE_AVX2
+	std::cout << "kernels: avx2" << std::endl;
+#else
+	std::cout << "kernels: scalar" << std::endl;
+#endif
+
+	// 准备多组输入，避免编译器把循环优化掉 //
+	const int n = 64;
+	std::mt19937 gen(0);
+	std::uniform_real_distribution<double> dis(-1.0, 1.0);
+	std::vector<double> pms(16 * n), vss(6 * n), ivs(10 * n), out(36 * n);
+	for (int i = 0; i < n; ++i)
+	{
+		double pe[6]{ dis(gen), dis(gen), dis(gen), dis(gen), dis(gen), dis(gen) };
+		s_pe2pm(pe, pms.data() + 16 * i);
+		for (int j = 0; j < 6; ++j)vss[6 * i + j] = dis(gen);
+		double iv[10]{ 1.0 + std::abs(dis(gen)), dis(gen), dis(gen), dis(gen), 2.0, 2.0, 2.0, 0.1 * dis(gen), 0.1 * dis(gen), 0.1 * dis(gen) };
+		std::copy(iv, iv + 10, ivs.data() + 10 * i);
+	}
+	auto pm = [&](int i) { return pms.data() + 16 * (i % n); };
+	auto vs = [&](int i) { return vss.data() + 6 * (i % n); };
+	auto vs2 = [&](int i) { return vss.data() + 6 * ((i + 1) % n); };
+	auto iv = [&](int i) { return ivs.data() + 10 * (i % n); };
+	auto o = [&](int i) { return out.data() + 36 * (i % n); };
+
+	bench("s_pm_dot_pm", [&](int i) { s_pm_dot_pm(pm(i), pm(i + 1), o(i)); });
+	bench("s_pm_dot_pm (s_mm)", [&](int i) { s_mm(4, 4, 4, pm(i), pm(i + 1), o(i)); });
+	bench("s_pm2pm", [&](int i) { s_pm2pm(pm(i), pm(i + 1), o(i)); });
+	bench("s_inv_pm_dot_v3", [&](int i) { s_inv_pm_dot_v3(pm(i), vs(i), o(i)); });
+	bench("s_inv_pm_dot_v3 (generic)", [&](int i) { s_inv_pm_dot_v3(pm(i), vs(i), 1, o(i), 1); });
+	bench("s_tv", [&](int i) { s_tv(pm(i), vs(i), o(i)); });
+	bench("s_tv (generic)", [&](int i) { s_tv(pm(i), vs(i), 1, o(i), 1); });
+	bench("s_tf", [&](int i) { s_tf(pm(i), vs(i), o(i)); });
+	bench("s_tf (generic)", [&](int i) { s_tf(pm(i), vs(i), 1, o(i), 1); });
+	bench("s_cv", [&](int i) { s_cv(vs(i), vs2(i), o(i)); });
+	bench("s_cv (generic)", [&](int i) { s_cv(vs(i), 1, vs2(i), 1, o(i), 1); });
+	bench("s_cf", [&](int i) { s_cf(vs(i), vs2(i), o(i)); });
+	bench("s_cf (generic)", [&](int i) { s_cf(vs(i), 1, vs2(i), 1, o(i), 1); });
+	bench("s_iv2iv", [&](int i) { s_iv2iv(pm(i), iv(i), o(i)); });
+	bench("s_iv2im + s_im2im", [&](int i) { double im[36]; s_iv2im(iv(i), im); s_im2im(pm(i), im, o(i)); });
+
+	// 维数在运行期才确定时无法展开，volatile 的维数用来模拟这种情况 //
+	std::vector<double> mtxs(36 * n);
+	for (auto &v : mtxs)v = dis(gen);
+	auto mtx = [&](int i) { return mtxs.data() + 36 * (i % n); };
+	volatile aris::Size six{ 6 }, one{ 1 };
+	bench("s_mm<6, 6, 6>", [&](int i) { s_mm<6, 6, 6>(mtx(i), 6, mtx(i + 1), ColMajor{ 6 }, o(i), 6); });
+	bench("s_mm(6, 6, 6) runtime", [&](int i) { s_mm(six, six, six, mtx(i), 6, mtx(i + 1), ColMajor{ 6 }, o(i), 6); });
+	bench("s_mm(5, 5, 5) runtime", [&](int i) { s_mm(six - 1, six - 1, six - 1, mtx(i), 6, mtx(i + 1), ColMajor{ 6 }, o(i), 6); });
+	bench("s_mm<6, 1, 6>", [&](int i) { s_mm<6, 1, 6>(mtx(i), 6, vs(i), 1, o(i), 1); });
+	bench("s_mm(6, 1, 6) runtime", [&](int i) { s_mm(six, one, six, mtx(i), 6, vs(i), 1, o(i), 1); });
+
+	// 整个机器人的求解 //
+	auto model = aris::robot::createModelRokaeXB4();
+	model->generalMotionPool().at(0).setMpq(std::array<double, 7>{0.32, 0.0, 0.6295, 0, 0, 0, 1}.data());
+	model->solverPool().at(0).kinPos();
+	auto &fwd = dynamic_cast<UniversalSolver&>(model->solverPool().at(1));
+	auto &inv_dyn = dynamic_cast<UniversalSolver&>(model->solverPool().at(2));
+	bench("ForwardKinematicSolver::kinPos", [&](int) { fwd.kinPos(); });
+	bench("InverseDynamicSolver::dynAccAndFce", [&](int) { inv_dyn.dynAccAndFce(); });
+
+	// stewart 正解，1ms 周期下的连续轨迹 //
+	for (auto warm_start : { false, true })
+	{
+		auto stewart = aris::dynamic::createModelStewart();
+		auto &stewart_fwd = dynamic_cast<UniversalSolver&>(stewart->solverPool().at(1));
+		stewart_fwd.setWarmStart(warm_start);
+		stewart->generalMotionPool()[0].setMpe(std::array<double, 6>{0, 0, 0.6, 0, 0, 0}.data(), "313");
+		stewart->solverPool().at(0).kinPos();
+		double mp0[6];
+		for (int j = 0; j < 6; ++j)mp0[j] = stewart->motionPool()[j].mp();
+		aris::Size iter_count{ 0 };
+		bench(warm_start ? "ForwardKinematicSolver::kinPos warm" : "ForwardKinematicSolver::kinPos cold", [&](int i)
+		{
+			for (int j = 0; j < 6; ++j)stewart->motionPool()[j].setMp(mp0[j] + 0.05 * std::sin(2 * aris::PI * i / 2000.0 + j));
+			if (!stewart_fwd.kinPos())std::cout << "stewart kinPos failed" << std::endl;
+			iter_count += stewart_fwd.iterCount();
+		}, 20000);
+		std::cout << std::setw(40) << std::left << "  average iter count" << double(iter_count) / 20001 << std::endl;
+	}
+
+	// 大矩阵，例如标定时的辨识矩阵 //
+	const aris::Size big = 512, rows = 100000, cols = 78;
+	std::vector<double> big_a(big * big), big_b(big * big), big_c(big * big);
+	for (auto &v : big_a)v = dis(gen);
+	for (auto &v : big_b)v = dis(gen);
+	const aris::Size thread_num = std::max<aris::Size>(std::thread::hardware_concurrency(), 1);
+	bench("s_mm 512x512x512 blocked", [&](int) { s_mm(big, big, big, big_a.data(), big_b.data(), big_c.data()); }, 3);
+	bench("s_mma_parallel 512x512x512", [&](int) { s_mma_parallel(big, big, big, 1.0, big_a.data(), to_stride(big), big_b.data(), to_stride(big), big_c.data(), to_stride(big), thread_num); }, 3);
+	bench("s_mm 512x512x512 naive", [&](int)
+	{
+		for (aris::Size r = 0; r < big; ++r)for (aris::Size c = 0; c < big; ++c)
+		{
+			double value{ 0 };
+			for (aris::Size u = 0; u < big; ++u)value += big_a[r * big + u] * big_b[u * big + c];
+			big_c[r * big + c] = value;
+		}
+	}, 3);
+
+	std::vector<double> clb_a(rows * cols), clb_u(rows * cols), clb_tau(rows);
+	std::vector<aris::Size> clb_p(rows);
+	for (auto &v : clb_a)v = dis(gen);
+	aris::Size rank;
+	bench("s_householder_utp 100000x78 blocked", [&](int) { s_householder_utp(rows, cols, clb_a.data(), clb_u.data(), clb_tau.data(), clb_p.data(), rank); }, 1);
+	bench("s_householder_utp_parallel 100000x78", [&](int) { clb_u = clb_a; s_householder_utp_parallel(rows, cols, clb_u.data(), cols, clb_tau.data(), 1, clb_p.data(), rank, 1e-10, thread_num); }, 1);
+	bench("s_householder_utp 100000x78 by column", [&](int) { s_householder_utp(rows, cols, clb_a.data(), RowMajor{ cols }, clb_u.data(), RowMajor{ cols }, clb_tau.data(), 1, clb_p.data(), rank); }, 1);
+
+	double sum{ 0 };
+	for (auto v : out)sum += v;
+	std::cout << "checksum: " << sum << std::endl;
+
+	return 0;
+}
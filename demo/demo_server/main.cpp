@@ -206,7 +206,7 @@ int main(int argc, char *argv[])
 			for (auto result = result_list.begin(); result != result_list.end();)
 			{
 				auto cmd_ret = std::get<1>(*result);
-				if (cmd_ret->finished.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
+				if (cmd_ret->finished.isFinished())
 				{
 					auto ret = cmd_ret->ret;
 					auto &msg = std::get<0>(*result);
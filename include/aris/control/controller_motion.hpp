@@ -73,6 +73,62 @@ namespace aris::control
 
 		friend class Controller;
 	};
+	// CiA402 状态机，根据当前状态字以及控制字，返回驱动器下一周期的状态字（只含状态位） //
+	auto cia402NextStatus(std::uint16_t status_word, std::uint16_t control_word)->std::uint16_t;
+
+	// 仿真电机，不需要任何硬件，实现 CiA402 状态机以及 csp/csv/cst 模式下的驱动器响应 //
+	// 每周期 recv() 时根据上一周期发出的指令更新实际值，实际位置以一阶惯性跟随指令位置 //
+	class SimulatedMotion : public Motion
+	{
+	public:
+		auto virtual saveXml(aris::core::XmlElement &xml_ele) const->void override;
+		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
+		auto virtual send()->void override;
+		auto virtual recv()->void override;
+		// 每周期实际位置向指令位置靠近的比例，1.0 表示下一周期即到达 //
+		auto followingRatio()const->double;
+		auto setFollowingRatio(double ratio)->void;
+		auto samplePeriodNs()const->std::int64_t;
+		auto setSamplePeriodNs(std::int64_t period_ns)->void;
+
+		auto virtual controlWord()const->std::uint16_t override;
+		auto virtual modeOfOperation()const->std::uint8_t override;
+		auto virtual targetPos()const->double override;
+		auto virtual targetVel()const->double override;
+		auto virtual targetCur()const->double override;
+		auto virtual offsetVel()const->double override;
+		auto virtual offsetCur()const->double override;
+
+		auto virtual setControlWord(std::uint16_t control_word)->void override;
+		auto virtual setModeOfOperation(std::uint8_t mode)->void override;
+		auto virtual setTargetPos(double pos)->void override;
+		auto virtual setTargetVel(double vel)->void override;
+		auto virtual setTargetCur(double cur)->void override;
+		auto virtual setOffsetVel(double vel)->void override;
+		auto virtual setOffsetCur(double cur)->void override;
+
+		auto virtual statusWord()->std::uint16_t override;
+		auto virtual modeOfDisplay()->std::uint8_t override;
+		auto virtual actualPos()->double override;
+		auto virtual actualVel()->double override;
+		auto virtual actualCur()->double override;
+
+		auto virtual disable()->int override;
+		auto virtual enable()->int override;
+		auto virtual home()->int override;
+		auto virtual mode(std::uint8_t md)->int override;
+
+		virtual ~SimulatedMotion();
+		explicit SimulatedMotion(const std::string &name = "simulated_motion", std::uint16_t phy_id = 0
+			, double max_pos = 1.0, double min_pos = -1.0, double max_vel = 1.0, double min_vel = -1.0, double max_acc = 1.0, double min_acc = -1.0
+			, double max_pos_following_error = 1.0, double max_vel_following_error = 1.0, double pos_factor = 1.0, double pos_offset = 0.0, double home_pos = 0.0);
+		ARIS_REGISTER_TYPE(SimulatedMotion);
+		ARIS_DELETE_BIG_FOUR(SimulatedMotion);
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
 	class Controller : public virtual Master
 	{
 	public:
@@ -1,10 +1,28 @@
 ﻿#ifndef ARIS_CONTROL_ETHERCAT_H_
 #define ARIS_CONTROL_ETHERCAT_H_
 
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <aris/core/completion.hpp>
 #include <aris/control/controller_motion.hpp>
 
 namespace aris::control
 {
+	// pdo entry 在 domain 过程数据中的位置，由 EthercatMaster::init() 解析一次 //
+	// 实时线程中可以直接读写，无需再查找 pdo map //
+	struct PdoBinding
+	{
+		std::uint8_t *data{ nullptr };
+		std::uint8_t bit_position{ 0 };
+		aris::Size bit_size{ 0 };
+	};
+
 	class PdoEntry :public aris::core::Object
 	{
 	public:
@@ -13,6 +31,7 @@ namespace aris::control
 		
 		auto ecHandle()->std::any&;
 		auto ecHandle()const->const std::any& { return const_cast<std::decay_t<decltype(*this)>*>(this)->ecHandle(); }
+		auto binding()const->const PdoBinding&;
 		auto index()const->std::uint16_t;
 		auto subindex()const->std::uint8_t;
 		auto bitSize()const->aris::Size;
@@ -59,6 +78,35 @@ namespace aris::control
 		aris::core::ImpPtr<Imp> imp_;
 	};
 
+	class EthercatSlave;
+	// 异步SDO请求，由 EthercatSlave::readSdoAsync() 或 writeSdoAsync() 创建，在主站的非实时工作线程中执行 //
+	struct SdoRequest
+	{
+		enum State
+		{
+			PENDING = 0,
+			SUCCESS = 1,
+			FAILED = 2,
+			TIMEOUT = 3,
+			ABORTED = 4  // 主站析构时仍在队列中，未执行 //
+		};
+
+		EthercatSlave *slave;
+		std::uint16_t index;
+		std::uint8_t subindex;
+		bool is_write;
+		std::vector<std::uint8_t> data;                   // 写入的数据，或读到的数据 //
+		std::chrono::steady_clock::time_point deadline;   // 在此之前仍未开始执行的请求以 TIMEOUT 结束 //
+		std::function<void(SdoRequest &)> callback;       // 结束后在工作线程中调用，可以为空 //
+		std::atomic<int> state{ PENDING };
+		std::uint32_t abort_code{ 0 };                    // 从站返回的 abort code，0 表示不是从站拒绝 //
+		int error_code{ 0 };                              // 底层接口的返回值 //
+		aris::core::Completion finished;                  // 结束后置位，可用 finished.wait() 等待 //
+
+		template<typename ValueType>
+		auto value()const->ValueType { ValueType v{}; std::memcpy(&v, data.data(), std::min(sizeof(ValueType), data.size())); return v; }
+	};
+
 	class EthercatSlave : virtual public Slave
 	{
 	public:
@@ -79,6 +127,24 @@ namespace aris::control
 		template<typename ValueType>
 		auto writePdo(std::uint16_t index, std::uint8_t subindex, const ValueType &value)->void { writePdo(index, subindex, &value, sizeof(ValueType) * 8); }
 		auto writePdo(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size bit_size)->void;
+		
+		// 以下函数使用已绑定的pdo，字节对齐时直接读写过程数据 //
+		auto pdoBinding(std::uint16_t index, std::uint8_t subindex)const->PdoBinding;
+		template<typename ValueType>
+		auto readPdo(const PdoBinding &pdo, ValueType &value)->void
+		{
+			if (pdo.bit_position == 0 && pdo.bit_size == sizeof(ValueType) * 8) std::memcpy(&value, pdo.data, sizeof(ValueType));
+			else readPdo(pdo, &value, sizeof(ValueType) * 8);
+		}
+		auto readPdo(const PdoBinding &pdo, void *value, aris::Size bit_size)->void;
+		template<typename ValueType>
+		auto writePdo(const PdoBinding &pdo, const ValueType &value)->void
+		{
+			if (pdo.bit_position == 0 && pdo.bit_size == sizeof(ValueType) * 8) std::memcpy(pdo.data, &value, sizeof(ValueType));
+			else writePdo(pdo, &value, sizeof(ValueType) * 8);
+		}
+		auto writePdo(const PdoBinding &pdo, const void *value, aris::Size bit_size)->void;
+		
 		template<typename ValueType>
 		auto readSdo(std::uint16_t index, std::uint8_t subindex, ValueType &value)->void { readSdo(index, subindex, &value, sizeof(ValueType)); }
 		auto readSdo(std::uint16_t index, std::uint8_t subindex, void *value, aris::Size byte_size)->void;
@@ -86,11 +152,29 @@ namespace aris::control
 		auto writeSdo(std::uint16_t index, std::uint8_t subindex, const ValueType &value)->void { writeSdo(index, subindex, &value, sizeof(ValueType)); }
 		auto writeSdo(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size byte_size)->void;
 
+		// 异步读写SDO，立即返回，同一从站的请求按提交顺序执行，不同从站的请求可同时执行 //
+		// timeout 为请求在队列中最多等待的时间 //
+		using SdoCallback = std::function<void(SdoRequest &)>;
+		auto readSdoAsync(std::uint16_t index, std::uint8_t subindex, aris::Size byte_size, SdoCallback callback = nullptr
+			, std::chrono::milliseconds timeout = std::chrono::milliseconds(10000))->std::shared_ptr<SdoRequest>;
+		template<typename ValueType>
+		auto writeSdoAsync(std::uint16_t index, std::uint8_t subindex, const ValueType &value, SdoCallback callback = nullptr
+			, std::chrono::milliseconds timeout = std::chrono::milliseconds(10000))->std::shared_ptr<SdoRequest>
+		{
+			return writeSdoAsync(index, subindex, &value, sizeof(ValueType), std::move(callback), timeout);
+		}
+		auto writeSdoAsync(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size byte_size, SdoCallback callback = nullptr
+			, std::chrono::milliseconds timeout = std::chrono::milliseconds(10000))->std::shared_ptr<SdoRequest>;
+
 		virtual ~EthercatSlave();
 		explicit EthercatSlave(const std::string &name = "ethercat_slave", std::uint16_t phy_id = 0, std::uint32_t vendor_id = 0x00000000, std::uint32_t product_code = 0x00000000, std::uint32_t revision_num = 0x00000000, std::uint32_t dc_assign_activate = 0x00000000);
 		ARIS_REGISTER_TYPE(EthercatSlave);
 		ARIS_DELETE_BIG_FOUR(EthercatSlave);
 
+	protected:
+		// 在 EthercatMaster::init() 绑定完所有pdo之后调用，子类可以在此缓存自己的 PdoBinding //
+		auto virtual init()->void {}
+
 	private:
 		struct Imp;
 		aris::core::ImpPtr<Imp> imp_;
@@ -104,7 +188,64 @@ namespace aris::control
 		auto ecHandle()const->const std::any& { return const_cast<std::decay_t<decltype(*this)> *>(this)->ecHandle(); }
 		auto ecSlavePool()->aris::core::RefPool<EthercatSlave>&;
 		auto ecSlavePool()const->const aris::core::RefPool<EthercatSlave>& { return const_cast<std::decay_t<decltype(*this)> *>(this)->ecSlavePool(); }
-		auto scan()->void;
+		// 扫描总线，从站按总线上的位置排列在 slavePool 中 //
+		// 与现有配置相比，第一个变化的从站之前的从站保持不变，此后的从站重新建立 //
+		// 重新建立的从站按 (vendor_id, product_code, revision_num) 从缓存中复制pdo配置，缓存中没有的型号才从总线读取，不同型号同时读取 //
+		struct ScanStatistics
+		{
+			aris::Size kept_count;    // 保持不变的从站 //
+			aris::Size rebuilt_count; // 重新建立的从站，pdo配置都从缓存中复制 //
+			aris::Size fetched_count; // 从总线读取pdo配置的型号 //
+		};
+		auto scan()->ScanStatistics;
+		// pdo配置缓存的文件，scan() 时读取并写回，为空时只在内存中缓存 //
+		auto scanCachePath()const->const std::string&;
+		auto setScanCachePath(const std::string &path)->void;
+
+		// 分布时钟同步的统计，offset 为参考时钟（第一个DC从站）减去主站时间 //
+		struct DcSyncStatistics
+		{
+			std::int64_t count;             // 读到参考时钟的周期数 //
+			std::int64_t offset_ns;         // 最近一个周期的 offset //
+			std::int64_t max_abs_offset_ns;
+			double mean_abs_offset_ns;
+			std::int64_t max_abs_jitter_ns; // 相邻两个周期 offset 之差 //
+			std::int64_t correction_ns;     // 最近一个周期对主站时间基准的调整 //
+			std::int64_t time_base_ns;      // 主站时间减去实时时钟的计划周期起点 //
+		};
+		// 主站时间为实时时钟上计划的周期起点加时间基准，唤醒时刻在主站时间上等间隔 //
+		// 开启修正后，主站时间跟随参考时钟：参考时钟只在第一个周期对齐到主站时间，此后按 offset 以 PI 控制调整时间基准， //
+		// 时间基准增加多少，实时时钟上的下一次唤醒就提前多少；每周期的调整不超过十分之一个周期，饱和时停止积分 //
+		// 关闭修正时参考时钟每周期被改写为主站时间，offset 为参考时钟在一个周期内相对主站的漂移 //
+		auto isDcCorrection()const->bool;
+		auto setDcCorrection(bool is_dc_correction)->void;
+		auto dcCorrectionKp()const->double;
+		auto dcCorrectionKi()const->double;
+		auto setDcCorrectionGain(double kp, double ki)->void;
+		// 可在非实时线程中随时调用，统计在 start() 时清零 //
+		auto dcSyncStatistics()const->DcSyncStatistics;
+
+		// 异步SDO的工作线程数，线程在第一次提交请求时启动，主站析构时停止 //
+		// 析构时队列中尚未执行的请求以 ABORTED 结束，其回调在析构的线程中调用 //
+		auto sdoWorkerNum()const->aris::Size;
+		auto setSdoWorkerNum(aris::Size num)->void;
+		// 阻塞直到所有已提交的SDO请求结束，用于批量下载参数 //
+		auto waitSdo()->void;
+
+		// 没有 etherlab 时，过程数据在内存中，含 0x6040 与 0x6041 的从站被仿真为 CiA402 驱动器 //
+		// 仿真驱动器每周期实际位置向指令位置靠近的比例，以及回零所需的周期数 //
+		auto simulationFollowingRatio()const->double;
+		auto setSimulationFollowingRatio(double ratio)->void;
+		auto simulationHomeCount()const->aris::Size;
+		auto setSimulationHomeCount(aris::Size count)->void;
+		// 仿真的参考时钟相对主站的漂移，单位为百万分之一 //
+		auto simulationClockDriftPpm()const->double;
+		auto setSimulationClockDriftPpm(double ppm)->void;
+		// 仿真的总线，scan() 从中读取从站及其pdo配置 //
+		auto simulationBus()->aris::core::ObjectPool<Slave>&;
+		// 仿真从站每次SDO读写，以及扫描时每读一个pdo所需的时间 //
+		auto simulationSdoLatency()const->std::chrono::microseconds;
+		auto setSimulationSdoLatency(std::chrono::microseconds latency)->void;
 
 		virtual ~EthercatMaster();
 		EthercatMaster(const std::string &name = "ethercat_master");
@@ -122,10 +263,13 @@ namespace aris::control
 		auto virtual release()->void override;
 
 	private:
+		auto submitSdo(std::shared_ptr<SdoRequest> request)->void;
+
 		class Imp;
 		aris::core::ImpPtr<Imp> imp_;
 
 		friend class PdoEntry;
+		friend class EthercatSlave;
 	};
 
 	class EthercatMotion :public EthercatSlave, public Motion
@@ -182,6 +326,8 @@ namespace aris::control
 		ARIS_REGISTER_TYPE(EthercatMotion);
 		ARIS_DELETE_BIG_FOUR(EthercatMotion);
 
+	protected:
+		auto virtual init()->void override;
 
 	private:
 		class Imp;
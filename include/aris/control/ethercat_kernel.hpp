@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <any>
+#include <string>
+#include <vector>
 
 namespace aris::control
 {
@@ -36,24 +38,45 @@ namespace aris::control
 	// 3. pdo entry 每个pdo entry 对应一个 index 和 subindex
 
 	class EthercatMaster;
+	class EthercatSlave;
 	class PdoEntry;
 
-	auto aris_ecrt_scan(EthercatMaster *master)->int;
+	// 总线上的一个从站，position 为其在总线上的位置 //
+	struct ScannedSlave
+	{
+		std::uint16_t position;
+		std::string name;
+		std::uint32_t vendor_id, product_code, revision_num;
+	};
+	// 只读取从站的身份信息，不读取pdo //
+	auto aris_ecrt_scan_slaves(EthercatMaster *master, std::vector<ScannedSlave> *slaves)->int;
+	// 读取一个从站的 sync manager、pdo 与 entry，加入 slave 的 smPool，可在多个线程中对不同从站同时调用 //
+	auto aris_ecrt_scan_pdo(EthercatMaster *master, std::uint16_t position, EthercatSlave *slave)->int;
 
 	auto aris_ecrt_master_request(EthercatMaster *master)->void;
 	auto aris_ecrt_master_stop(EthercatMaster *master)->void;
-	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns)->void;
+	// sync_reference_clock 为 false 时不再用主站时间改写参考时钟，主站时间需自行跟随参考时钟 //
+	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns, bool sync_reference_clock = true)->void;
+	// 读取参考时钟（第一个DC从站）在上一周期的时间，低32位，成功时返回0 //
+	auto aris_ecrt_master_reference_clock_time(EthercatMaster *master, std::uint32_t *time)->int;
 	auto aris_ecrt_master_recv(EthercatMaster *master)->void;
 	auto aris_ecrt_master_send(EthercatMaster *master)->void;
 
+	// 须在 aris_ecrt_master_request 之后调用，返回 entry 首字节在过程数据中的地址及位偏移 //
+	auto aris_ecrt_pdo_locate(EthercatMaster *master, PdoEntry *entry, std::uint8_t **data, std::uint8_t *bit_position)->void;
 	auto aris_ecrt_pdo_read(PdoEntry *entry, void *data, int bit_size)->void;
 	auto aris_ecrt_pdo_write(PdoEntry *entry, const void *data, int bit_size)->void;
-	auto aris_ecrt_sdo_read(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+	// 阻塞直到从站应答，可在多个非实时线程中同时调用，成功时返回0 //
+	auto aris_ecrt_sdo_read(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
 		std::uint8_t *to_buffer, std::size_t byte_size, std::size_t *result_size, std::uint32_t *abort_code)->int;
-	auto aris_ecrt_sdo_write(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+	auto aris_ecrt_sdo_write(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
 		std::uint8_t *to_buffer, std::size_t byte_size, std::uint32_t *abort_code) ->int;
 	auto aris_ecrt_sdo_config(std::any& master, std::any& slave, std::uint16_t index, std::uint8_t subindex,
 		std::uint8_t *buffer, std::size_t byte_size)->void;
+
+	// 按位读写过程数据，用于非字节对齐的pdo entry //
+	void read_bit2(char *data, int bit_size, const char *pd, int offset, int bit_position);
+	void write_bit2(const char *data, int bit_size, char *pd, int offset, int bit_position);
 }
 
 #endif
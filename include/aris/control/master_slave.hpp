@@ -2,6 +2,8 @@
 #define ARIS_CONTROL_MASTER_SLAVE_H_
 
 #include <any>
+#include <cstring>
+#include <type_traits>
 
 #include <aris/core/object.hpp>
 #include <aris/core/basic_type.hpp>
@@ -41,19 +43,63 @@ namespace aris::control
 			std::int64_t total_count;
 			std::int64_t overrun_count;
 		};
+		// 实时循环的各个阶段，WAIT_JITTER 为实际唤醒时间与期望唤醒时间之差 //
+		enum RtPhase
+		{
+			RT_RECV,
+			RT_STRATEGY,
+			RT_SYNC,
+			RT_SEND,
+			RT_FLUSH_LOG,
+			RT_WAIT_JITTER,
+			RT_TOTAL,
+			RT_PHASE_SIZE
+		};
+		// 对数-线性分桶的直方图，每个2的幂区间分16个桶，相对误差小于1/16，最大记录约2s //
+		struct RtPhaseHistogram
+		{
+			enum { SUB_BUCKET_BITS = 4, BUCKET_SIZE = 448 };
+			std::int64_t count[BUCKET_SIZE];
+			std::int64_t total_count;
+			std::int64_t max_time;
+
+			static auto bucketIndex(std::int64_t ns)->aris::Size;
+			static auto bucketLowerBound(aris::Size bucket)->std::int64_t;
+			// 返回percentile所在桶的上界，单位ns，percentile取值0~1 //
+			auto percentile(double percentile)const->std::int64_t;
+		};
 		enum { MAX_MSG_SIZE = 8192 };
 		static auto Type()->const std::string & { static const std::string type("Master"); return std::ref(type); }
 		auto virtual type() const->const std::string& override { return Type(); }
+		auto virtual saveXml(aris::core::XmlElement &xml_ele) const->void override;
 		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
 		// used only in non-rt thread //
 		auto start()->void;
 		auto stop()->void;
 		auto setControlStrategy(std::function<void()> strategy)->void;
+		auto samplePeriodNs()const->std::int64_t;
+		auto setSamplePeriodNs(std::int64_t period_ns)->void;
+		// 每 divisor 个周期执行一次，在 count % divisor == phase 的周期执行，在 control strategy 之后调用 //
+		auto addSubRateTask(std::function<void()> task, aris::Size divisor, aris::Size phase = 0)->void;
+		auto clearSubRateTasks()->void;
+		// 虚拟时间：实时线程不再按周期休眠，只在 step() 时尽快运行，用于离线回放与测试，只能在普通linux下使用 //
+		auto isVirtualTime()const->bool;
+		auto setVirtualTime(bool is_virtual_time)->void;
+		// 虚拟时间下运行 count 个周期，阻塞直到这些周期运行完毕，返回已运行的周期数 //
+		auto step(aris::Size count = 1)->aris::Size;
+		auto cycleCount()const->aris::Size;
 
 		// used in rt thread //
 		auto logFile(const char *file_name)->void;
 		auto lout()->aris::core::MsgStream &;
 		auto mout()->aris::core::MsgStream &;
+		// 二进制记录，实时线程只把参数的原始字节直接写入pipe，由非实时线程格式化后写入log文件或控制台 //
+		// format 中的每个 "{}" 依次替换为一个参数，format 必须是字符串字面量等静态存储的字符串 //
+		// 记录立即发送，因此不会与同一周期内 lout() 或 mout() 中的文本保持顺序，pipe满时记录被丢弃 //
+		template<typename ...Args>
+		auto loutRecord(const char *format, const Args&... args)->void { sendRecord(true, format, args...); }
+		template<typename ...Args>
+		auto moutRecord(const char *format, const Args&... args)->void { sendRecord(false, format, args...); }
 		auto slaveAtAbs(aris::Size id)->Slave& { return slavePool().at(id); }
 		auto slaveAtAbs(aris::Size id)const->const Slave& { return const_cast<std::decay_t<decltype(*this)> *>(this)->slaveAtAbs(id); }
 		auto slaveAtPhy(aris::Size id)->Slave&;
@@ -62,7 +108,11 @@ namespace aris::control
 		auto slavePool()const->const aris::core::ObjectPool<Slave>& { return const_cast<std::decay_t<decltype(*this)> *>(this)->slavePool(); }
 		auto rtHandle()->std::any&;
 		auto rtHandle()const->const std::any& { return const_cast<std::decay_t<decltype(*this)> *>(this)->rtHandle(); }
-		auto resetRtStasticData(RtStasticsData *stastics, bool is_new_data_include_this_count = false)->void;
+		// 可同时记录 MAX_STASTICS_SLOT 组统计数据，slot 用于区分同时执行的多个指令 //
+		enum { MAX_STASTICS_SLOT = 16 };
+		auto resetRtStasticData(RtStasticsData *stastics, bool is_new_data_include_this_count = false, aris::Size slot = 0)->void;
+		// 可在非实时线程中随时调用，直方图在start()时清零 //
+		auto rtPhaseHistogram(RtPhase phase, RtPhaseHistogram *histogram)const->void;
 
 		virtual ~Master();
 		explicit Master(const std::string &name = "master");
@@ -79,6 +129,39 @@ namespace aris::control
 		auto virtual release()->void {}
 
 	private:
+		using RecordFormatter = void(*)(std::ostream &os, const char *format, const char *data);
+		template<typename ...Args>
+		static auto formatRecord(std::ostream &os, const char *format, [[maybe_unused]] const char *data)->void
+		{
+			(formatRecordArg<Args>(os, format, data), ...);
+			os << format;
+		}
+		template<typename Arg>
+		static auto formatRecordArg(std::ostream &os, const char *&format, const char *&data)->void
+		{
+			Arg arg;
+			std::memcpy(&arg, data, sizeof(Arg));
+			data += sizeof(Arg);
+
+			auto placeholder = std::strstr(format, "{}");
+			if (!placeholder)return;
+			os.write(format, placeholder - format);
+			os << arg;
+			format = placeholder + 2;
+		}
+		template<typename ...Args>
+		auto sendRecord(bool is_lout, const char *format, const Args&... args)->void
+		{
+			static_assert(((std::is_trivially_copyable_v<Args> && !std::is_pointer_v<Args>) && ...), "record args must be trivially copyable values");
+			if (auto data = reserveRecord(is_lout, &formatRecord<Args...>, format, (sizeof(Args) + ... + 0)))
+			{
+				((std::memcpy(data, &args, sizeof(Args)), data += sizeof(Args)), ...);
+				commitRecord(is_lout);
+			}
+		}
+		auto reserveRecord(bool is_lout, RecordFormatter formatter, const char *format, aris::Size size)->char*;
+		auto commitRecord(bool is_lout)->void;
+
 		struct Imp;
 		aris::core::ImpPtr<Imp> imp_;
 
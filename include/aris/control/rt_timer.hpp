@@ -13,6 +13,12 @@ namespace aris::control
 	auto aris_rt_task_join(std::any& handle)->int;
 	auto aris_rt_task_set_periodic(int nanoseconds)->int;
 	auto aris_rt_task_wait_period()->int;
+	// 以当前时刻作为本周期的起点，虚拟时间下不等待周期时使用 //
+	auto aris_rt_task_restart_period()->int;
+	// 本周期计划的起点，不含唤醒的抖动，单位与 aris_rt_timer_read() 相同 //
+	auto aris_rt_task_period_time()->std::int64_t;
+	// 把下一次唤醒推迟 ns（可为负），此后的周期都以新的时刻为基准，用于把周期对齐到外部时钟 //
+	auto aris_rt_task_correct_period(std::int64_t ns)->void;
 	auto aris_rt_timer_read()->std::int64_t;
 
 	// in nano seconds
@@ -191,6 +191,8 @@ namespace aris::core
 		auto defaultParam()const->const std::string &;
 		auto findParam(const std::string &param_name)const->const Param* { return const_cast<std::decay_t<decltype(*this)> *>(this)->findParam(param_name); }
 		auto findParam(const std::string &param_name)->Param*;
+		// 命令定义的摘要，参数的增删替换、名字、简写或默认值改变后随之改变，用于判断缓存的解析表是否过期 //
+		auto signature()const->std::size_t;
 
 		virtual ~Command();
 		explicit Command(const std::string &name = "command", const std::string &default_param = "");
@@ -208,6 +210,9 @@ namespace aris::core
 	{
 	public:
 		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
+		// 建立命令名索引与各命令的参数表，commandPool 或命令的定义改变后会在 parse 时自动重建 //
+		auto init()->void;
+		// 命令定义不变时，parse 不修改任何状态，可以在多个线程中同时调用 //
 		auto parse(const std::string &command_string, std::string &cmd_out, std::map<std::string, std::string> &param_map_out)->void;
 		auto commandPool()->ObjectPool<Command> &;
 		auto commandPool()const->const ObjectPool<Command> &;
@@ -0,0 +1,28 @@
+﻿#ifndef ARIS_CORE_COMPLETION_H
+#define ARIS_CORE_COMPLETION_H
+
+#include <atomic>
+
+#include <aris/core/notifier.hpp>
+
+namespace aris::core
+{
+	// 一次性的完成标志，用于代替 std::promise/std::future，构造时不分配内存 //
+	// 所有 Completion 共用一个 Notifier，finish() 可以在实时线程中调用 //
+	class Completion
+	{
+	public:
+		auto finish()->void;
+		auto isFinished()const->bool { return is_finished_.load(); }
+		auto wait()const->void;
+
+		Completion() = default;
+		Completion(const Completion &other) :is_finished_(other.is_finished_.load()) {}
+		Completion& operator=(const Completion &other) { is_finished_.store(other.is_finished_.load()); return *this; }
+
+	private:
+		std::atomic_bool is_finished_{ false };
+	};
+}
+
+#endif
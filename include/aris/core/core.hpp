@@ -8,6 +8,8 @@
 #include <aris/core/expression_calculator.hpp>
 #include <aris/core/socket.hpp>
 #include <aris/core/pipe.hpp>
+#include <aris/core/notifier.hpp>
+#include <aris/core/completion.hpp>
 #include <aris/core/command.hpp>
 
 #endif // ARIS_H_
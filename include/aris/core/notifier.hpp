@@ -0,0 +1,31 @@
+﻿#ifndef ARIS_CORE_NOTIFIER_H
+#define ARIS_CORE_NOTIFIER_H
+
+#include <functional>
+
+#include <aris/core/object.hpp>
+
+namespace aris::core
+{
+	// 实时线程通知非实时线程用，代替 sleep 轮询 //
+	// notify() 只有一次原子加法，仅当有线程在等待时才会唤醒（Linux 下为 futex），可以在实时线程中调用 //
+	// Xenomai 下实时线程不能调用 linux 系统调用，此时 notify() 不唤醒，wait() 退化为 1ms 超时的等待 //
+	class Notifier
+	{
+	public:
+		auto notify()->void;
+		// 阻塞直到 pred() 为真，pred 在等待线程中调用 //
+		auto wait(const std::function<bool()> &pred)->void;
+
+		~Notifier();
+		Notifier();
+		Notifier(const Notifier&) = delete;
+		Notifier& operator=(const Notifier&) = delete;
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
+}
+
+#endif
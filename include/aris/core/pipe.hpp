@@ -12,6 +12,15 @@ namespace aris::core
 		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
 		auto sendMsg(const aris::core::MsgBase &)->bool;
 		auto recvMsg(aris::core::MsgBase &)->bool;
+		
+		// 生产者：预留一段连续空间，header 中 msg_size_ 已设为 size，数据紧跟在 header 之后 //
+		// 写完后调用 commitMsg()，提交前可以把 msg_size_ 改小。空间不足时返回 nullptr //
+		// 预留与提交之间不能调用 sendMsg //
+		// 管道为空但尾部与头部都放不下时，返回 nullptr 并提交一个跳转，消费者下一次读取后即可写入 //
+		auto reserveMsg(aris::core::MsgSize size)->aris::core::MsgHeader*;
+		auto commitMsg()->void;
+		// 消费者：原地依次处理所有已提交的消息，全部处理完后一次性释放空间，返回消息个数 //
+		auto drainMsg(const std::function<void(const aris::core::MsgHeader &header, const char *data)> &func)->std::size_t;
 
 		virtual ~Pipe();
 		Pipe(const std::string &name = "pipe", std::size_t pool_size = 16384);
@@ -8,6 +8,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 #include <aris/core/basic_type.hpp>
 
@@ -57,6 +58,11 @@ namespace aris::dynamic
 	auto inline constexpr next_d(Size at, Stride stride)noexcept->Size { return at + stride.c_ld + stride.r_ld; }
 	auto inline constexpr last_d(Size at, Stride stride)noexcept->Size { return at - stride.c_ld - stride.r_ld; }
 
+	auto inline constexpr to_stride(Size ld)noexcept->Stride { return Stride(ld, 1); }
+	auto inline constexpr to_stride(RowMajor row_major)noexcept->Stride { return Stride(row_major.r_ld, 1); }
+	auto inline constexpr to_stride(ColMajor col_major)noexcept->Stride { return Stride(1, col_major.c_ld); }
+	auto inline constexpr to_stride(Stride stride)noexcept->Stride { return stride; }
+
 	template <typename T, typename TType>
 	auto inline dsp(Size m, Size n, const T *data, TType d_t)noexcept->void
 	{
@@ -300,9 +306,87 @@ namespace aris::dynamic
 				B[bij] -= A[aij];
 	}
 	auto inline s_ms(Size m, Size n, const double* A, double* B) noexcept->void { s_vs(m*n, A, B); }
+
+	// 大矩阵的乘法：C += alpha * A * B //
+	// 按缓存分块，4x8 的寄存器分块，只在当前线程中计算且不分配内存 //
+	// 维数足够大时由 s_mm、s_mma 等自动调用，小矩阵仍然使用下面的循环 //
+	auto s_mma_blocked(Size m, Size n, Size k, double alpha, const double* A, Stride a_t, const double* B, Stride b_t, double *C, Stride c_t)noexcept->void;
+	// 多线程的版本，打包后分块计算，不同的行块由 thread_num 个线程同时计算 //
+	// 会分配内存并创建线程，不会被自动调用，只在非实时线程中显式使用，例如标定 //
+	auto s_mma_parallel(Size m, Size n, Size k, double alpha, const double* A, Stride a_t, const double* B, Stride b_t, double *C, Stride c_t, Size thread_num)->void;
+	auto inline s_is_blocked_mm(Size m, Size n, Size k)noexcept->bool { return m >= 32 && n >= 32 && k >= 32 && m * n * k >= 262144; }
+
+	// 编译期确定维数的矩阵乘法，编译器可以完全展开循环，用于 6x6、6x1 等小矩阵 //
+	// 累加的顺序与运行期的版本相同，因此结果完全一致 //
+	template<Size M, Size N, Size K, typename AType, typename BType, typename CType>
+	auto inline s_mma(const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
+	{
+		for (Size i = 0; i < M; ++i)
+		{
+			for (Size j = 0; j < N; ++j)
+			{
+				double value{ C[at(i, j, c_t)] };
+				for (Size u = 0; u < K; ++u)value += A[at(i, u, a_t)] * B[at(u, j, b_t)];
+				C[at(i, j, c_t)] = value;
+			}
+		}
+	}
+	template<Size M, Size N, Size K>
+	auto inline s_mma(const double* A, const double* B, double *C)noexcept->void { s_mma<M, N, K>(A, K, B, N, C, N); }
+	template<Size M, Size N, Size K, typename AType, typename BType, typename CType>
+	auto inline s_mms(const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
+	{
+		for (Size i = 0; i < M; ++i)
+		{
+			for (Size j = 0; j < N; ++j)
+			{
+				double value{ C[at(i, j, c_t)] };
+				for (Size u = 0; u < K; ++u)value -= A[at(i, u, a_t)] * B[at(u, j, b_t)];
+				C[at(i, j, c_t)] = value;
+			}
+		}
+	}
+	template<Size M, Size N, Size K>
+	auto inline s_mms(const double* A, const double* B, double *C)noexcept->void { s_mms<M, N, K>(A, K, B, N, C, N); }
+	template<Size M, Size N, Size K, typename AType, typename BType, typename CType>
+	auto inline s_mm(const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
+	{
+		for (Size i = 0; i < M; ++i)
+		{
+			for (Size j = 0; j < N; ++j)
+			{
+				double value{ 0.0 };
+				for (Size u = 0; u < K; ++u)value += A[at(i, u, a_t)] * B[at(u, j, b_t)];
+				C[at(i, j, c_t)] = value;
+			}
+		}
+	}
+	template<Size M, Size N, Size K>
+	auto inline s_mm(const double* A, const double* B, double *C)noexcept->void { s_mm<M, N, K>(A, K, B, N, C, N); }
+	template<Size M, Size N, Size K, typename AType, typename BType, typename CType>
+	auto inline s_mmi(const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
+	{
+		for (Size i = 0; i < M; ++i)
+		{
+			for (Size j = 0; j < N; ++j)
+			{
+				double value{ 0.0 };
+				for (Size u = 0; u < K; ++u)value -= A[at(i, u, a_t)] * B[at(u, j, b_t)];
+				C[at(i, j, c_t)] = value;
+			}
+		}
+	}
+	template<Size M, Size N, Size K>
+	auto inline s_mmi(const double* A, const double* B, double *C)noexcept->void { s_mmi<M, N, K>(A, K, B, N, C, N); }
+
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mma(Size m, Size n, Size k, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) return s_mma_blocked(m, n, k, 1.0, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t));
+		// 动力学求解中最常见的维数，转到展开的版本 //
+		if (m == 6 && n == 6 && k == 6) return s_mma<6, 6, 6>(A, a_t, B, b_t, C, c_t);
+		if (m == 6 && n == 1 && k == 6) return s_mma<6, 1, 6>(A, a_t, B, b_t, C, c_t);
+
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -315,6 +399,7 @@ namespace aris::dynamic
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mma(Size m, Size n, Size k, double alpha, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) return s_mma_blocked(m, n, k, alpha, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t));
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -331,6 +416,7 @@ namespace aris::dynamic
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mms(Size m, Size n, Size k, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t)noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) return s_mma_blocked(m, n, k, -1.0, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t));
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -344,6 +430,11 @@ namespace aris::dynamic
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mm(Size m, Size n, Size k, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t) noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) { s_fill(m, n, 0.0, C, c_t); return s_mma_blocked(m, n, k, 1.0, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t)); }
+		// 动力学求解中最常见的维数，转到展开的版本 //
+		if (m == 6 && n == 6 && k == 6) return s_mm<6, 6, 6>(A, a_t, B, b_t, C, c_t);
+		if (m == 6 && n == 1 && k == 6) return s_mm<6, 1, 6>(A, a_t, B, b_t, C, c_t);
+
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -357,6 +448,7 @@ namespace aris::dynamic
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mm(Size m, Size n, Size k, double alpha, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t) noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) { s_fill(m, n, 0.0, C, c_t); return s_mma_blocked(m, n, k, alpha, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t)); }
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -373,6 +465,7 @@ namespace aris::dynamic
 	template<typename AType, typename BType, typename CType>
 	auto inline s_mmi(Size m, Size n, Size k, const double* A, AType a_t, const double* B, BType b_t, double *C, CType c_t) noexcept->void
 	{
+		if (s_is_blocked_mm(m, n, k)) { s_fill(m, n, 0.0, C, c_t); return s_mma_blocked(m, n, k, -1.0, A, to_stride(a_t), B, to_stride(b_t), C, to_stride(c_t)); }
 		for (Size i(-1), ai0{ 0 }, ci0{ 0 }; ++i < m; ai0 = next_r(ai0, a_t), ci0 = next_r(ci0, c_t))
 		{
 			for (Size j(-1), b0j{ 0 }, cij{ ci0 }; ++j < n; b0j = next_c(b0j, b_t), cij = next_c(cij, c_t))
@@ -714,6 +807,13 @@ namespace aris::dynamic
 	//    p : max(m,n) x 1
 	//
 	//    U can be the same address with A
+	//
+	// 大矩阵的版本，U 按行存储，在 U 上原地分解，要求 m > n
+	// 逐行扫描来更新剩余的矩阵，中间量存放在 tau 尚未用到的位置，不分配内存，结果与逐列计算的版本相同
+	auto s_householder_utp_blocked(Size m, Size n, double *U, Size u_ld, double *tau, Size tau_ld, Size *p, Size &rank, double zero_check)noexcept->void;
+	// 多线程的版本，列的模只在相消过多时重新计算，不同的行块由 thread_num 个线程同时计算
+	// 会分配内存并创建线程，不会被自动调用，只在非实时线程中显式使用，例如标定
+	auto s_householder_utp_parallel(Size m, Size n, double *U, Size u_ld, double *tau, Size tau_ld, Size *p, Size &rank, double zero_check, Size thread_num)->void;
 	template<typename AType, typename UType, typename TauType>
 	auto inline s_householder_utp(Size m, Size n, const double *A, AType a_t, double *U, UType u_t, double *tau, TauType tau_t, Size *p, Size &rank, double zero_check = 1e-10)noexcept->void
 	{
@@ -722,6 +822,10 @@ namespace aris::dynamic
 		// init u //
 		s_mc(m, n, A, a_t, U, u_t);
 
+		// 按行存储的大矩阵，例如标定时的辨识矩阵 //
+		if constexpr (std::is_integral_v<UType> && std::is_integral_v<TauType>)
+			if (m >= 256 && n >= 16 && m > n) return s_householder_utp_blocked(m, n, U, u_t, tau, tau_t, p, rank, zero_check);
+
 		// init p //
 		std::iota(p, p + n, 0);
 
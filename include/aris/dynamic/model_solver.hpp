@@ -51,6 +51,19 @@ namespace aris::dynamic
 		auto nM()const noexcept->Size;// = motion_number + general_motion_number x 6
 		auto M()const noexcept->const double *;// dimension : nM x nM 
 		auto h()const noexcept->const double *;// dimension : nM x 1
+		// 热启动：kinPos沿用上次的分解结果，并根据上两次的解外推初值，适用于实时循环中连续变化的位置 //
+		auto warmStart()const->bool;
+		auto setWarmStart(bool warm_start)->void;
+		// 线程数：各子系统相互独立，kinPos、kinVel、dynAccAndFce 中分给多个常驻线程同时求解，在 allocateMemory 后生效 //
+		// 使用 xenomai 时工作线程无法作为实时任务及时唤醒，此设置被忽略，总是在调用者的线程中求解 //
+		auto threadNum()const->Size;
+		auto setThreadNum(Size thread_num)->void;
+		// 工作线程绑定的核，第 i 个为第 i 个工作线程（不含调用者）绑定的核，不足时不绑定，在 allocateMemory 后生效 //
+		auto threadCpus()const->const std::vector<int>&;
+		auto setThreadCpus(const std::vector<int> &cpus)->void;
+		// 优先级大于0时工作线程使用 SCHED_FIFO，否则继承调用 allocateMemory 的线程的调度策略和优先级 //
+		auto threadPriority()const->int;
+		auto setThreadPriority(int priority)->void;
 		auto plotRelation()->void;
 
 		virtual ~UniversalSolver();
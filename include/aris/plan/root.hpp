@@ -47,7 +47,12 @@ namespace aris::plan
 		aris::control::Master::RtStasticsData rt_stastic; //                /collect  get
 		std::any ret;
 		std::int32_t ret_code;
-		std::future<void> finished;
+		aris::core::Completion finished;                  // 收集完成后置位，可用 finished.wait() 等待 //
+		aris::Size motion_group;                          // prepair/execute/collect  get&set when prepair, get when execute and collect, 指令所在的运动组 //
+		// 轨迹混合：本指令结束前 blend_count 个周期内，若下一条指令也允许混合，则两者叠加执行 //
+		// 允许混合的指令需在 executeRT 中返回剩余周期数，并在第一个周期前写好 blend_end_pos //
+		std::int32_t blend_count;                         // prepair/execute/collect  set when prepair, 0 表示不混合 //
+		std::vector<double> blend_end_pos;                // prepair/execute/collect  按电机序号存放终点，NaN 表示该电机不运动 //
 	};
 	class Plan :public aris::core::Object
 	{
@@ -115,7 +120,13 @@ namespace aris::plan
 	public:
 		auto planPool()->aris::core::ObjectPool<Plan> &;
 		auto planPool()const->const aris::core::ObjectPool<Plan> & { return const_cast<std::decay_t<decltype(*this)> *>(this)->planPool(); }
-		auto planParser()->aris::core::CommandParser;
+		// 命令解析器与命令名索引只建立一次，planPool 增删 plan 或修改 plan 的命令后在使用时自动重建 //
+		auto init()->void;
+		// 返回的解析器与索引共享所有权，重建索引后仍然有效，但不再反映之后的修改 //
+		auto planParser()->std::shared_ptr<aris::core::CommandParser>;
+		auto findPlan(const std::string &cmd_name)->Plan*;
+		// 解析命令字符串并返回对应的 plan，可以在多个线程中同时调用 //
+		auto parse(const std::string &cmd_string, std::map<std::string, std::string> &param_map_out)->Plan*;
 
 		virtual ~PlanRoot();
 		explicit PlanRoot(const std::string &name = "plan_root");
@@ -362,6 +373,9 @@ namespace aris::plan
 	/// + 指定单个电机的加速度，例如指定 0 号电机走到 1.5 处，速度为 0.5 ，加速度为 0.3 ，减速度为 0.2 ：“mvaj -m=0 --pos=1.5 --vel=0.5 --acc=0.3 --dec=0.2”
 	/// + 指定所有电机的加速度，例如：“mvaj -a --dec={1.5,1.2,1.5,1.3,1.2,0.6}”
 	///
+	/// 指定混合周期数，默认为0，即停止后再执行下一条指令
+	/// + 最后 100 个周期与下一条同样允许混合的指令叠加：“mvaj -a --pos=1.5 --blend_count=100”
+	///
 	class MoveAbsJ :public Plan
 	{
 	public:
@@ -406,6 +420,8 @@ namespace aris::plan
 	/// + 指定所有电机的加速度都为0.3：“mvj --pe={0,0.5,1.1,0,0,0} --joint_vel=0.5 --joint_dec=0.3”
 	/// + 指定所有电机的加速度：“mvj --pe={0,0.5,1.1,0,0,0} --joint_vel=0.5 --joint_dec={0.2,0.2,0.2,0.3,0.3,0.3}”
 	///
+	/// 指定混合周期数，默认为0，含义与 mvaj 相同：“mvj --pe={0,0.5,1.1,0,0,0} --blend_count=100”
+	///
 	class MoveJ : public Plan
 	{
 	public:
@@ -446,6 +462,9 @@ namespace aris::plan
 	///
 	/// 指定目标减速度以及角减速度，单位一般是 m/s^2 或 rad/s^2 ，应永远为正数，默认为0.1
 	/// + 指定末端的减速度和角减速度，例如指定末端减速度为 0.5，角减速度为 0.3：“mvl --pe={0.1,1.2,0,0,0,0} --dec=0.5 --angular_dec=0.3”
+	///
+	/// 指定混合周期数，默认为0，含义与 mvaj 相同：“mvl --pe={0.1,1.2,0,0,0,0} --blend_count=100”
+	/// + 混合段内两条指令在关节空间叠加，末端不再严格走直线，但位置与速度连续
 	class MoveL : public Plan
 	{
 	public:
@@ -553,6 +572,71 @@ namespace aris::plan
 		struct Imp;
 		aris::core::ImpPtr<Imp> imp_;
 	};
+	/// \brief 让机器人跟随外部规划器实时刷入的设定点运动。
+	/// 
+	/// 典型流程为：
+	/// 1. 开启流模式
+	/// 2. 不断刷入设定点，可以通过指令（例如 socket ）刷入，也可以在本地调用 StreamMove::pushSetpoint() 刷入
+	/// 3. 终止流模式，已刷入的设定点执行完后指令结束
+	/// 
+	/// 设定点存放在一个环形队列中，实时线程每 interval 个周期取出一个，两个设定点之间线性插值。
+	/// 
+	/// ### 参数定义 ###
+	///
+	/// #### 开启流模式 ####
+	/// 
+	/// 此时至少要包含“start”参数，例如：“stm --start”
+	///
+	/// 指定设定点的空间，默认为关节空间，每个设定点包含所有电机的位置：
+	/// + 关节空间：“stm --start --space=joint”
+	/// + 笛卡尔空间，每个设定点为末端的位置与欧拉角：“stm --start --space=pe --eul_type=321”
+	/// + 笛卡尔空间中设定点之间位置线性插值，姿态按四元数球面插值，欧拉角越过 ±π 时不会绕一整圈
+	///
+	/// 指定每个设定点所占的周期数，默认为 1 ，即 1 kHz 的设定点：
+	/// + 外部规划器以 250 Hz 刷入：“stm --start --interval=4”
+	///
+	/// 指定队列中最多积压的设定点个数，超过时丢弃最旧的设定点，以限制延迟，默认为 100 ：
+	/// + “stm --start --max_latency=20”
+	///
+	/// 队列为空时保持在最后一个设定点，指定最多等待的周期数，超过后指令结束，默认为 1000 ， 0 表示一直等待：
+	/// + “stm --start --underrun_limit=500”
+	///
+	/// #### 终止流模式 ####
+	/// 
+	/// 指令：“stm --stop”
+	///
+	/// #### 在流模式中刷入设定点 ####
+	///
+	/// 一次可以刷入多个设定点，依次排列：
+	/// + 6 个电机时刷入两个设定点：“stm --data={0,0,0,0,0,0,0.001,0,0,0,0,0}”
+	///
+	class StreamMove :public Plan
+	{
+	public:
+		enum { MAX_DIM = 16, RING_SIZE = 4096 };
+
+		auto virtual prepairNrt(const std::map<std::string, std::string> &params, PlanTarget &target)->void override;
+		auto virtual executeRT(PlanTarget &target)->int override;
+		auto virtual collectNrt(PlanTarget &target)->void override;
+
+		// 本地刷入设定点，每个设定点的长度为开启时的维数，可以在多个非实时线程中调用 //
+		// 返回实际刷入的设定点个数，流模式未开启或队列已满时少于 count //
+		static auto pushSetpoint(const double *setpoint, aris::Size count = 1)->aris::Size;
+		// 队列中尚未执行的设定点个数 //
+		static auto pendingSetpoint()->aris::Size;
+		// 本次流模式中队列为空的周期数，以及为限制延迟而丢弃的设定点个数 //
+		static auto underrunCount()->aris::Size;
+		static auto droppedCount()->aris::Size;
+
+		virtual ~StreamMove();
+		explicit StreamMove(const std::string &name = "stream_move");
+		ARIS_REGISTER_TYPE(StreamMove);
+		ARIS_DECLARE_BIG_FOUR(StreamMove);
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
 
 
 	class GetPartPq :public Plan
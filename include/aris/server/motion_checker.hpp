@@ -0,0 +1,84 @@
+#ifndef ARIS_SERVER_MOTION_CHECKER_H_
+#define ARIS_SERVER_MOTION_CHECKER_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <aris/core/core.hpp>
+#include <aris/control/control.hpp>
+
+namespace aris::server
+{
+	// 电机指令的安全检查 //
+	// 各轴的限位在启动时按列存储，实时线程每周期把各轴状态读入快照，再对所有轴批量检查 //
+	// 检查结果为每个轴的违规位掩码，以及第一个违规的轴 //
+	class MotionChecker
+	{
+	public:
+		// 位的顺序即原先逐项检查的顺序，最低位为最先报告的错误 //
+		enum Violation : std::uint32_t
+		{
+			POS_MAX = 0x0001,
+			POS_MIN = 0x0002,
+			POS_CONTINUOUS = 0x0004,
+			POS_CONTINUOUS_SECOND_ORDER = 0x0008,
+			POS_FOLLOWING_ERROR = 0x0010,
+			VEL_MAX = 0x0020,
+			VEL_MIN = 0x0040,
+			VEL_CONTINUOUS = 0x0080,
+			VEL_FOLLOWING_ERROR = 0x0100,
+		};
+		struct Limits
+		{
+			double max_pos, min_pos, max_vel, min_vel, max_acc, min_acc;
+			double max_pos_following_error, max_vel_following_error;
+		};
+		struct State
+		{
+			std::uint16_t status_word;
+			std::uint8_t mode_of_operation, mode_of_display;
+			double target_pos, target_vel, target_cur, actual_pos, actual_vel;
+		};
+		// 根据 plan 的 option 及当前 count，得到需要检查的项 //
+		static auto enabledMask(std::uint64_t option, std::uint32_t count)->std::uint32_t;
+		static auto violationName(std::uint32_t violation)->const char*;
+
+		auto resize(aris::Size axis_num)->void;
+		auto axisNum()const->aris::Size;
+		auto limits(aris::Size i)const->Limits;
+		auto setLimits(aris::Size i, const Limits &limits)->void;
+		auto state(aris::Size i)const->State;
+		auto setState(aris::Size i, const State &state)->void;
+		auto lastPvc(aris::Size i)const->std::array<double, 3>;
+		auto lastLastPvc(aris::Size i)const->std::array<double, 3>;
+		// 改正电机指令后，把历史指令都设为当前值 //
+		auto resetHistory(aris::Size i, double p, double v, double c)->void;
+
+		// 绑定控制器中的所有电机，读取限位并清空历史，非实时 //
+		// 控制器启动前 motionPool 尚未建立，因此按 slavePool 的顺序查找电机 //
+		auto bind(aris::control::Controller &controller)->void;
+		// 只绑定其中的部分电机，motions 为电机序号 //
+		auto bind(aris::control::Controller &controller, const std::vector<aris::Size> &motions)->void;
+		// 读取所绑定电机的状态，实时 //
+		auto loadState()->void;
+
+		// 对所有轴检查，返回所有轴违规位的并集 //
+		auto check(std::uint64_t option, std::uint32_t count)->std::uint32_t;
+		auto violation(aris::Size i)const->std::uint32_t;
+		// 第一个违规的轴，没有违规时返回 axisNum() //
+		auto firstAxis()const->aris::Size;
+		// 检查通过后，把当前指令存为历史 //
+		auto commit()->void;
+
+		virtual ~MotionChecker();
+		MotionChecker();
+		ARIS_DECLARE_BIG_FOUR(MotionChecker);
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef ARIS_SERVER_MOTION_GROUP_H_
+#define ARIS_SERVER_MOTION_GROUP_H_
+
+#include <string>
+#include <vector>
+
+#include <aris/core/core.hpp>
+
+namespace aris::server
+{
+	// 运动组，由若干电机组成，每个运动组有独立的指令队列 //
+	// 不同运动组的指令在同一个实时周期内同时执行，某个运动组出错只清空该组的队列 //
+	// 配置了运动组时，每个电机必须属于且仅属于一个运动组；未配置时所有电机构成一个运动组 //
+	// 所有运动组共用同一个模型，plan 只应修改本组电机对应的 motion，共用的 part 位姿由各组的 plan 自行协调 //
+	// rt log 文件也只有一个，其它运动组正在执行指令时，新指令的 log 写入当前文件，不再单独建立文件 //
+	class MotionGroup : public aris::core::Object
+	{
+	public:
+		// 运行时的统计数据 //
+		struct Stastics
+		{
+			std::int64_t executed_cmd_count; // 已执行完的实时指令数 //
+			std::int64_t failed_cmd_count;   // 出错的实时指令数 //
+			std::int64_t busy_count;         // 有指令在执行的周期数 //
+			std::int64_t current_execute_id; // 正在执行的指令id，没有时为0 //
+		};
+
+		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
+		auto virtual saveXml(aris::core::XmlElement &xml_ele) const->void override;
+
+		// 电机序号，即 controller 中 motionPool 的序号，同时对应 model 中 motionPool 的序号 //
+		auto motions()const->const std::vector<aris::Size>&;
+		auto setMotions(const std::vector<aris::Size> &motions)->void;
+
+		virtual ~MotionGroup();
+		explicit MotionGroup(const std::string &name = "motion_group", const std::vector<aris::Size> &motions = {});
+		ARIS_REGISTER_TYPE(MotionGroup);
+		ARIS_DECLARE_BIG_FOUR(MotionGroup);
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
+}
+
+#endif
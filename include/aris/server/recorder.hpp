@@ -0,0 +1,109 @@
+#ifndef ARIS_SERVER_RECORDER_H_
+#define ARIS_SERVER_RECORDER_H_
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <filesystem>
+
+#include <aris/core/core.hpp>
+#include <aris/control/control.hpp>
+#include <aris/dynamic/dynamic.hpp>
+
+namespace aris::server
+{
+	// 实时数据记录器 //
+	// 实时线程每周期为每个正在执行指令的运动组把所有通道写成一行定长数据，放入预分配的环形缓冲区，不分配内存、不加锁、不阻塞 //
+	// 缓冲区满时丢弃该行并计数。后台线程把数据按指令写成分块列存文件，每条指令一个文件 //
+	// 后台线程在积累一批数据后才被唤醒，flush() 可以强制写入 //
+	//
+	// 文件格式（本机字节序）：
+	//   FileHeader
+	//   char name[column_size][NAME_SIZE]
+	//   block[0], block[1], ...
+	// 每个block大小固定为 8 + 8 * block_rows * (1 + column_size) 字节：
+	//   std::int64_t row_count;                       // 该块中有效行数，只有最后一块可能不满 //
+	//   std::int64_t count[block_rows];               // 每行对应的 global count //
+	//   double       column[column_size][block_rows]; // 按列连续存放 //
+	// 因此可以直接 mmap，第 k 块第 j 列的偏移为 data_offset + k * block_bytes + 8 * (1 + block_rows * (j + 1)) //
+	class Recorder : public aris::core::Object
+	{
+	public:
+		enum ChannelType
+		{
+			TARGET_POS,
+			TARGET_VEL,
+			TARGET_CUR,
+			ACTUAL_POS,
+			ACTUAL_VEL,
+			ACTUAL_CUR,
+			MODEL_MP,
+			MODEL_MV,
+			MODEL_MF,
+			PART_PQ,    // 7列：x y z q1 q2 q3 q4 //
+		};
+		static const aris::Size ALL = std::numeric_limits<aris::Size>::max();
+		struct Channel
+		{
+			ChannelType type;
+			aris::Size index;  // 电机或杆件的序号，ALL 表示所有 //
+		};
+		struct FileHeader
+		{
+			char magic[8];              // "ARISREC" //
+			std::uint32_t version;
+			std::uint32_t column_size;
+			std::uint32_t block_rows;
+			std::uint32_t name_size;
+			std::int64_t command_id;
+			std::int64_t data_offset;   // 第一个block的偏移 //
+			std::int64_t block_bytes;
+		};
+		enum { NAME_SIZE = 32 };
+
+		auto virtual loadXml(const aris::core::XmlElement &xml_ele)->void override;
+		auto virtual saveXml(aris::core::XmlElement &xml_ele) const->void override;
+
+		// 以下只能在记录器未启动时调用 //
+		auto addChannel(ChannelType type, aris::Size index = ALL)->void;
+		auto clearChannels()->void;
+		auto channels()const->const std::vector<Channel>&;
+		auto capacity()const->aris::Size;
+		auto setCapacity(aris::Size rows)->void;
+		auto blockRows()const->aris::Size;
+		auto setBlockRows(aris::Size rows)->void;
+		auto fileDirectory()const->std::filesystem::path;
+		auto setFileDirectory(const std::filesystem::path &dir)->void;
+
+		// 展开后的列名，例如 "actual_pos.0"，启动后有效 //
+		auto columnNames()const->const std::vector<std::string>&;
+		// 丢弃的行数，已经写入文件的行数，以及因文件打开或写入失败而丢失的行数 //
+		auto droppedRows()const->std::int64_t;
+		auto writtenRows()const->std::int64_t;
+		auto failedRows()const->std::int64_t;
+		// 最近一次写入的文件，以及最近一次文件错误，没有错误时为空 //
+		auto lastFile()const->std::filesystem::path;
+		auto lastError()const->std::string;
+
+		// 由ControlServer调用 //
+		auto start(aris::control::Controller &controller, aris::dynamic::Model &model)->void;
+		auto stop()->void;
+		auto enabled()const->bool;
+		// 实时线程中调用，group 为运动组的序号，同一运动组连续的同一 command_id 的数据写入同一个文件 //
+		auto record(std::int64_t command_id, std::int64_t count, aris::Size group = 0)->void;
+		// 非实时线程中调用，等待当前环形缓冲区中的数据全部写入文件 //
+		auto flush()->void;
+
+		virtual ~Recorder();
+		explicit Recorder(const std::string &name = "recorder");
+		Recorder(const Recorder&) = delete;
+		Recorder &operator=(const Recorder&) = delete;
+		ARIS_REGISTER_TYPE(Recorder);
+
+	private:
+		struct Imp;
+		aris::core::ImpPtr<Imp> imp_;
+	};
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef ARIS_SERVER_REPLAY_H_
+#define ARIS_SERVER_REPLAY_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+
+#include <aris/core/core.hpp>
+#include <aris/control/control.hpp>
+#include <aris/plan/root.hpp>
+
+namespace aris::server
+{
+	class ControlServer;
+
+	// 离线回放：控制器以虚拟时间运行，每个周期只在需要时推进，因此回放与实际时间无关，可重复 //
+	// 回放脚本中的一条指令，在回放开始后的第 count 个周期之前提交 //
+	struct ReplayCommand
+	{
+		std::int64_t count;
+		std::string cmd;
+	};
+	struct ReplayResult
+	{
+		std::int64_t total_count;   // 回放运行的周期数 //
+		std::int64_t wall_time_ns;  // 回放的实际耗时 //
+		std::vector<std::shared_ptr<aris::plan::PlanTarget>> targets; // 按脚本顺序排列，指令解析或准备失败时为空 //
+		aris::control::Master::RtPhaseHistogram strategy_histogram;    // 实时循环中 tg() 的耗时，自服务器启动以来 //
+	};
+
+	// 每行为 "周期数 指令"，例如 "100 mvaj --pos=0.1"，空行以及以 # 开头的行被忽略 //
+	auto loadReplayScript(std::istream &is)->std::vector<ReplayCommand>;
+	// 按周期数依次提交指令，提交时实时循环暂停，提交过程需要等待实时循环时（例如 WAIT_FOR_EXECUTION ）逐周期推进 //
+	// 回放期间打开 ControlServer::setStepOnRtWait()，因此 prepairNrt 等非实时部分的耗时不影响回放的周期数 //
+	// 服务器需以虚拟时间启动（controller().setVirtualTime(true)），所有指令执行并收集完毕后返回 //
+	auto replay(ControlServer &cs, const std::vector<ReplayCommand> &script)->ReplayResult;
+}
+
+#endif
@@ -12,6 +12,10 @@
 #include <aris/sensor/sensor.hpp>
 #include <aris/dynamic/dynamic.hpp>
 #include <aris/plan/plan.hpp>
+#include <aris/server/recorder.hpp>
+#include <aris/server/motion_checker.hpp>
+#include <aris/server/motion_group.hpp>
+#include <aris/server/replay.hpp>
 
 namespace aris::server
 {
@@ -55,6 +59,24 @@ namespace aris::server
 		aris::core::XmlDocument doc_;
 	};
 
+	// 实时线程每周期发布的状态快照，读取时不阻塞实时线程 //
+	struct RtSnapshot
+	{
+		enum Item : std::uint32_t
+		{
+			MOTION_STATE = 0x01,  // 电机状态字、指令位置、速度、电流，以及安全检查时读到的实际位置与速度 //
+			MOTION_ACTUAL = 0x02, // 每周期从电机读取实际位置、速度、电流，需要映射对应的pdo //
+			PART_PM = 0x04,       // 模型中所有杆件的位姿矩阵 //
+		};
+
+		std::int64_t global_count;
+		std::vector<std::int64_t> command_id;  // 各运动组正在执行的指令，空闲时为 0 //
+		std::vector<std::int32_t> error_code;  // 各运动组本周期的错误，0 表示正常 //
+		std::vector<std::uint16_t> status_word;
+		std::vector<double> target_pos, target_vel, target_cur, actual_pos, actual_vel, actual_cur;
+		std::vector<double> part_pm;
+	};
+
 	class ControlServer : public aris::core::Object
 	{
 	public:
@@ -82,8 +104,18 @@ namespace aris::server
 		auto planRoot()const->const plan::PlanRoot& { return const_cast<ControlServer *>(this)->planRoot(); }
 		auto interfaceRoot()->InterfaceRoot&;
 		auto interfaceRoot()const->const InterfaceRoot& { return const_cast<ControlServer *>(this)->interfaceRoot(); }
-
+		auto recorder()->Recorder&;
+		auto recorder()const->const Recorder& { return const_cast<ControlServer *>(this)->recorder(); }
+		// 在 start() 时生效 //
+		auto motionGroupPool()->aris::core::ObjectPool<MotionGroup>&;
+		auto motionGroupPool()const->const aris::core::ObjectPool<MotionGroup>& { return const_cast<ControlServer *>(this)->motionGroupPool(); }
+		auto motionGroupStastics(aris::Size motion_group)->MotionGroup::Stastics;
+
+		// 可以在多个线程中同时调用，不同指令的 prepairNrt 可能并行执行，同一线程提交的实时指令按提交顺序执行 //
+		// 不指定运动组时放入第一个运动组，prepairNrt 中可以修改 target.motion_group //
 		auto executeCmd(const aris::core::Msg &cmd_string)->std::shared_ptr<aris::plan::PlanTarget>;
+		auto executeCmd(const aris::core::Msg &cmd_string, const std::string &motion_group)->std::shared_ptr<aris::plan::PlanTarget>;
+		auto executeCmd(const aris::core::Msg &cmd_string, aris::Size motion_group)->std::shared_ptr<aris::plan::PlanTarget>;
 		auto start()->void;
 		auto stop()->void;
 		auto running()->bool;
@@ -91,9 +123,20 @@ namespace aris::server
 		auto waitForAllCollection()->void;
 
 		auto globalCount()->std::int64_t;
-		auto currentExecuteId()->std::int64_t;
-		auto currentCollectId()->std::int64_t;
+		auto currentExecuteId(aris::Size motion_group = 0)->std::int64_t;
+		auto currentCollectId(aris::Size motion_group = 0)->std::int64_t;
+		// 在实时线程中执行 get_func，阻塞直到执行完毕，多个调用者依次执行 //
 		auto getRtData(const std::function<void(ControlServer&, std::any&)>& get_func, std::any& data)->void;
+		// 虚拟时间下，非实时线程（提交指令、getRtData 等）需要等待实时循环时，是否由该线程自己逐周期推进，默认为 false //
+		// 打开后只在确实等待实时循环时推进，推进的周期数与非实时部分的耗时无关，回放时使用 //
+		auto setStepOnRtWait(bool is_step)->void;
+		auto stepOnRtWait()const->bool;
+		// 快照包含的内容，为 RtSnapshot::Item 的组合，在 start() 时生效，默认为 MOTION_STATE //
+		// PART_PM 需要每周期复制所有杆件的位姿，需要时再打开 //
+		auto setRtSnapshotItems(std::uint32_t items)->void;
+		auto rtSnapshotItems()const->std::uint32_t;
+		// 复制最新的快照，可以在任意多个线程中同时调用，服务器未启动或尚未发布时返回 false //
+		auto rtSnapshot(RtSnapshot &snapshot)->bool;
 
 		ARIS_REGISTER_TYPE(ControlServer);
 
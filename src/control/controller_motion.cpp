@@ -89,6 +89,156 @@ namespace aris::control
 		imp_->home_pos_ = home_pos;
 	}
 
+	auto cia402NextStatus(std::uint16_t status_word, std::uint16_t control_word)->std::uint16_t
+	{
+		auto sw = static_cast<std::uint16_t>(status_word & 0x6F);
+		auto cw = control_word;
+
+		if ((sw & 0x4F) == 0x08) return (cw & 0x80) ? 0x40 : sw;
+		else if ((cw & 0x02) == 0) return 0x40;
+		else if ((sw & 0x4F) == 0x40) return (cw & 0x87) == 0x06 ? 0x21 : sw;
+		else if (sw == 0x21) return (cw & 0x87) == 0x07 ? 0x23 : sw;
+		else if (sw == 0x23) return (cw & 0x8F) == 0x0F ? 0x27 : (cw & 0x87) == 0x06 ? 0x21 : sw;
+		else if (sw == 0x27) return (cw & 0x8F) == 0x07 ? 0x23 : (cw & 0x87) == 0x06 ? 0x21 : sw;
+		else return sw;
+	}
+
+	struct SimulatedMotion::Imp
+	{
+		// 主站写入的指令，send() 时发给驱动器 //
+		std::uint16_t control_word_{ 0 };
+		std::uint8_t mode_of_operation_{ 8 };
+		double target_pos_{ 0 }, target_vel_{ 0 }, target_cur_{ 0 }, offset_vel_{ 0 }, offset_cur_{ 0 };
+
+		// 驱动器一侧 //
+		std::uint16_t drive_control_word_{ 0 };
+		std::uint8_t drive_mode_{ 8 };
+		double drive_target_pos_{ 0 }, drive_target_vel_{ 0 }, drive_target_cur_{ 0 };
+		std::uint16_t status_word_{ 0x40 };
+		std::uint8_t mode_of_display_{ 8 };
+		double actual_pos_{ 0 }, actual_vel_{ 0 }, actual_cur_{ 0 };
+
+		double following_ratio_{ 1.0 };
+		std::int64_t sample_period_ns_{ 1000000 };
+	};
+	auto SimulatedMotion::saveXml(aris::core::XmlElement &xml_ele) const->void
+	{
+		Motion::saveXml(xml_ele);
+		xml_ele.SetAttribute("following_ratio", followingRatio());
+		xml_ele.SetAttribute("sample_period_ns", samplePeriodNs());
+	}
+	auto SimulatedMotion::loadXml(const aris::core::XmlElement &xml_ele)->void
+	{
+		imp_->following_ratio_ = attributeDouble(xml_ele, "following_ratio", 1.0);
+		imp_->sample_period_ns_ = attributeInt64(xml_ele, "sample_period_ns", 1000000);
+		Motion::loadXml(xml_ele);
+	}
+	auto SimulatedMotion::send()->void
+	{
+		imp_->drive_control_word_ = imp_->control_word_;
+		imp_->drive_mode_ = imp_->mode_of_operation_;
+		imp_->drive_target_pos_ = imp_->target_pos_;
+		imp_->drive_target_vel_ = imp_->target_vel_ + imp_->offset_vel_;
+		imp_->drive_target_cur_ = imp_->target_cur_ + imp_->offset_cur_;
+	}
+	auto SimulatedMotion::recv()->void
+	{
+		auto &d = *imp_;
+		auto cw = d.drive_control_word_;
+		auto &sw = d.status_word_;
+
+		sw = cia402NextStatus(sw, cw);
+		d.mode_of_display_ = d.drive_mode_;
+
+		// 驱动器响应，未使能时保持不动 //
+		const double dt = d.sample_period_ns_ * 1e-9;
+		const double last_pos = d.actual_pos_;
+		d.actual_cur_ = 0.0;
+		if ((sw & 0x6F) == 0x27)
+		{
+			switch (d.mode_of_display_)
+			{
+			case 8: d.actual_pos_ += d.following_ratio_ * (d.drive_target_pos_ - d.actual_pos_); break;
+			case 9: d.actual_pos_ += d.drive_target_vel_ * dt; break;
+			case 10: d.actual_cur_ = d.drive_target_cur_; break;
+			default:break;
+			}
+		}
+		d.actual_vel_ = (d.actual_pos_ - last_pos) / dt;
+	}
+	auto SimulatedMotion::followingRatio()const->double { return imp_->following_ratio_; }
+	auto SimulatedMotion::setFollowingRatio(double ratio)->void { imp_->following_ratio_ = ratio; }
+	auto SimulatedMotion::samplePeriodNs()const->std::int64_t { return imp_->sample_period_ns_; }
+	auto SimulatedMotion::setSamplePeriodNs(std::int64_t period_ns)->void { imp_->sample_period_ns_ = period_ns; }
+	auto SimulatedMotion::controlWord()const->std::uint16_t { return imp_->control_word_; }
+	auto SimulatedMotion::modeOfOperation()const->std::uint8_t { return imp_->mode_of_operation_; }
+	auto SimulatedMotion::targetPos()const->double { return imp_->target_pos_; }
+	auto SimulatedMotion::targetVel()const->double { return imp_->target_vel_; }
+	auto SimulatedMotion::targetCur()const->double { return imp_->target_cur_; }
+	auto SimulatedMotion::offsetVel()const->double { return imp_->offset_vel_; }
+	auto SimulatedMotion::offsetCur()const->double { return imp_->offset_cur_; }
+	auto SimulatedMotion::setControlWord(std::uint16_t control_word)->void { imp_->control_word_ = control_word; }
+	auto SimulatedMotion::setModeOfOperation(std::uint8_t mode)->void { imp_->mode_of_operation_ = mode; }
+	auto SimulatedMotion::setTargetPos(double pos)->void { imp_->target_pos_ = pos; }
+	auto SimulatedMotion::setTargetVel(double vel)->void { imp_->target_vel_ = vel; }
+	auto SimulatedMotion::setTargetCur(double cur)->void { imp_->target_cur_ = cur; }
+	auto SimulatedMotion::setOffsetVel(double vel)->void { imp_->offset_vel_ = vel; }
+	auto SimulatedMotion::setOffsetCur(double cur)->void { imp_->offset_cur_ = cur; }
+	auto SimulatedMotion::statusWord()->std::uint16_t { return imp_->status_word_; }
+	auto SimulatedMotion::modeOfDisplay()->std::uint8_t { return imp_->mode_of_display_; }
+	auto SimulatedMotion::actualPos()->double { return imp_->actual_pos_; }
+	auto SimulatedMotion::actualVel()->double { return imp_->actual_vel_; }
+	auto SimulatedMotion::actualCur()->double { return imp_->actual_cur_; }
+	auto SimulatedMotion::disable()->int
+	{
+		// 与 EthercatMotion 相同，停在 switch on 状态 //
+		auto sw = statusWord();
+		if ((sw & 0x6F) == 0x23) return 0;
+		else if ((sw & 0x4F) == 0x40) { setControlWord(0x06); return 1; }
+		else if ((sw & 0x6F) == 0x21) { setControlWord(0x07); return 1; }
+		else if ((sw & 0x6F) == 0x27) { setControlWord(0x07); return 1; }
+		else if ((sw & 0x4F) == 0x08) { setControlWord(0x80); return 1; }
+		else return -1;
+	}
+	auto SimulatedMotion::enable()->int
+	{
+		auto sw = statusWord();
+		if ((sw & 0x4F) == 0x40) { setControlWord(0x06); return 2; }
+		else if ((sw & 0x6F) == 0x21) { setControlWord(0x07); return 3; }
+		else if ((sw & 0x6F) == 0x23)
+		{
+			setControlWord(0x0F);
+			setTargetPos(actualPos());
+			setTargetVel(0.0);
+			setTargetCur(0.0);
+			return 4;
+		}
+		else if ((sw & 0x6F) == 0x27) return 0;
+		else if ((sw & 0x4F) == 0x08) { setControlWord(0x80); return 7; }
+		else return -1;
+	}
+	auto SimulatedMotion::home()->int
+	{
+		// 仿真电机直接回到原点 //
+		imp_->actual_pos_ = homePos();
+		imp_->target_pos_ = homePos();
+		return 0;
+	}
+	auto SimulatedMotion::mode(std::uint8_t md)->int
+	{
+		setModeOfOperation(md);
+		return modeOfDisplay() == md ? 0 : 1;
+	}
+	SimulatedMotion::~SimulatedMotion() = default;
+	SimulatedMotion::SimulatedMotion(const std::string &name, std::uint16_t phy_id
+		, double max_pos, double min_pos, double max_vel, double min_vel, double max_acc, double min_acc
+		, double max_pos_following_error, double max_vel_following_error, double pos_factor, double pos_offset, double home_pos)
+		: Slave(name, phy_id)
+		, Motion(name, phy_id, max_pos, min_pos, max_vel, min_vel, max_acc, min_acc, max_pos_following_error, max_vel_following_error, pos_factor, pos_offset, home_pos)
+		, imp_(new Imp)
+	{
+	}
+
 	struct Controller::Imp { aris::core::RefPool<Motion> motion_pool_; };
 	auto Controller::motionPool()->aris::core::RefPool<Motion>& { return imp_->motion_pool_; }
 	auto Controller::init()->void
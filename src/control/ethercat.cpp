@@ -3,6 +3,9 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <set>
+#include <deque>
+#include <condition_variable>
 #include <atomic>
 #include <memory>
 #include <typeinfo>
@@ -10,6 +13,9 @@
 #include <chrono>
 #include <future>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 
 #include "aris/control/rt_timer.hpp"
 #include "aris/control/ethercat_kernel.hpp"
@@ -20,6 +26,7 @@ namespace aris::control
 	struct PdoEntry::Imp 
 	{ 
 		std::any ec_handle_; 
+		PdoBinding binding_;
 		std::uint16_t index_;
 		std::uint8_t subindex_;
 		aris::Size bit_size_;
@@ -47,6 +54,7 @@ namespace aris::control
 		Object::loadXml(xml_ele);
 	}
 	auto PdoEntry::ecHandle()->std::any& { return imp_->ec_handle_; }
+	auto PdoEntry::binding()const->const PdoBinding& { return imp_->binding_; }
 	auto PdoEntry::index()const->std::uint16_t { return imp_->index_; }
 	auto PdoEntry::subindex()const->std::uint8_t { return imp_->subindex_; }
 	auto PdoEntry::bitSize()const->aris::Size { return imp_->bit_size_; }
@@ -148,24 +156,78 @@ namespace aris::control
 	{
 		auto entry = imp_->pdo_map_.at(index).at(subindex);
 		if (entry->bitSize() != bit_size)throw std::runtime_error("failed to read pdo entry:\"" + entry->name() + "\" because byte size is not correct");
-		aris_ecrt_pdo_read(entry, value, static_cast<int>(bit_size));
+		readPdo(entry->binding(), value, bit_size);
 	}
 	auto EthercatSlave::writePdo(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size bit_size)->void
 	{
 		auto entry = imp_->pdo_map_.at(index).at(subindex);
 		if (entry->bitSize() != bit_size)throw std::runtime_error("failed to write pdo_entry:\"" + entry->name() + "\" because byte size is not correct");
-		aris_ecrt_pdo_write(entry, value, static_cast<int>(bit_size));
+		writePdo(entry->binding(), value, bit_size);
+	}
+	auto EthercatSlave::pdoBinding(std::uint16_t index, std::uint8_t subindex)const->PdoBinding
+	{
+		auto found_index = imp_->pdo_map_.find(index);
+		if (found_index == imp_->pdo_map_.end()) return PdoBinding();
+		auto found_subindex = found_index->second.find(subindex);
+		return found_subindex == found_index->second.end() ? PdoBinding() : found_subindex->second->binding();
+	}
+	auto EthercatSlave::readPdo(const PdoBinding &pdo, void *value, aris::Size bit_size)->void
+	{
+		if (!pdo.data)throw std::runtime_error("failed to read pdo of slave \"" + name() + "\" because pdo is not bound");
+		if (pdo.bit_size != bit_size)throw std::runtime_error("failed to read pdo of slave \"" + name() + "\" because byte size is not correct");
+		read_bit2(reinterpret_cast<char*>(value), static_cast<int>(bit_size), reinterpret_cast<const char*>(pdo.data), 0, pdo.bit_position);
+	}
+	auto EthercatSlave::writePdo(const PdoBinding &pdo, const void *value, aris::Size bit_size)->void
+	{
+		if (!pdo.data)throw std::runtime_error("failed to write pdo of slave \"" + name() + "\" because pdo is not bound");
+		if (pdo.bit_size != bit_size)throw std::runtime_error("failed to write pdo of slave \"" + name() + "\" because byte size is not correct");
+		write_bit2(reinterpret_cast<const char*>(value), static_cast<int>(bit_size), reinterpret_cast<char*>(pdo.data), 0, pdo.bit_position);
+	}
+	auto sdo_error_msg(const EthercatSlave &slave, bool is_write, std::uint16_t index, std::uint8_t subindex, int error_code, std::uint32_t abort_code)->std::string
+	{
+		std::stringstream ss;
+		ss << "failed to " << (is_write ? "write" : "read") << " sdo 0x" << std::hex << std::setfill('0') << std::setw(4) << index << ":" << std::setw(2) << static_cast<int>(subindex)
+			<< " of slave \"" << slave.name() << "\", abort code 0x" << std::setw(8) << abort_code << std::dec << ", error code " << error_code;
+		return ss.str();
 	}
 	auto EthercatSlave::readSdo(std::uint16_t index, std::uint8_t subindex, void *value, aris::Size byte_size)->void
 	{
-		std::size_t result_size;
-		std::uint32_t abort_code;
-		aris_ecrt_sdo_read(ancestor<EthercatMaster>()->ecHandle(), phyId(), index, subindex, reinterpret_cast<std::uint8_t*>(value), byte_size, &result_size, &abort_code);
+		std::size_t result_size{ 0 };
+		std::uint32_t abort_code{ 0 };
+		if (auto ret = aris_ecrt_sdo_read(ancestor<EthercatMaster>(), phyId(), index, subindex, reinterpret_cast<std::uint8_t*>(value), byte_size, &result_size, &abort_code))
+			throw std::runtime_error(sdo_error_msg(*this, false, index, subindex, ret, abort_code));
 	}
 	auto EthercatSlave::writeSdo(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size byte_size)->void
 	{
-		std::uint32_t abort_code;
-		aris_ecrt_sdo_write(ancestor<EthercatMaster>()->ecHandle(), phyId(), index, subindex, const_cast<std::uint8_t*>(reinterpret_cast<const std::uint8_t*>(value)), byte_size, &abort_code);
+		std::uint32_t abort_code{ 0 };
+		if (auto ret = aris_ecrt_sdo_write(ancestor<EthercatMaster>(), phyId(), index, subindex, const_cast<std::uint8_t*>(reinterpret_cast<const std::uint8_t*>(value)), byte_size, &abort_code))
+			throw std::runtime_error(sdo_error_msg(*this, true, index, subindex, ret, abort_code));
+	}
+	auto EthercatSlave::readSdoAsync(std::uint16_t index, std::uint8_t subindex, aris::Size byte_size, SdoCallback callback, std::chrono::milliseconds timeout)->std::shared_ptr<SdoRequest>
+	{
+		auto request = std::make_shared<SdoRequest>();
+		request->slave = this;
+		request->index = index;
+		request->subindex = subindex;
+		request->is_write = false;
+		request->data.resize(byte_size);
+		request->deadline = std::chrono::steady_clock::now() + timeout;
+		request->callback = std::move(callback);
+		ancestor<EthercatMaster>()->submitSdo(request);
+		return request;
+	}
+	auto EthercatSlave::writeSdoAsync(std::uint16_t index, std::uint8_t subindex, const void *value, aris::Size byte_size, SdoCallback callback, std::chrono::milliseconds timeout)->std::shared_ptr<SdoRequest>
+	{
+		auto request = std::make_shared<SdoRequest>();
+		request->slave = this;
+		request->index = index;
+		request->subindex = subindex;
+		request->is_write = true;
+		request->data.assign(reinterpret_cast<const std::uint8_t*>(value), reinterpret_cast<const std::uint8_t*>(value) + byte_size);
+		request->deadline = std::chrono::steady_clock::now() + timeout;
+		request->callback = std::move(callback);
+		ancestor<EthercatMaster>()->submitSdo(request);
+		return request;
 	}
 	EthercatSlave::~EthercatSlave() = default;
 	EthercatSlave::EthercatSlave(const std::string &name, std::uint16_t phy_id, std::uint32_t vid, std::uint32_t p_code, std::uint32_t r_num, std::uint32_t dc) :Slave(name, phy_id), imp_(new Imp)
@@ -184,10 +246,224 @@ namespace aris::control
 	public:
 		std::any ec_handle_;
 		aris::core::RefPool<EthercatSlave> ec_slave_pool_;
+
+		// 扫描得到的pdo配置，按型号缓存 //
+		std::string scan_cache_path_;
+		aris::core::ObjectPool<Slave> scan_cache_{ "scan_cache" };
+		aris::core::ObjectPool<Slave> simulation_bus_{ "simulation_bus" };
+
+		double simulation_following_ratio_{ 1.0 };
+		aris::Size simulation_home_count_{ 100 };
+		double simulation_clock_drift_ppm_{ 0.0 };
+
+		// 分布时钟，只在实时线程中修改 //
+		bool is_dc_correction_{ false };
+		double dc_kp_{ 0.1 }, dc_ki_{ 0.01 };
+		bool is_dc_started_{ false };
+		std::int64_t last_app_time_{ 0 }, last_offset_{ 0 };
+		std::int64_t dc_time_base_{ 0 }; // 主站时间 = 实时时钟 + dc_time_base_ //
+		double dc_integral_{ 0.0 };
+
+		// 分布时钟的统计，供非实时线程读取 //
+		std::atomic<std::int64_t> dc_count_{ 0 }, dc_offset_{ 0 }, dc_max_abs_offset_{ 0 }, dc_sum_abs_offset_{ 0 }, dc_max_abs_jitter_{ 0 }, dc_correction_{ 0 }, dc_time_base_stat_{ 0 };
+
+		// 异步SDO，每个从站一个队列，正在执行的从站不会被其他工作线程取到，以保证同一从站的顺序 //
+		std::chrono::microseconds simulation_sdo_latency_{ 0 };
+		aris::Size sdo_worker_num_{ 4 };
+		std::mutex sdo_mu_;
+		std::condition_variable sdo_cv_, sdo_finished_cv_;
+		std::map<EthercatSlave*, std::deque<std::shared_ptr<SdoRequest>>> sdo_queues_;
+		std::set<EthercatSlave*> sdo_busy_slaves_;
+		aris::Size sdo_unfinished_num_{ 0 };
+		bool is_sdo_running_{ false };
+		std::vector<std::thread> sdo_workers_;
+
+		auto sdoWorker(EthercatMaster *master)->void
+		{
+			for (;;)
+			{
+				std::shared_ptr<SdoRequest> request;
+				{
+					std::unique_lock<std::mutex> lck(sdo_mu_);
+					sdo_cv_.wait(lck, [&]()
+					{
+						if (!is_sdo_running_) return true;
+						for (auto &q : sdo_queues_) if (!q.second.empty() && !sdo_busy_slaves_.count(q.first)) return true;
+						return false;
+					});
+					if (!is_sdo_running_) return;
+
+					for (auto &q : sdo_queues_)
+					{
+						if (!q.second.empty() && !sdo_busy_slaves_.count(q.first))
+						{
+							request = q.second.front();
+							q.second.pop_front();
+							sdo_busy_slaves_.insert(q.first);
+							break;
+						}
+					}
+				}
+
+				auto &r = *request;
+				if (std::chrono::steady_clock::now() > r.deadline)
+				{
+					r.state = SdoRequest::TIMEOUT;
+				}
+				else
+				{
+					std::size_t result_size{ 0 };
+					r.error_code = r.is_write
+						? aris_ecrt_sdo_write(master, r.slave->phyId(), r.index, r.subindex, r.data.data(), r.data.size(), &r.abort_code)
+						: aris_ecrt_sdo_read(master, r.slave->phyId(), r.index, r.subindex, r.data.data(), r.data.size(), &result_size, &r.abort_code);
+					r.state = r.error_code ? SdoRequest::FAILED : SdoRequest::SUCCESS;
+				}
+				if (r.callback) r.callback(r);
+				r.finished.finish();
+
+				{
+					std::lock_guard<std::mutex> lck(sdo_mu_);
+					sdo_busy_slaves_.erase(r.slave);
+					--sdo_unfinished_num_;
+				}
+				sdo_cv_.notify_all();
+				sdo_finished_cv_.notify_all();
+			}
+		}
+		~Imp()
+		{
+			// 停止工作线程取新的请求，并取出队列中剩余的请求 //
+			std::vector<std::shared_ptr<SdoRequest>> aborted;
+			{
+				std::lock_guard<std::mutex> lck(sdo_mu_);
+				is_sdo_running_ = false;
+				for (auto &q : sdo_queues_) aborted.insert(aborted.end(), q.second.begin(), q.second.end());
+				sdo_queues_.clear();
+			}
+			sdo_cv_.notify_all();
+
+			// 在等待正在执行的请求之前结束剩余的请求，等待者不必等到工作线程退出 //
+			for (auto &request : aborted)
+			{
+				request->state = SdoRequest::ABORTED;
+				if (request->callback) request->callback(*request);
+				request->finished.finish();
+			}
+			{
+				std::lock_guard<std::mutex> lck(sdo_mu_);
+				sdo_unfinished_num_ -= aborted.size();
+			}
+			sdo_finished_cv_.notify_all();
+
+			for (auto &t : sdo_workers_) t.join();
+		}
 	};
-	auto EthercatMaster::scan()->void { aris_ecrt_scan(this); }
+	auto copy_sm_pool(const EthercatSlave &from, EthercatSlave &to)->void
+	{
+		to.smPool().clear();
+		for (auto &from_sm : from.smPool())
+		{
+			auto &sm = to.smPool().add<SyncManager>(from_sm.name(), from_sm.tx());
+			for (auto &from_pdo : from_sm)
+			{
+				auto &pdo = sm.add<Pdo>(from_pdo.name(), from_pdo.index());
+				for (auto &entry : from_pdo) pdo.add<PdoEntry>(entry.name(), entry.index(), entry.subindex(), entry.bitSize());
+			}
+		}
+	}
+	auto EthercatMaster::scan()->ScanStatistics
+	{
+		ScanStatistics stastics{ 0, 0, 0 };
+
+		std::vector<ScannedSlave> bus;
+		if (aris_ecrt_scan_slaves(this, &bus)) throw std::runtime_error("failed to scan ethercat slaves");
+
+		auto is_same_model = [](const EthercatSlave &sla, const ScannedSlave &s)
+		{
+			return sla.vendorID() == s.vendor_id && sla.productCode() == s.product_code && sla.revisionNum() == s.revision_num;
+		};
+		auto find_in_cache = [&](const ScannedSlave &s)->EthercatSlave*
+		{
+			for (auto &sla : imp_->scan_cache_) if (is_same_model(dynamic_cast<EthercatSlave&>(sla), s)) return &dynamic_cast<EthercatSlave&>(sla);
+			return nullptr;
+		};
+
+		// 读取磁盘上的缓存，不存在或损坏时忽略 //
+		if (!imp_->scan_cache_path_.empty() && std::filesystem::exists(imp_->scan_cache_path_))
+		{
+			try
+			{
+				aris::core::ObjectPool<Slave> cache{ "scan_cache" };
+				cache.loadXmlFile(imp_->scan_cache_path_);
+				for (auto &cache_sla : cache)
+				{
+					auto &sla = dynamic_cast<EthercatSlave&>(cache_sla);
+					if (find_in_cache(ScannedSlave{ 0, "", sla.vendorID(), sla.productCode(), sla.revisionNum() })) continue;
+					auto &cached = imp_->scan_cache_.add<EthercatSlave>(sla.name(), 0, sla.vendorID(), sla.productCode(), sla.revisionNum());
+					copy_sm_pool(sla, cached);
+				}
+			}
+			catch (std::exception &) {}
+		}
+
+		// 第一个变化的从站，此前的从站都与总线一致，并且已有pdo配置 //
+		aris::Size first_changed{ 0 };
+		for (; first_changed < bus.size() && first_changed < slavePool().size(); ++first_changed)
+		{
+			auto sla = dynamic_cast<EthercatSlave*>(&slavePool()[first_changed]);
+			if (!sla || sla->phyId() != bus[first_changed].position || !is_same_model(*sla, bus[first_changed]) || sla->smPool().empty()) break;
+		}
+		stastics.kept_count = first_changed;
+
+		// 缓存中没有的型号，各读取一次，不同型号同时读取 //
+		std::vector<aris::Size> to_fetch;
+		for (auto i = first_changed; i < bus.size(); ++i)
+		{
+			if (find_in_cache(bus[i])) continue;
+			if (std::none_of(to_fetch.begin(), to_fetch.end(), [&](aris::Size j) { return bus[j].vendor_id == bus[i].vendor_id && bus[j].product_code == bus[i].product_code && bus[j].revision_num == bus[i].revision_num; }))
+				to_fetch.push_back(i);
+		}
+		std::vector<std::unique_ptr<EthercatSlave>> fetched;
+		std::vector<std::future<int>> fetch_rets;
+		for (auto i : to_fetch)
+		{
+			auto &s = bus[i];
+			fetched.push_back(std::make_unique<EthercatSlave>(s.name, 0, s.vendor_id, s.product_code, s.revision_num));
+			fetch_rets.push_back(std::async(std::launch::async, aris_ecrt_scan_pdo, this, s.position, fetched.back().get()));
+		}
+		for (aris::Size i = 0; i < to_fetch.size(); ++i)
+		{
+			if (fetch_rets[i].get()) throw std::runtime_error("failed to scan pdo of ethercat slave at position " + std::to_string(bus[to_fetch[i]].position));
+			auto &cached = imp_->scan_cache_.add<EthercatSlave>(fetched[i]->name(), 0, fetched[i]->vendorID(), fetched[i]->productCode(), fetched[i]->revisionNum());
+			copy_sm_pool(*fetched[i], cached);
+		}
+		stastics.fetched_count = to_fetch.size();
+
+		// 重新建立变化之后的从站 //
+		while (slavePool().size() > first_changed) slavePool().pop_back();
+		for (auto i = first_changed; i < bus.size(); ++i)
+		{
+			auto &s = bus[i];
+			auto &sla = slavePool().add<EthercatSlave>(s.name, s.position, s.vendor_id, s.product_code, s.revision_num);
+			copy_sm_pool(*find_in_cache(s), sla);
+		}
+		stastics.rebuilt_count = bus.size() - first_changed;
+
+		if (!imp_->scan_cache_path_.empty() && stastics.fetched_count) imp_->scan_cache_.saveXmlFile(imp_->scan_cache_path_);
+
+		return stastics;
+	}
+	auto EthercatMaster::scanCachePath()const->const std::string& { return imp_->scan_cache_path_; }
+	auto EthercatMaster::setScanCachePath(const std::string &path)->void { imp_->scan_cache_path_ = path; }
+	auto EthercatMaster::simulationBus()->aris::core::ObjectPool<Slave>& { return imp_->simulation_bus_; }
 	auto EthercatMaster::init()->void
 	{
+		// reset dc //
+		imp_->is_dc_started_ = false;
+		imp_->last_app_time_ = imp_->last_offset_ = imp_->dc_time_base_ = 0;
+		imp_->dc_integral_ = 0.0;
+		for (auto v : { &imp_->dc_count_, &imp_->dc_offset_, &imp_->dc_max_abs_offset_, &imp_->dc_sum_abs_offset_, &imp_->dc_max_abs_jitter_, &imp_->dc_correction_, &imp_->dc_time_base_stat_ }) v->store(0);
+
 		// make ec_slave_pool_ //
 		imp_->ec_slave_pool_.clear();
 		for (auto &sla : slavePool()) if (dynamic_cast<EthercatSlave*>(&sla)) imp_->ec_slave_pool_.push_back_ptr(dynamic_cast<EthercatSlave*>(&sla));
@@ -222,13 +498,128 @@ namespace aris::control
 		}
 
 		aris_ecrt_master_request(this);
+
+		// bind pdo entries to process data, so that rt thread need not search them //
+		for (auto &sla : ecSlavePool())
+		{
+			for (auto &sm : sla.smPool())
+			{
+				for (auto &pdo : sm)
+				{
+					for (auto &entry : pdo)
+					{
+						entry.imp_->binding_ = PdoBinding();
+						if (entry.index())
+						{
+							aris_ecrt_pdo_locate(this, &entry, &entry.imp_->binding_.data, &entry.imp_->binding_.bit_position);
+							entry.imp_->binding_.bit_size = entry.bitSize();
+						}
+					}
+				}
+			}
+
+			sla.init();
+		}
 	}
 	auto EthercatMaster::release()->void { aris_ecrt_master_stop(this); }
 	auto EthercatMaster::send()->void { aris_ecrt_master_send(this); }
 	auto EthercatMaster::recv()->void { aris_ecrt_master_recv(this); }
-	auto EthercatMaster::sync()->void { aris_ecrt_master_sync(this, aris_rt_timer_read()); }
+	auto EthercatMaster::sync()->void 
+	{
+		auto &d = *imp_;
+
+		// 参考时钟为上一周期发出的同步报文所读到的时间，因此与上一周期的主站时间比较 //
+		std::uint32_t reference_time;
+		std::int64_t correction{ 0 };
+		if (d.is_dc_started_ && aris_ecrt_master_reference_clock_time(this, &reference_time) == 0)
+		{
+			const std::int64_t offset = static_cast<std::int32_t>(reference_time - static_cast<std::uint32_t>(d.last_app_time_));
+			const std::int64_t jitter = d.dc_count_.load(std::memory_order_relaxed) ? offset - d.last_offset_ : 0;
+			d.last_offset_ = offset;
+
+			// PI 调整主站时间基准，每周期最多十分之一个周期 //
+			if (d.is_dc_correction_)
+			{
+				const auto max_correction = samplePeriodNs() / 10;
+				const double integral = d.dc_integral_ + offset;
+				const double output = d.dc_kp_ * offset + d.dc_ki_ * integral;
+				correction = std::clamp<std::int64_t>(std::llround(output), -max_correction, max_correction);
+
+				// 抗积分饱和：输出饱和且 offset 继续推向饱和方向时不再积分 //
+				if (std::abs(output) <= max_correction || (output > 0) != (offset > 0)) d.dc_integral_ = integral;
+			}
+
+			d.dc_count_.store(d.dc_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			d.dc_offset_.store(offset, std::memory_order_relaxed);
+			d.dc_max_abs_offset_.store(std::max(d.dc_max_abs_offset_.load(std::memory_order_relaxed), std::abs(offset)), std::memory_order_relaxed);
+			d.dc_sum_abs_offset_.store(d.dc_sum_abs_offset_.load(std::memory_order_relaxed) + std::abs(offset), std::memory_order_relaxed);
+			d.dc_max_abs_jitter_.store(std::max(d.dc_max_abs_jitter_.load(std::memory_order_relaxed), std::abs(jitter)), std::memory_order_relaxed);
+			d.dc_correction_.store(correction, std::memory_order_relaxed);
+		}
+
+		// 主站时间取计划的周期起点加时间基准，不含唤醒抖动 //
+		d.last_app_time_ = aris_rt_task_period_time() + d.dc_time_base_;
+		aris_ecrt_master_sync(this, d.last_app_time_, !d.is_dc_correction_ || !d.is_dc_started_);
+		d.is_dc_started_ = true;
+
+		// 时间基准前移多少，实时时钟上的下一次唤醒就提前多少，使唤醒时刻在主站时间上仍是等间隔的 //
+		d.dc_time_base_ += correction;
+		d.dc_time_base_stat_.store(d.dc_time_base_, std::memory_order_relaxed);
+		if (correction) aris_rt_task_correct_period(-correction);
+	}
+	auto EthercatMaster::sdoWorkerNum()const->aris::Size { return imp_->sdo_worker_num_; }
+	auto EthercatMaster::setSdoWorkerNum(aris::Size num)->void 
+	{
+		std::lock_guard<std::mutex> lck(imp_->sdo_mu_);
+		if (imp_->is_sdo_running_) throw std::runtime_error("can't set sdo worker num after sdo workers started");
+		imp_->sdo_worker_num_ = std::max<aris::Size>(num, 1);
+	}
+	auto EthercatMaster::waitSdo()->void
+	{
+		std::unique_lock<std::mutex> lck(imp_->sdo_mu_);
+		imp_->sdo_finished_cv_.wait(lck, [&]() { return imp_->sdo_unfinished_num_ == 0; });
+	}
+	auto EthercatMaster::submitSdo(std::shared_ptr<SdoRequest> request)->void
+	{
+		{
+			std::lock_guard<std::mutex> lck(imp_->sdo_mu_);
+			if (!imp_->is_sdo_running_)
+			{
+				imp_->is_sdo_running_ = true;
+				for (aris::Size i = 0; i < imp_->sdo_worker_num_; ++i) imp_->sdo_workers_.push_back(std::thread([this]() { imp_->sdoWorker(this); }));
+			}
+			imp_->sdo_queues_[request->slave].push_back(std::move(request));
+			++imp_->sdo_unfinished_num_;
+		}
+		imp_->sdo_cv_.notify_one();
+	}
+	auto EthercatMaster::isDcCorrection()const->bool { return imp_->is_dc_correction_; }
+	auto EthercatMaster::setDcCorrection(bool is_dc_correction)->void { imp_->is_dc_correction_ = is_dc_correction; }
+	auto EthercatMaster::dcCorrectionKp()const->double { return imp_->dc_kp_; }
+	auto EthercatMaster::dcCorrectionKi()const->double { return imp_->dc_ki_; }
+	auto EthercatMaster::setDcCorrectionGain(double kp, double ki)->void { imp_->dc_kp_ = kp; imp_->dc_ki_ = ki; }
+	auto EthercatMaster::dcSyncStatistics()const->DcSyncStatistics
+	{
+		DcSyncStatistics stastics;
+		stastics.count = imp_->dc_count_.load(std::memory_order_relaxed);
+		stastics.offset_ns = imp_->dc_offset_.load(std::memory_order_relaxed);
+		stastics.max_abs_offset_ns = imp_->dc_max_abs_offset_.load(std::memory_order_relaxed);
+		stastics.mean_abs_offset_ns = stastics.count ? static_cast<double>(imp_->dc_sum_abs_offset_.load(std::memory_order_relaxed)) / stastics.count : 0.0;
+		stastics.max_abs_jitter_ns = imp_->dc_max_abs_jitter_.load(std::memory_order_relaxed);
+		stastics.correction_ns = imp_->dc_correction_.load(std::memory_order_relaxed);
+		stastics.time_base_ns = imp_->dc_time_base_stat_.load(std::memory_order_relaxed);
+		return stastics;
+	}
 	auto EthercatMaster::ecHandle()->std::any& { return imp_->ec_handle_; }
 	auto EthercatMaster::ecSlavePool()->aris::core::RefPool<EthercatSlave>& { return imp_->ec_slave_pool_; }
+	auto EthercatMaster::simulationFollowingRatio()const->double { return imp_->simulation_following_ratio_; }
+	auto EthercatMaster::setSimulationFollowingRatio(double ratio)->void { imp_->simulation_following_ratio_ = ratio; }
+	auto EthercatMaster::simulationHomeCount()const->aris::Size { return imp_->simulation_home_count_; }
+	auto EthercatMaster::setSimulationHomeCount(aris::Size count)->void { imp_->simulation_home_count_ = count; }
+	auto EthercatMaster::simulationClockDriftPpm()const->double { return imp_->simulation_clock_drift_ppm_; }
+	auto EthercatMaster::setSimulationClockDriftPpm(double ppm)->void { imp_->simulation_clock_drift_ppm_ = ppm; }
+	auto EthercatMaster::simulationSdoLatency()const->std::chrono::microseconds { return imp_->simulation_sdo_latency_; }
+	auto EthercatMaster::setSimulationSdoLatency(std::chrono::microseconds latency)->void { imp_->simulation_sdo_latency_ = latency; }
 	EthercatMaster::~EthercatMaster() = default;
 	EthercatMaster::EthercatMaster(const std::string &name) :Master(name), imp_(new Imp){}
 
@@ -238,6 +629,10 @@ namespace aris::control
 		std::uint16_t control_word;
 		std::uint8_t mode_of_operation;
 		double target_pos_{ 0 }, target_vel_{ 0 }, target_cur_{ 0 }, offset_vel_{ 0 }, offset_cur_{ 0 };
+
+		// pdo bound in init() //
+		PdoBinding control_word_pdo_, mode_of_operation_pdo_, target_pos_pdo_, target_vel_pdo_, target_cur_pdo_, offset_vel_pdo_, offset_cur_pdo_;
+		PdoBinding status_word_pdo_, mode_of_display_pdo_, actual_pos_pdo_, actual_vel_pdo_, actual_cur_pdo_;
 		
 		int waiting_count_left{ 0 }; // enable 在用
 		
@@ -256,6 +651,21 @@ namespace aris::control
 		Motion::loadXml(xml_ele);
 		EthercatSlave::loadXml(xml_ele);
 	}
+	auto EthercatMotion::init()->void
+	{
+		imp_->control_word_pdo_ = pdoBinding(0x6040, 0x00);
+		imp_->mode_of_operation_pdo_ = pdoBinding(0x6060, 0x00);
+		imp_->target_pos_pdo_ = pdoBinding(0x607A, 0x00);
+		imp_->target_vel_pdo_ = pdoBinding(0x60FF, 0x00);
+		imp_->target_cur_pdo_ = pdoBinding(0x6071, 0x00);
+		imp_->offset_vel_pdo_ = pdoBinding(0x60B1, 0x00);
+		imp_->offset_cur_pdo_ = pdoBinding(0x60B2, 0x00);
+		imp_->status_word_pdo_ = pdoBinding(0x6041, 0x00);
+		imp_->mode_of_display_pdo_ = pdoBinding(0x6061, 0x00);
+		imp_->actual_pos_pdo_ = pdoBinding(0x6064, 0x00);
+		imp_->actual_vel_pdo_ = pdoBinding(0x606C, 0x00);
+		imp_->actual_cur_pdo_ = pdoBinding(0x6078, 0x00);
+	}
 	auto EthercatMotion::controlWord()const->std::uint16_t { return imp_->control_word; }
 	auto EthercatMotion::modeOfOperation()const->std::uint8_t { return imp_->mode_of_operation; }
 	auto EthercatMotion::targetPos()const->double { return imp_->target_pos_; }
@@ -266,66 +676,66 @@ namespace aris::control
 	auto EthercatMotion::setControlWord(std::uint16_t control_word)->void
 	{
 		imp_->control_word = control_word;
-		writePdo(0x6040, 0x00, control_word);
+		writePdo(imp_->control_word_pdo_, control_word);
 	}
 	auto EthercatMotion::setModeOfOperation(std::uint8_t mode)->void
 	{
 		imp_->mode_of_operation = mode;
-		writePdo(0x6060, 0x00, mode);
+		writePdo(imp_->mode_of_operation_pdo_, mode);
 	}
 	auto EthercatMotion::setTargetPos(double pos)->void
 	{
 		imp_->target_pos_ = pos;
-		writePdo(0x607A, 0x00, static_cast<std::int32_t>((pos + posOffset()) * posFactor()));
+		writePdo(imp_->target_pos_pdo_, static_cast<std::int32_t>((pos + posOffset()) * posFactor()));
 	}
 	auto EthercatMotion::setTargetVel(double vel)->void
 	{
 		imp_->target_vel_ = vel;
-		writePdo(0x60FF, 0x00, static_cast<std::int32_t>(vel * posFactor()));
+		writePdo(imp_->target_vel_pdo_, static_cast<std::int32_t>(vel * posFactor()));
 	}
 	auto EthercatMotion::setTargetCur(double cur)->void
 	{
 		imp_->target_cur_ = cur;
-		writePdo(0x6071, 0x00, static_cast<std::int16_t>(cur));
+		writePdo(imp_->target_cur_pdo_, static_cast<std::int16_t>(cur));
 	}
 	auto EthercatMotion::setOffsetVel(double vel)->void
 	{
 		imp_->offset_vel_ = vel;
-		writePdo(0x60B1, 0x00, static_cast<std::int32_t>(vel * posFactor()));
+		writePdo(imp_->offset_vel_pdo_, static_cast<std::int32_t>(vel * posFactor()));
 	}
 	auto EthercatMotion::setOffsetCur(double cur)->void
 	{
 		imp_->offset_cur_ = cur;
-		writePdo(0x60B2, 0x00, static_cast<std::int16_t>(cur));
+		writePdo(imp_->offset_cur_pdo_, static_cast<std::int16_t>(cur));
 	}
 	auto EthercatMotion::statusWord()->std::uint16_t
 	{
 		std::uint16_t status_word;
-		readPdo(0x6041, 0x00, status_word);
+		readPdo(imp_->status_word_pdo_, status_word);
 		return status_word;
 	}
 	auto EthercatMotion::modeOfDisplay()->std::uint8_t
 	{
 		std::uint8_t mode;
-		readPdo(0x6061, 0x00, mode);
+		readPdo(imp_->mode_of_display_pdo_, mode);
 		return mode;
 	}
 	auto EthercatMotion::actualPos()->double
 	{
 		std::int32_t pos_count{ 0 };
-		readPdo(0x6064, 0x00, pos_count);
+		readPdo(imp_->actual_pos_pdo_, pos_count);
 		return static_cast<double>(pos_count) / posFactor() - posOffset();
 	}
 	auto EthercatMotion::actualVel()->double
 	{
 		std::int32_t vel_count{ 0 };
-		readPdo(0x606C, 0x00, vel_count);
+		readPdo(imp_->actual_vel_pdo_, vel_count);
 		return static_cast<double>(vel_count) / posFactor();
 	}
 	auto EthercatMotion::actualCur()->double
 	{
 		std::int16_t cur_count{ 0 };
-		readPdo(0x6078, 0x00, cur_count);
+		readPdo(imp_->actual_cur_pdo_, cur_count);
 		return static_cast<double>(cur_count);
 	}
 	auto EthercatMotion::disable()->int
@@ -355,7 +765,7 @@ namespace aris::control
 		// disable change state to A/B/C/E to D
 
 		std::uint16_t status_word;
-		readPdo(0x6041, 0x00, status_word);
+		readPdo(imp_->status_word_pdo_, status_word);
 
 		// check status A
 		if ((status_word & 0x4F) == 0x00)
@@ -366,14 +776,14 @@ namespace aris::control
 		else if ((status_word & 0x4F) == 0x40)
 		{
 			// transition 2 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x06));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x06));
 			return 1;
 		}
 		// check status C, now transition 3
 		else if ((status_word & 0x6F) == 0x21)
 		{
 			// transition 3 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x07));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x07));
 			return 1;
 		}
 		// check status D, now keep and return
@@ -385,26 +795,26 @@ namespace aris::control
 		else if ((status_word & 0x6F) == 0x27)
 		{
 			// transition 5 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x06));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x06));
 			return 1;
 		}
 		// check status F, now transition 12
 		else if ((status_word & 0x6F) == 0x07)
 		{
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x00));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x00));
 			return 1;
 		}
 		// check status G, now transition 14
 		else if ((status_word & 0x4F) == 0x0F)
 		{
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x00));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x00));
 			return 1;
 		}
 		// check status H, now transition 13
 		else if ((status_word & 0x4F) == 0x08)
 		{
 			// transition 4 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x80));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x80));
 			return 1;
 		}
 		// unknown status
@@ -439,7 +849,7 @@ namespace aris::control
 		// 0x4F    0b 0000 0000 0100 1111
 		// enable change state to A/B/C/D/F/G/H to E
 		std::uint16_t status_word;
-		readPdo(0x6041, 0x00, status_word);
+		readPdo(imp_->status_word_pdo_, status_word);
 
 		// check status A
 		if ((status_word & 0x4F) == 0x00)
@@ -450,21 +860,21 @@ namespace aris::control
 		else if ((status_word & 0x4F) == 0x40)
 		{
 			// transition 2 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x06));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x06));
 			return 2;
 		}
 		// check status C, now transition 3
 		else if ((status_word & 0x6F) == 0x21)
 		{
 			// transition 3 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x07));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x07));
 			return 3;
 		}
 		// check status D, now transition 4
 		else if ((status_word & 0x6F) == 0x23)
 		{
 			// transition 4 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x0F));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x0F));
 			imp_->waiting_count_left = 20;
 
 			// check mode to set correct pos, vel or cur //
@@ -489,20 +899,20 @@ namespace aris::control
 		// check status F, now transition 12
 		else if ((status_word & 0x6F) == 0x07)
 		{
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x00));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x00));
 			return 6;
 		}
 		// check status G, now transition 14
 		else if ((status_word & 0x4F) == 0x0F)
 		{
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x00));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x00));
 			return 7;
 		}
 		// check status H, now transition 13
 		else if ((status_word & 0x4F) == 0x08)
 		{
 			// transition 4 //
-			writePdo(0x6040, 0x00, static_cast<std::uint16_t>(0x80));
+			writePdo(imp_->control_word_pdo_, static_cast<std::uint16_t>(0x80));
 			return 8;
 		}
 		// unknown status
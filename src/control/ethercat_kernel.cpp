@@ -11,9 +11,14 @@ extern "C"
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <cmath>
+#include <mutex>
+#include <tuple>
 
 #include "aris/control/ethercat_kernel.hpp"
 #include "aris/control/ethercat.hpp"
+#include "aris/control/rt_timer.hpp"
 
 namespace aris::control
 {
@@ -34,14 +39,14 @@ namespace aris::control
 		// 注意 >>在某些编译器下，是补符号位，因此必须先转换成uint8
 		for (int i = 0; i < bit_size / 8; ++i)
 		{
-			data[i] = (pd[offset + i] >> bit_position) | (std::uint8_t(pd[offset + i + 1]) << (8 - bit_position));
+			data[i] = (std::uint8_t(pd[offset + i]) >> bit_position) | (std::uint8_t(pd[offset + i + 1]) << (8 - bit_position));
 		}
 
 		if (bit_size % 8)
 		{
 			// 先将还没弄好的位置零 //
 			data[bit_size / 8] &= FF << bit_size % 8;
-			data[bit_size / 8] |= (pd[offset + bit_size / 8] >> bit_position) & (0xff >> (8 - bit_size % 8));
+			data[bit_size / 8] |= (std::uint8_t(pd[offset + bit_size / 8]) >> bit_position) & (0xff >> (8 - bit_size % 8));
 			if (bit_size % 8 > 8 - bit_position)
 				data[bit_size / 8] |= (std::uint8_t(pd[offset + bit_size / 8 + 1]) << (8 - bit_position)) & (0xff >> (8 - bit_size % 8));
 
@@ -49,28 +54,21 @@ namespace aris::control
 	}
 	void write_bit2(const char *data, int bit_size, char *pd, int offset, int bit_position)
 	{
+		// 与 read_bit2 互逆，data 和 pd 都是低位在前 //
 		for (int i = 0; i < bit_size / 8; ++i)
 		{
-			pd[offset + i] &= FF << (8 - bit_position);
-			pd[offset + i] |= std::uint8_t(data[i]) >> bit_position;
-			pd[offset + i + 1] &= FF >> bit_position;
-			pd[offset + i + 1] |= std::uint8_t(data[i]) << (8 - bit_position);
+			const unsigned value = std::uint8_t(data[i]);
+			pd[offset + i] = char((std::uint8_t(pd[offset + i]) & ~(0xffu << bit_position)) | (value << bit_position));
+			if (bit_position) pd[offset + i + 1] = char((std::uint8_t(pd[offset + i + 1]) & (0xffu << bit_position)) | (value >> (8 - bit_position)));
 		}
 
 		if (bit_size % 8)
 		{
+			const unsigned mask = 0xffu >> (8 - bit_size % 8);
+			const unsigned value = std::uint8_t(data[bit_size / 8]) & mask;
+			pd[offset + bit_size / 8] = char((std::uint8_t(pd[offset + bit_size / 8]) & ~(mask << bit_position)) | (value << bit_position));
 			if (bit_size % 8 > 8 - bit_position)
-			{
-				pd[offset + bit_size / 8] &= FF << (8 - bit_position);
-				pd[offset + bit_size / 8] |= std::uint8_t(data[bit_size / 8]) >> bit_position;
-				pd[offset + bit_size / 8 + 1] &= FF >> ((bit_size % 8) - (8 - bit_position));
-				pd[offset + bit_size / 8 + 1] |= std::uint8_t(data[bit_size / 8] & (0xff << (8 - bit_size % 8))) << (8 - bit_position);
-			}
-			else
-			{
-				pd[offset + bit_size / 8] &= ~(std::uint8_t(FF >> (8 - bit_position - (bit_size % 8)) << (8 - (bit_size % 8))) >> bit_position);
-				pd[offset + bit_size / 8] |= std::uint8_t((FF << (8 - (bit_size % 8))) & data[bit_size / 8]) >> bit_position;
-			}
+				pd[offset + bit_size / 8 + 1] = char((std::uint8_t(pd[offset + bit_size / 8 + 1]) & ~(mask >> (8 - bit_position))) | (value >> (8 - bit_position)));
 		}
 	}
 
@@ -129,71 +127,56 @@ namespace aris::control
 	}
 
 #ifdef ARIS_USE_ETHERLAB
-	auto aris_ecrt_scan(EthercatMaster *master)->int
+	auto aris_ecrt_scan_slaves(EthercatMaster *master, std::vector<ScannedSlave> *slaves)->int
 	{
+		// 只读查询，无需独占master，因此可与 aris_ecrt_scan_pdo 同时进行 //
 		ec_master_t* ec_master;
-		if (!(ec_master = ecrt_request_master(0))) throw std::runtime_error("master request failed!");
+		if (!(ec_master = ecrt_open_master(0))) throw std::runtime_error("master open failed!");
 
 		ec_master_info_t ec_master_info;
-		if (ecrt_master(ec_master, &ec_master_info)) throw std::runtime_error("master info failed!");
+		if (ecrt_master(ec_master, &ec_master_info)) { ecrt_release_master(ec_master); throw std::runtime_error("master info failed!"); }
 
-		std::vector<ec_slave_info_t> ec_slave_info_vec(ec_master_info.slave_count);
-		std::vector<std::vector<ec_sync_info_t> > ec_sync_info_vec_vec(ec_master_info.slave_count);
-		std::vector<std::vector<std::vector<ec_pdo_info_t> > > ec_pdo_info_vec_vec_vec(ec_master_info.slave_count);
-		std::vector<std::vector<std::vector<std::vector<ec_pdo_entry_info_t> > > > ec_pdo_entry_info_vec_vec_vec_vec(ec_master_info.slave_count);
+		slaves->clear();
 		for (uint16_t sla_pos = 0; sla_pos < ec_master_info.slave_count; ++sla_pos)
 		{
-			if (ecrt_master_get_slave(ec_master, sla_pos, ec_slave_info_vec.data() + sla_pos))throw std::runtime_error("slave info failed!");
-
-			ec_sync_info_vec_vec[sla_pos].resize(ec_slave_info_vec[sla_pos].sync_count);
-			ec_pdo_info_vec_vec_vec[sla_pos].resize(ec_slave_info_vec[sla_pos].sync_count);
-			ec_pdo_entry_info_vec_vec_vec_vec[sla_pos].resize(ec_slave_info_vec[sla_pos].sync_count);
-			for (uint8_t sync_pos = 0; sync_pos < ec_slave_info_vec[sla_pos].sync_count; ++sync_pos)
-			{
-				if (ecrt_master_get_sync_manager(ec_master, sla_pos, sync_pos, ec_sync_info_vec_vec[sla_pos].data() + sync_pos))throw std::runtime_error("sync info failed!");
-
-				ec_pdo_info_vec_vec_vec[sla_pos][sync_pos].resize(ec_sync_info_vec_vec[sla_pos][sync_pos].n_pdos);
-				ec_pdo_entry_info_vec_vec_vec_vec[sla_pos][sync_pos].resize(ec_sync_info_vec_vec[sla_pos][sync_pos].n_pdos);
-				for (unsigned int pdo_pos = 0; pdo_pos < ec_sync_info_vec_vec[sla_pos][sync_pos].n_pdos; ++pdo_pos)
-				{
-					if (ecrt_master_get_pdo(ec_master, sla_pos, sync_pos, pdo_pos, ec_pdo_info_vec_vec_vec[sla_pos][sync_pos].data() + pdo_pos))throw std::runtime_error("pdo info failed!");
-					ec_pdo_entry_info_vec_vec_vec_vec[sla_pos][sync_pos][pdo_pos].resize(ec_pdo_info_vec_vec_vec[sla_pos][sync_pos][pdo_pos].n_entries);
-
-					for (unsigned int entry_pos = 0; entry_pos < ec_pdo_info_vec_vec_vec[sla_pos][sync_pos][pdo_pos].n_entries; ++entry_pos)
-					{
-						if (ecrt_master_get_pdo_entry(ec_master, sla_pos, sync_pos, pdo_pos, entry_pos, ec_pdo_entry_info_vec_vec_vec_vec[sla_pos][sync_pos][pdo_pos].data() + entry_pos))throw std::runtime_error("entry info failed!");
-					}
-				}
-			}
+			ec_slave_info_t info;
+			if (ecrt_master_get_slave(ec_master, sla_pos, &info)) { ecrt_release_master(ec_master); throw std::runtime_error("slave info failed!"); }
+			slaves->push_back(ScannedSlave{ sla_pos, info.name, info.vendor_id, info.product_code, info.revision_number });
 		}
-		// 释放master //
+
 		ecrt_release_master(ec_master);
+		return 0;
+	}
+	auto aris_ecrt_scan_pdo(EthercatMaster *master, std::uint16_t position, EthercatSlave *slave)->int
+	{
+		ec_master_t* ec_master;
+		if (!(ec_master = ecrt_open_master(0))) return -1;
 
-		master->slavePool().clear();
-		for (uint16_t sla_pos = 0; sla_pos < ec_master_info.slave_count; ++sla_pos)
+		ec_slave_info_t ec_slave_info;
+		if (ecrt_master_get_slave(ec_master, position, &ec_slave_info)) { ecrt_release_master(ec_master); return -1; }
+
+		for (uint8_t sync_pos = 0; sync_pos < ec_slave_info.sync_count; ++sync_pos)
 		{
-			auto &info = ec_slave_info_vec[sla_pos];
-			auto &sla = master->slavePool().add<EthercatSlave>(info.name, sla_pos, info.vendor_id, info.product_code, info.revision_number);
+			ec_sync_info_t ec_sync_info;
+			if (ecrt_master_get_sync_manager(ec_master, position, sync_pos, &ec_sync_info)) { ecrt_release_master(ec_master); return -1; }
+			auto &sm = slave->smPool().add<SyncManager>("sm", ec_sync_info.dir == EC_DIR_INPUT);
 
-			for (uint8_t sync_pos = 0; sync_pos < ec_slave_info_vec[sla_pos].sync_count; ++sync_pos)
+			for (unsigned int pdo_pos = 0; pdo_pos < ec_sync_info.n_pdos; ++pdo_pos)
 			{
-				auto &info = ec_sync_info_vec_vec[sla_pos][sync_pos];
-				sla.smPool().add<SyncManager>("sm", info.dir == EC_DIR_INPUT);
-				
-				for (unsigned int pdo_pos = 0; pdo_pos < ec_sync_info_vec_vec[sla_pos][sync_pos].n_pdos; ++pdo_pos)
+				ec_pdo_info_t ec_pdo_info;
+				if (ecrt_master_get_pdo(ec_master, position, sync_pos, pdo_pos, &ec_pdo_info)) { ecrt_release_master(ec_master); return -1; }
+				auto &pdo = sm.add<Pdo>("pdo", ec_pdo_info.index);
+
+				for (unsigned int entry_pos = 0; entry_pos < ec_pdo_info.n_entries; ++entry_pos)
 				{
-					auto &pdo_info = ec_pdo_info_vec_vec_vec[sla_pos][sync_pos][pdo_pos];
-					sla.smPool()[sync_pos].add<Pdo>("pdo", pdo_info.index);
-					
-					for (unsigned int entry_pos = 0; entry_pos < ec_pdo_info_vec_vec_vec[sla_pos][sync_pos][pdo_pos].n_entries; ++entry_pos)
-					{
-						auto &info = ec_pdo_entry_info_vec_vec_vec_vec[sla_pos][sync_pos][pdo_pos][entry_pos];
-						sla.smPool()[sync_pos][pdo_pos].add<PdoEntry>("entry", info.index, info.subindex, info.bit_length);
-					}
+					ec_pdo_entry_info_t info;
+					if (ecrt_master_get_pdo_entry(ec_master, position, sync_pos, pdo_pos, entry_pos, &info)) { ecrt_release_master(ec_master); return -1; }
+					pdo.add<PdoEntry>("entry", info.index, info.subindex, info.bit_length);
 				}
 			}
 		}
 
+		ecrt_release_master(ec_master);
 		return 0;
 	}
 
@@ -267,7 +250,7 @@ namespace aris::control
 			if (ecrt_slave_config_pdos(s_handle.ec_slave_config_, ec_sync_info_vec.size(), ec_sync_info_vec.data()))throw std::runtime_error("failed to slave config pdos");
 
 			// Configure the slave's distributed clock
-			if (slave.dcAssignActivate())ecrt_slave_config_dc(s_handle.ec_slave_config_, slave.dcAssignActivate(), 1000000, 4400000, 0, 0);
+			if (slave.dcAssignActivate())ecrt_slave_config_dc(s_handle.ec_slave_config_, slave.dcAssignActivate(), static_cast<std::uint32_t>(master->samplePeriodNs()), 4400000, 0, 0);
 
 			slave.ecHandle() = s_handle;
 		}
@@ -287,12 +270,16 @@ namespace aris::control
 		ecrt_master_deactivate(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
 		ecrt_release_master(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
 	}
-	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns)->void
+	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns, bool sync_reference_clock)->void
 	{
 		ecrt_master_application_time(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_, ns);
-		ecrt_master_sync_reference_clock(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
+		if (sync_reference_clock)ecrt_master_sync_reference_clock(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
 		ecrt_master_sync_slave_clocks(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
 	}
+	auto aris_ecrt_master_reference_clock_time(EthercatMaster *master, std::uint32_t *time)->int
+	{
+		return ecrt_master_reference_clock_time(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_, time);
+	}
 	auto aris_ecrt_master_recv(EthercatMaster *master)->void
 	{
 		ecrt_master_receive(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
@@ -304,6 +291,12 @@ namespace aris::control
 		ecrt_master_send(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_);
 	}
 
+	auto aris_ecrt_pdo_locate(EthercatMaster *master, PdoEntry *entry, std::uint8_t **data, std::uint8_t *bit_position)->void
+	{
+		auto &pe_handle = std::any_cast<PdoEntryHandle&>(entry->ecHandle());
+		*data = std::any_cast<MasterHandle&>(master->ecHandle()).domain_pd_ + pe_handle.offset;
+		*bit_position = static_cast<std::uint8_t>(pe_handle.bit_position);
+	}
 	auto aris_ecrt_pdo_read(PdoEntry *entry, void *data, int bit_size)->void
 	{
 		auto pd = std::any_cast<MasterHandle&>(entry->ancestor<EthercatMaster>()->ecHandle()).domain_pd_;
@@ -316,7 +309,7 @@ namespace aris::control
 		auto pd = std::any_cast<MasterHandle&>(entry->ancestor<EthercatMaster>()->ecHandle()).domain_pd_;
 		auto &pe_handle = std::any_cast<PdoEntryHandle&>(entry->ecHandle());
 
-		write_bit(reinterpret_cast<const char*>(data), bit_size, reinterpret_cast<char*>(pd), pe_handle.offset, pe_handle.bit_position);
+		write_bit2(reinterpret_cast<const char*>(data), bit_size, reinterpret_cast<char*>(pd), pe_handle.offset, pe_handle.bit_position);
 	}
 
 	auto aris_ecrt_sdo_config(std::any& master, std::any& slave, std::uint16_t index, std::uint8_t subindex,
@@ -325,32 +318,294 @@ namespace aris::control
 		auto &ec_slave_config = std::any_cast<SlaveHandle&>(slave).ec_slave_config_;
 		ecrt_slave_config_sdo(ec_slave_config, index, subindex, buffer, byte_size * 8);
 	}
-	auto aris_ecrt_sdo_read(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+	auto aris_ecrt_sdo_read(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
 		std::uint8_t *to_buffer, std::size_t buffer_size, std::size_t *result_size, std::uint32_t *abort_code)->int
 	{
-		return ecrt_master_sdo_upload(std::any_cast<MasterHandle&>(master).ec_master_, slave_position, index, subindex, to_buffer, buffer_size, result_size, abort_code);
+		return ecrt_master_sdo_upload(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_, slave_position, index, subindex, to_buffer, buffer_size, result_size, abort_code);
 	}
-	auto aris_ecrt_sdo_write(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+	auto aris_ecrt_sdo_write(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
 		std::uint8_t *to_buffer, std::size_t buffer_size, std::uint32_t *abort_code)->int
 	{
-		return ecrt_master_sdo_download(std::any_cast<MasterHandle&>(master).ec_master_, slave_position, index, subindex, to_buffer, buffer_size, abort_code);
+		return ecrt_master_sdo_download(std::any_cast<MasterHandle&>(master->ecHandle()).ec_master_, slave_position, index, subindex, to_buffer, buffer_size, abort_code);
 	}
 #else
-	auto aris_ecrt_scan(EthercatMaster *master)->int { return 0; }
-	auto aris_ecrt_master_request(EthercatMaster *master)->void {}
+	// 没有etherlab时，在内存中按顺序排布所有pdo entry，使pdo读写依然有效 //
+	// 同时把含有 0x6040 与 0x6041 的从站仿真为 CiA402 驱动器，每次 master recv 时根据上周期主站写入的 rx pdo 更新 tx pdo //
+	struct PdoEntryHandle
+	{
+		std::uint32_t offset;
+		std::uint32_t bit_position;
+	};
+	struct SimulatedEntry
+	{
+		std::uint32_t offset{ 0 };
+		std::uint32_t bit_position{ 0 };
+		int bit_size{ 0 };
+	};
+	struct SimulatedDrive
+	{
+		// rx pdo //
+		SimulatedEntry control_word, mode_of_operation, target_pos, target_vel, target_cur, offset_vel, offset_cur;
+		// tx pdo //
+		SimulatedEntry status_word, mode_of_display, actual_pos, actual_vel, actual_cur;
+
+		std::uint16_t status_word_{ 0x40 };
+		double pos_{ 0.0 };
+		aris::Size home_count_left_{ 0 };
+		bool is_homing_{ false };
+	};
+	// 仿真的对象字典，写入的SDO可以再读出，可被多个非实时线程同时访问 //
+	struct SimulatedObjectDictionary
+	{
+		std::mutex mu_;
+		std::map<std::tuple<std::uint16_t, std::uint16_t, std::uint8_t>, std::vector<std::uint8_t>> objects_;
+	};
+	struct MasterHandle
+	{
+		std::vector<std::uint8_t> domain_pd_;
+		std::vector<SimulatedDrive> drives_;
+		std::shared_ptr<SimulatedObjectDictionary> sdo_{ std::make_shared<SimulatedObjectDictionary>() };
+
+		// 仿真的参考时钟，按主站实际经过的时间乘以漂移前进 //
+		bool is_reference_clock_set_{ false };
+		double reference_clock_time_{ 0.0 }, latched_reference_clock_time_{ 0.0 };
+		std::int64_t last_master_time_{ 0 };
+	};
+
+	// SDO 工作线程与实时线程都可能建立 MasterHandle //
+	auto master_handle_mutex()->std::mutex& { static std::mutex mu; return mu; }
+
+	// 按 entry 的位数读写有符号整数，entry 不存在时读出 0，写入被忽略 //
+	auto simulated_read(const std::vector<std::uint8_t> &pd, const SimulatedEntry &entry)->std::int64_t
+	{
+		if (entry.bit_size == 0) return 0;
+		std::uint64_t value{ 0 };
+		read_bit2(reinterpret_cast<char*>(&value), entry.bit_size, reinterpret_cast<const char*>(pd.data()), entry.offset, entry.bit_position);
+		if (entry.bit_size < 64 && ((value >> (entry.bit_size - 1)) & 0x01)) value |= ~std::uint64_t(0) << entry.bit_size;
+		return static_cast<std::int64_t>(value);
+	}
+	auto simulated_write(std::vector<std::uint8_t> &pd, const SimulatedEntry &entry, std::int64_t value)->void
+	{
+		if (entry.bit_size == 0) return;
+		write_bit2(reinterpret_cast<const char*>(&value), entry.bit_size, reinterpret_cast<char*>(pd.data()), entry.offset, entry.bit_position);
+	}
+
+	// 没有etherlab时，从 EthercatMaster::simulationBus() 中读取总线上的从站，每读一个pdo需要 simulationSdoLatency() //
+	auto aris_ecrt_scan_slaves(EthercatMaster *master, std::vector<ScannedSlave> *slaves)->int
+	{
+		slaves->clear();
+		for (auto &bus_sla : master->simulationBus())
+		{
+			auto &sla = dynamic_cast<EthercatSlave&>(bus_sla);
+			slaves->push_back(ScannedSlave{ static_cast<std::uint16_t>(slaves->size()), sla.name(), sla.vendorID(), sla.productCode(), sla.revisionNum() });
+		}
+		return 0;
+	}
+	auto aris_ecrt_scan_pdo(EthercatMaster *master, std::uint16_t position, EthercatSlave *slave)->int
+	{
+		if (position >= master->simulationBus().size()) return -1;
+
+		for (auto &bus_sm : dynamic_cast<EthercatSlave&>(master->simulationBus()[position]).smPool())
+		{
+			auto &sm = slave->smPool().add<SyncManager>(bus_sm.name(), bus_sm.tx());
+			for (auto &bus_pdo : bus_sm)
+			{
+				std::this_thread::sleep_for(master->simulationSdoLatency());
+				auto &pdo = sm.add<Pdo>(bus_pdo.name(), bus_pdo.index());
+				for (auto &entry : bus_pdo) pdo.add<PdoEntry>(entry.name(), entry.index(), entry.subindex(), entry.bitSize());
+			}
+		}
+		return 0;
+	}
+	auto aris_ecrt_master_request(EthercatMaster *master)->void 
+	{
+		MasterHandle m_handle;
+		std::uint32_t bit_pos{ 0 };
+		for (auto &slave : master->ecSlavePool())
+		{
+			std::map<std::uint16_t, SimulatedEntry> entries;
+			for (auto &sm : slave.smPool())
+			{
+				for (auto &pdo : sm)
+				{
+					for (auto &entry : pdo)
+					{
+						entry.ecHandle() = PdoEntryHandle{ bit_pos / 8, bit_pos % 8 };
+						if (entry.index())
+						{
+							if (entry.subindex() == 0x00) entries[entry.index()] = SimulatedEntry{ bit_pos / 8, bit_pos % 8, static_cast<int>(entry.bitSize()) };
+							bit_pos += static_cast<std::uint32_t>(entry.bitSize());
+						}
+					}
+				}
+			}
+
+			if (entries.count(0x6040) && entries.count(0x6041))
+			{
+				SimulatedDrive drive;
+				drive.control_word = entries[0x6040];
+				drive.mode_of_operation = entries[0x6060];
+				drive.target_pos = entries[0x607A];
+				drive.target_vel = entries[0x60FF];
+				drive.target_cur = entries[0x6071];
+				drive.offset_vel = entries[0x60B1];
+				drive.offset_cur = entries[0x60B2];
+				drive.status_word = entries[0x6041];
+				drive.mode_of_display = entries[0x6061];
+				drive.actual_pos = entries[0x6064];
+				drive.actual_vel = entries[0x606C];
+				drive.actual_cur = entries[0x6078];
+				m_handle.drives_.push_back(drive);
+			}
+		}
+
+		// 多留一个字节，按位读写时可能访问到最后一个entry的下一个字节 //
+		m_handle.domain_pd_.resize(bit_pos / 8 + 2, 0);
+		for (auto &drive : m_handle.drives_) simulated_write(m_handle.domain_pd_, drive.status_word, drive.status_word_);
+
+		// 保留此前写入的SDO //
+		std::lock_guard<std::mutex> lck(master_handle_mutex());
+		if (master->ecHandle().has_value()) m_handle.sdo_ = std::any_cast<MasterHandle&>(master->ecHandle()).sdo_;
+		master->ecHandle() = std::move(m_handle);
+	}
 	auto aris_ecrt_master_stop(EthercatMaster *master)->void {}
-	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns)->void {}
-	auto aris_ecrt_master_recv(EthercatMaster *master)->void {}
+	auto aris_ecrt_master_sync(EthercatMaster *master, std::uint64_t ns, bool sync_reference_clock)->void 
+	{
+		auto &m_handle = std::any_cast<MasterHandle&>(master->ecHandle());
+
+		// 主站经过的时间取实时时钟上计划的周期起点之差，包含对唤醒时刻的修正 //
+		const auto master_time = aris_rt_task_period_time();
+		if (!m_handle.is_reference_clock_set_) m_handle.reference_clock_time_ = static_cast<double>(ns);
+		else m_handle.reference_clock_time_ += (master_time - m_handle.last_master_time_) * (1.0 + master->simulationClockDriftPpm() * 1e-6);
+		m_handle.last_master_time_ = master_time;
+
+		// 同步报文读到的是改写之前的参考时钟 //
+		m_handle.latched_reference_clock_time_ = m_handle.reference_clock_time_;
+		if (sync_reference_clock) m_handle.reference_clock_time_ = static_cast<double>(ns);
+		m_handle.is_reference_clock_set_ = true;
+	}
+	auto aris_ecrt_master_reference_clock_time(EthercatMaster *master, std::uint32_t *time)->int
+	{
+		auto &m_handle = std::any_cast<MasterHandle&>(master->ecHandle());
+		if (!m_handle.is_reference_clock_set_) return -1;
+		*time = static_cast<std::uint32_t>(std::llround(m_handle.latched_reference_clock_time_));
+		return 0;
+	}
+	auto aris_ecrt_master_recv(EthercatMaster *master)->void 
+	{
+		auto &m_handle = std::any_cast<MasterHandle&>(master->ecHandle());
+		auto &pd = m_handle.domain_pd_;
+		const double dt = master->samplePeriodNs() * 1e-9;
+		const double ratio = master->simulationFollowingRatio();
+
+		for (auto &d : m_handle.drives_)
+		{
+			const auto cw = static_cast<std::uint16_t>(simulated_read(pd, d.control_word));
+			const auto mode = d.mode_of_operation.bit_size ? static_cast<std::uint8_t>(simulated_read(pd, d.mode_of_operation)) : std::uint8_t(8);
+			d.status_word_ = cia402NextStatus(d.status_word_, cw);
+
+			// 驱动器响应，未使能时保持不动 //
+			const double last_pos = d.pos_;
+			double cur{ 0.0 };
+			std::uint16_t home_bits{ 0 };
+			if (d.status_word_ == 0x27)
+			{
+				switch (mode)
+				{
+				case 6:
+					// 控制字第4位的上升沿开始回零，经过若干周期后回到零点，并置位 homing attained 与 target reached //
+					if (cw & 0x10)
+					{
+						if (!d.is_homing_)
+						{
+							d.is_homing_ = true;
+							d.home_count_left_ = master->simulationHomeCount();
+						}
+
+						if (d.home_count_left_ > 0)
+						{
+							--d.home_count_left_;
+						}
+						else
+						{
+							d.pos_ = 0.0;
+							home_bits = 0x1400;
+						}
+					}
+					else d.is_homing_ = false;
+					break;
+				case 8: d.pos_ += ratio * (simulated_read(pd, d.target_pos) - d.pos_); break;
+				case 9: d.pos_ += (simulated_read(pd, d.target_vel) + simulated_read(pd, d.offset_vel)) * dt; break;
+				case 10: cur = static_cast<double>(simulated_read(pd, d.target_cur) + simulated_read(pd, d.offset_cur)); break;
+				default:break;
+				}
+			}
+			else d.is_homing_ = false;
+
+			simulated_write(pd, d.status_word, d.status_word_ | home_bits);
+			simulated_write(pd, d.mode_of_display, mode);
+			simulated_write(pd, d.actual_pos, std::llround(d.pos_));
+			simulated_write(pd, d.actual_vel, std::llround((d.pos_ - last_pos) / dt));
+			simulated_write(pd, d.actual_cur, std::llround(cur));
+		}
+	}
 	auto aris_ecrt_master_send(EthercatMaster *master)->void {}
 
-	auto aris_ecrt_pdo_read(PdoEntry *entry, void *data, int byte_size)->void {}
-	auto aris_ecrt_pdo_write(PdoEntry *entry, const void *data, int byte_size)->void {}
-	auto aris_ecrt_sdo_read(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
-		std::uint8_t *to_buffer, std::size_t buffer_size, std::size_t *result_size, std::uint32_t *abort_code) ->int {
+	auto aris_ecrt_pdo_locate(EthercatMaster *master, PdoEntry *entry, std::uint8_t **data, std::uint8_t *bit_position)->void
+	{
+		auto &pe_handle = std::any_cast<PdoEntryHandle&>(entry->ecHandle());
+		*data = std::any_cast<MasterHandle&>(master->ecHandle()).domain_pd_.data() + pe_handle.offset;
+		*bit_position = static_cast<std::uint8_t>(pe_handle.bit_position);
+	}
+	auto aris_ecrt_pdo_read(PdoEntry *entry, void *data, int bit_size)->void 
+	{
+		auto pd = std::any_cast<MasterHandle&>(entry->ancestor<EthercatMaster>()->ecHandle()).domain_pd_.data();
+		auto &pe_handle = std::any_cast<PdoEntryHandle&>(entry->ecHandle());
+
+		read_bit2(reinterpret_cast<char*>(data), bit_size, reinterpret_cast<const char*>(pd), pe_handle.offset, pe_handle.bit_position);
+	}
+	auto aris_ecrt_pdo_write(PdoEntry *entry, const void *data, int bit_size)->void 
+	{
+		auto pd = std::any_cast<MasterHandle&>(entry->ancestor<EthercatMaster>()->ecHandle()).domain_pd_.data();
+		auto &pe_handle = std::any_cast<PdoEntryHandle&>(entry->ecHandle());
+
+		write_bit2(reinterpret_cast<const char*>(data), bit_size, reinterpret_cast<char*>(pd), pe_handle.offset, pe_handle.bit_position);
+	}
+	auto simulated_object_dictionary(EthercatMaster *master)->std::shared_ptr<SimulatedObjectDictionary>
+	{
+		// 主站启动前也可以读写SDO，此时先建立一个空的过程数据 //
+		std::lock_guard<std::mutex> lck(master_handle_mutex());
+		if (!master->ecHandle().has_value()) master->ecHandle() = MasterHandle();
+		return std::any_cast<MasterHandle&>(master->ecHandle()).sdo_;
+	}
+	auto aris_ecrt_sdo_read(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+		std::uint8_t *to_buffer, std::size_t buffer_size, std::size_t *result_size, std::uint32_t *abort_code) ->int 
+	{
+		auto od = simulated_object_dictionary(master);
+		std::this_thread::sleep_for(master->simulationSdoLatency());
+
+		std::lock_guard<std::mutex> lck(od->mu_);
+		auto found = od->objects_.find(std::make_tuple(slave_position, index, subindex));
+		if (found == od->objects_.end())
+		{
+			// object does not exist in the object dictionary //
+			*abort_code = 0x06020000;
+			return -1;
+		}
+		*result_size = std::min(buffer_size, found->second.size());
+		std::copy_n(found->second.begin(), *result_size, to_buffer);
+		*abort_code = 0;
 		return 0;
 	}
-	auto aris_ecrt_sdo_write(std::any& master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
-		std::uint8_t *to_buffer, std::size_t buffer_size, std::uint32_t *abort_code) ->int {
+	auto aris_ecrt_sdo_write(EthercatMaster *master, std::uint16_t slave_position, std::uint16_t index, std::uint8_t subindex,
+		std::uint8_t *to_buffer, std::size_t buffer_size, std::uint32_t *abort_code) ->int 
+	{
+		auto od = simulated_object_dictionary(master);
+		std::this_thread::sleep_for(master->simulationSdoLatency());
+
+		std::lock_guard<std::mutex> lck(od->mu_);
+		od->objects_[std::make_tuple(slave_position, index, subindex)].assign(to_buffer, to_buffer + buffer_size);
+		*abort_code = 0;
 		return 0;
 	}
 	auto aris_ecrt_sdo_config(std::any& master, std::any& slave, std::uint16_t index, std::uint8_t subindex,
@@ -6,6 +6,9 @@
 #include <mutex>
 #include <thread>
 #include <future>
+#include <array>
+#include <atomic>
+#include <cmath>
 
 #include "aris/control/rt_timer.hpp"
 #include "aris/control/master_slave.hpp"
@@ -33,11 +36,25 @@ namespace aris::control
 	struct Master::Imp
 	{
 	public:
-		enum { LOG_NEW_FILE = 1 };
+		enum { LOG_NEW_FILE = 1, LOG_RECORD = 2 };
+		static auto write_msg(const aris::core::MsgHeader &header, const char *data, std::ostream &os)->void
+		{
+			if (header.msg_id_ == LOG_RECORD)
+			{
+				auto formatter = reinterpret_cast<RecordFormatter>(header.reserved1_);
+				auto format = reinterpret_cast<const char *>(header.reserved2_);
+				formatter(os, format, data);
+			}
+			else
+			{
+				os.write(data, header.msg_size_);
+			}
+		}
 		static auto rt_task_func(void *master)->void
 		{
 			auto &mst = *reinterpret_cast<Master*>(master);
-			auto add_time_to_stastics = [](std::int64_t time, RtStasticsData *data) 
+			const std::int64_t overrun_threshold = mst.imp_->sample_period_ns_ * 9 / 10;
+			auto add_time_to_stastics = [overrun_threshold](std::int64_t time, RtStasticsData *data) 
 			{
 				data->avg_time_consumed += (double(time) - data->avg_time_consumed) / (data->total_count + 1);
 				data->max_time_occur_count = time < data->max_time_consumed ? data->max_time_occur_count : data->total_count;
@@ -45,54 +62,59 @@ namespace aris::control
 				data->min_time_occur_count = time > data->min_time_consumed ? data->min_time_occur_count : data->total_count;
 				data->min_time_consumed = std::min(time, data->min_time_consumed);
 				data->total_count++;
-				data->overrun_count += time > 900000 ? 1 : 0;
+				data->overrun_count += time > overrun_threshold ? 1 : 0;
 			};
 
-			aris_rt_task_set_periodic(mst.imp_->sample_period_ns_);
+			auto add_time_to_histogram = [](std::int64_t time, PhaseHistogramData *data)
+			{
+				// 只有实时线程写入，因此无需原子的读-改-写 //
+				auto &bucket = data->count[RtPhaseHistogram::bucketIndex(time)];
+				bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				if (time > data->max_time.load(std::memory_order_relaxed))data->max_time.store(time, std::memory_order_relaxed);
+				data->total_count.store(data->total_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			};
+			auto &histograms = mst.imp_->phase_histograms_;
 
-			///////////////////////////////////////////////////////////////
-			//std::int64_t time_series[10];
-			///////////////////////////////////////////////////////////////
+			aris_rt_task_set_periodic(static_cast<int>(mst.imp_->sample_period_ns_));
+			const bool is_virtual_time = mst.imp_->is_virtual_time_;
 
 			while (mst.imp_->is_rt_thread_running_)
 			{
-				///////////////////////////////////////////////////////////////
-				//time_series[1] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
+				// 虚拟时间下等待 step()，每个周期从开始运行时计时 //
+				if (is_virtual_time)
+				{
+					mst.imp_->step_notifier_.wait([&]() { return !mst.imp_->is_rt_thread_running_ || mst.imp_->cycle_count_.load() < mst.imp_->step_target_.load(); });
+					if (!mst.imp_->is_rt_thread_running_)break;
+					aris_rt_task_restart_period();
+				}
+
+				auto last_time = aris_rt_time_since_last_time();
+				auto record_phase = [&](RtPhase phase)
+				{
+					auto now = aris_rt_time_since_last_time();
+					add_time_to_histogram(now - last_time, &histograms[phase]);
+					last_time = now;
+				};
 
 				// receive //
 				mst.recv();
-
-				///////////////////////////////////////////////////////////////
-				//time_series[2] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
-
+				record_phase(RT_RECV);
 
 				// tragectory generator //
 				if (mst.imp_->strategy_)mst.imp_->strategy_();
-
-				///////////////////////////////////////////////////////////////
-				//time_series[3] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
-
+				for (auto &task : mst.imp_->sub_rate_tasks_)
+				{
+					if (mst.imp_->cycle_count_ % task.divisor_ == task.phase_) task.task_();
+				}
+				record_phase(RT_STRATEGY);
 
 				// sync
 				mst.sync();
-
-				///////////////////////////////////////////////////////////////
-				//time_series[4] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
-
-
+				record_phase(RT_SYNC);
 
 				// send
 				mst.send();
-
-
-				///////////////////////////////////////////////////////////////
-				//time_series[5] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
-
+				record_phase(RT_SEND);
 
 				// flush lout
 				mst.lout() << std::flush;
@@ -109,56 +131,45 @@ namespace aris::control
 					mst.imp_->mout_pipe_->sendMsg(mst.imp_->mout_msg_);
 					mst.mout().reset();
 				}
-
-				///////////////////////////////////////////////////////////////
-				//time_series[6] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
-
+				record_phase(RT_FLUSH_LOG);
 
 				// record stastics //
 				auto time = aris_rt_time_since_last_time();
+				add_time_to_histogram(time, &histograms[RT_TOTAL]);
 				add_time_to_stastics(time, &mst.imp_->global_stastics_);
-				if(mst.imp_->this_stastics_)add_time_to_stastics(time, mst.imp_->this_stastics_);
-				if (mst.imp_->is_need_change_)
+				for (aris::Size i = 0; i < MAX_STASTICS_SLOT; ++i)
 				{
-					if (mst.imp_->is_this_ready_)mst.imp_->is_this_ready_->store(true);
-					mst.imp_->this_stastics_ = mst.imp_->next_stastics_;
-					mst.imp_->is_this_ready_ = mst.imp_->is_next_ready_;
+					if (mst.imp_->this_stastics_[i])add_time_to_stastics(time, mst.imp_->this_stastics_[i]);
+					if (mst.imp_->is_need_change_[i])
+					{
+						if (mst.imp_->is_this_ready_[i])mst.imp_->is_this_ready_[i]->store(true);
+						mst.imp_->this_stastics_[i] = mst.imp_->next_stastics_[i];
+						mst.imp_->is_this_ready_[i] = mst.imp_->is_next_ready_[i];
+					}
 				}
 
-				///////////////////////////////////////////////////////////////
-				/*time_series[7] = aris_rt_time_since_last_time();
-				
-				if (time_series[7] > 500000)
+				// rt timer //
+				if (!is_virtual_time)
 				{
-					mst.mout() << "0: " << time_series[0]
-						<< "\n1: " << time_series[1]
-						<< "\n2: " << time_series[2]
-						<< "\n3: " << time_series[3]
-						<< "\n4: " << time_series[4]
-						<< "\n5: " << time_series[5]
-						<< "\n6: " << time_series[6]
-						<< "\n7: " << time_series[7] << "\n-----------------------------------------------" << std::endl;
+					aris_rt_task_wait_period();
+					add_time_to_histogram(aris_rt_time_since_last_time(), &histograms[RT_WAIT_JITTER]);
 				}
-				
-				
-				*/
-				///////////////////////////////////////////////////////////////
-
-
-
-
-				// rt timer //
-				aris_rt_task_wait_period();
-
-				///////////////////////////////////////////////////////////////
-				//time_series[0] = aris_rt_time_since_last_time();
-				///////////////////////////////////////////////////////////////
+				++mst.imp_->cycle_count_;
+				if (is_virtual_time)mst.imp_->step_done_notifier_.notify();
 			}
 
 			mst.imp_->is_mout_thread_running_ = false;
 		}
 
+		// phase histograms, written only by rt thread //
+		struct PhaseHistogramData
+		{
+			std::atomic<std::int64_t> count[RtPhaseHistogram::BUCKET_SIZE];
+			std::atomic<std::int64_t> total_count;
+			std::atomic<std::int64_t> max_time;
+		};
+		std::array<PhaseHistogramData, RT_PHASE_SIZE> phase_histograms_;
+
 		// slave //
 		aris::core::ObjectPool<Slave> *slave_pool_;
 		std::vector<Size> sla_vec_phy2abs_;
@@ -171,19 +182,31 @@ namespace aris::control
 
 		// strategy //
 		std::function<void()> strategy_{ nullptr };
+		struct SubRateTask
+		{
+			std::function<void()> task_;
+			aris::Size divisor_, phase_;
+		};
+		std::vector<SubRateTask> sub_rate_tasks_;
+		std::atomic<aris::Size> cycle_count_{ 0 };
+
+		// virtual time //
+		bool is_virtual_time_{ false };
+		std::atomic<aris::Size> step_target_{ 0 };
+		aris::core::Notifier step_notifier_, step_done_notifier_;
 
 		// running flag //
 		std::mutex mu_running_;
 		std::atomic_bool is_rt_thread_running_{ false };
 		std::atomic_bool is_mout_thread_running_{ false };
 
-		const int sample_period_ns_{ 1000000 };
+		std::int64_t sample_period_ns_{ 1000000 };
 
 		// rt stastics //
 		Master::RtStasticsData global_stastics_{ 0,0,0,0x8fffffff,0,0,0 };
-		Master::RtStasticsData* this_stastics_{ nullptr }, *next_stastics_{ nullptr };
-		std::atomic_bool* is_this_ready_{ nullptr }, *is_next_ready_{ nullptr };
-		bool is_need_change_{ false };
+		Master::RtStasticsData* this_stastics_[MAX_STASTICS_SLOT]{}, *next_stastics_[MAX_STASTICS_SLOT]{};
+		std::atomic_bool* is_this_ready_[MAX_STASTICS_SLOT]{}, *is_next_ready_[MAX_STASTICS_SLOT]{};
+		bool is_need_change_[MAX_STASTICS_SLOT]{};
 
 		std::any rt_task_handle_;
 
@@ -192,9 +215,15 @@ namespace aris::control
 		friend class Slave;
 		friend class Master;
 	};
+	auto Master::saveXml(aris::core::XmlElement &xml_ele) const->void
+	{
+		Object::saveXml(xml_ele);
+		xml_ele.SetAttribute("sample_period_ns", samplePeriodNs());
+	}
 	auto Master::loadXml(const aris::core::XmlElement &xml_ele)->void
 	{
 		Object::loadXml(xml_ele);
+		setSamplePeriodNs(attributeInt64(xml_ele, "sample_period_ns", 1000000));
 
 		imp_->slave_pool_ = findByName("slave_pool") == children().end() ? &add<aris::core::ObjectPool<Slave, Object> >("slave_pool") : static_cast<aris::core::ObjectPool<Slave, Object> *>(&(*findByName("slave_pool")));
 		imp_->mout_pipe_ = findOrInsert<aris::core::Pipe>("mout_pipe");
@@ -218,6 +247,17 @@ namespace aris::control
 		// init child master //
 		init();
 
+		imp_->cycle_count_ = 0;
+		imp_->step_target_ = 0;
+
+		// clear phase histograms //
+		for (auto &h : imp_->phase_histograms_)
+		{
+			for (auto &c : h.count)c.store(0);
+			h.total_count.store(0);
+			h.max_time.store(0);
+		}
+
 		// lock memory // 
 		aris_mlockall();
 
@@ -230,46 +270,34 @@ namespace aris::control
 			std::fstream file;
 			file.open(file_name.string() + "0.txt", std::ios::out | std::ios::trunc);
 
-			// start read mout and lout //
-			aris::core::Msg msg;
-			while (imp_->is_mout_thread_running_)
+			// start read mout and lout, 每次原地处理pipe中的所有消息 //
+			auto write_lout = [&](const aris::core::MsgHeader &header, const char *data)
 			{
-				if (imp_->lout_pipe_->recvMsg(msg))
-				{
-					if (msg.msgID() == Imp::LOG_NEW_FILE)
-					{
-						file.close();
-						file.open(file_name.string() + msg.toString() + ".txt", std::ios::out | std::ios::trunc);
-					}
-					else if (!msg.empty())
-					{
-						file << msg.toString();
-					}
-				}
-				else if (imp_->mout_pipe_->recvMsg(msg))
+				if (header.msg_id_ == Imp::LOG_NEW_FILE)
 				{
-					if (!msg.empty())std::cout << msg.toString() << std::flush;
+					file.close();
+					file.open(file_name.string() + std::string(data, header.msg_size_) + ".txt", std::ios::out | std::ios::trunc);
 				}
 				else
 				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					Imp::write_msg(header, data, file);
 				}
-			}
+			};
+			auto write_mout = [&](const aris::core::MsgHeader &header, const char *data) { Imp::write_msg(header, data, std::cout); };
 
-			// 结束前最后一次接收，此时实时线程已经结束 //
-			while (imp_->mout_pipe_->recvMsg(msg)) if (!msg.empty())std::cout << msg.toString() << std::endl;
-			while (imp_->lout_pipe_->recvMsg(msg))
+			while (imp_->is_mout_thread_running_)
 			{
-				if (msg.msgID() == Imp::LOG_NEW_FILE)
-				{
-					file.close();
-					file.open(file_name.string() + msg.toString() + ".txt", std::ios::out | std::ios::trunc);
-				}
-				else if (!msg.empty())
-				{
-					file << msg.toString();
-				}
+				auto lout_num = imp_->lout_pipe_->drainMsg(write_lout);
+				auto mout_num = imp_->mout_pipe_->drainMsg(write_mout);
+
+				if (mout_num) std::cout << std::flush;
+				if (lout_num + mout_num == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
 			}
+
+			// 结束前最后一次接收，此时实时线程已经结束 //
+			imp_->mout_pipe_->drainMsg(write_mout);
+			std::cout << std::flush;
+			imp_->lout_pipe_->drainMsg(write_lout);
 		});
 
 		// create and start rt task //
@@ -282,6 +310,7 @@ namespace aris::control
 		std::unique_lock<std::mutex> running_lck(imp_->mu_running_);
 		if (!imp_->is_rt_thread_running_)throw std::runtime_error("master is not running, so can't stop");
 		imp_->is_rt_thread_running_ = false;
+		imp_->step_notifier_.notify();
 
 		// join rt task //
 		if (aris_rt_task_join(rtHandle()))throw std::runtime_error("aris_rt_task_join failed");
@@ -298,6 +327,45 @@ namespace aris::control
 		if (imp_->is_rt_thread_running_)throw std::runtime_error("master already running, cannot set control strategy");
 		imp_->strategy_ = strategy;
 	}
+	auto Master::samplePeriodNs()const->std::int64_t { return imp_->sample_period_ns_; }
+	auto Master::setSamplePeriodNs(std::int64_t period_ns)->void
+	{
+		std::unique_lock<std::mutex> running_lck(imp_->mu_running_);
+		if (imp_->is_rt_thread_running_)throw std::runtime_error("master already running, cannot set sample period");
+		if (period_ns <= 0)throw std::runtime_error("invalid sample period:" + std::to_string(period_ns));
+		imp_->sample_period_ns_ = period_ns;
+	}
+	auto Master::addSubRateTask(std::function<void()> task, aris::Size divisor, aris::Size phase)->void
+	{
+		std::unique_lock<std::mutex> running_lck(imp_->mu_running_);
+		if (imp_->is_rt_thread_running_)throw std::runtime_error("master already running, cannot add sub rate task");
+		if (divisor == 0 || phase >= divisor)throw std::runtime_error("invalid sub rate task, divisor:" + std::to_string(divisor) + " phase:" + std::to_string(phase));
+		imp_->sub_rate_tasks_.push_back(Imp::SubRateTask{ task, divisor, phase });
+	}
+	auto Master::clearSubRateTasks()->void
+	{
+		std::unique_lock<std::mutex> running_lck(imp_->mu_running_);
+		if (imp_->is_rt_thread_running_)throw std::runtime_error("master already running, cannot clear sub rate tasks");
+		imp_->sub_rate_tasks_.clear();
+	}
+	auto Master::isVirtualTime()const->bool { return imp_->is_virtual_time_; }
+	auto Master::setVirtualTime(bool is_virtual_time)->void
+	{
+		std::unique_lock<std::mutex> running_lck(imp_->mu_running_);
+		if (imp_->is_rt_thread_running_)throw std::runtime_error("master already running, cannot set virtual time");
+		imp_->is_virtual_time_ = is_virtual_time;
+	}
+	auto Master::step(aris::Size count)->aris::Size
+	{
+		if (!imp_->is_virtual_time_)throw std::runtime_error("master is not in virtual time, so can't step");
+		if (!imp_->is_rt_thread_running_)throw std::runtime_error("master is not running, so can't step");
+
+		auto target = imp_->step_target_.fetch_add(count) + count;
+		imp_->step_notifier_.notify();
+		imp_->step_done_notifier_.wait([&]() { return imp_->cycle_count_.load() >= target || !imp_->is_rt_thread_running_; });
+		return imp_->cycle_count_.load();
+	}
+	auto Master::cycleCount()const->aris::Size { return imp_->cycle_count_.load(); }
 	auto Master::rtHandle()->std::any& { return imp_->rt_task_handle_; }
 	auto Master::logFile(const char *file_name)->void
 	{
@@ -319,27 +387,78 @@ namespace aris::control
 		imp_->lout_msg_.setMsgID(0);
 		imp_->lout_msg_.resize(0);
 	}
+	auto Master::reserveRecord(bool is_lout, RecordFormatter formatter, const char *format, aris::Size size)->char*
+	{
+		auto header = (is_lout ? imp_->lout_pipe_ : imp_->mout_pipe_)->reserveMsg(static_cast<aris::core::MsgSize>(size));
+		if (!header) return nullptr;
+		
+		header->msg_id_ = Imp::LOG_RECORD;
+		header->reserved1_ = reinterpret_cast<std::int64_t>(formatter);
+		header->reserved2_ = reinterpret_cast<std::int64_t>(format);
+		return reinterpret_cast<char*>(header) + sizeof(aris::core::MsgHeader);
+	}
+	auto Master::commitRecord(bool is_lout)->void { (is_lout ? imp_->lout_pipe_ : imp_->mout_pipe_)->commitMsg(); }
 	auto Master::lout()->aris::core::MsgStream & { return *imp_->lout_msg_stream_; }
 	auto Master::mout()->aris::core::MsgStream & { return *imp_->mout_msg_stream_; }
 	auto Master::slaveAtPhy(aris::Size id)->Slave& { return slavePool().at(imp_->sla_vec_phy2abs_.at(id)); }
 	auto Master::slavePool()->aris::core::ObjectPool<Slave, aris::core::Object>& { return *imp_->slave_pool_; }
-	auto Master::resetRtStasticData(RtStasticsData *stastics, bool is_new_data_include_this_count)->void
+	auto Master::resetRtStasticData(RtStasticsData *stastics, bool is_new_data_include_this_count, aris::Size slot)->void
 	{
 		if (stastics)*stastics = RtStasticsData{ 0,0,0,0x8fffffff,0,0,0 };
 		
 		if (is_new_data_include_this_count)
 		{
 			// make new stastics //
-			imp_->this_stastics_ = stastics;
-			imp_->is_need_change_ = !is_new_data_include_this_count;
+			imp_->this_stastics_[slot] = stastics;
+			imp_->is_need_change_[slot] = !is_new_data_include_this_count;
 		}
 		else
 		{
 			// mark need to change when this count finished //
-			imp_->next_stastics_ = stastics;
-			imp_->is_need_change_ = !is_new_data_include_this_count;
+			imp_->next_stastics_[slot] = stastics;
+			imp_->is_need_change_[slot] = !is_new_data_include_this_count;
 		}
 	}
+	auto Master::RtPhaseHistogram::bucketIndex(std::int64_t ns)->aris::Size
+	{
+		// 小于32ns时每ns一个桶，此后每个2的幂区间 [2^e, 2^(e+1)) 均分为16个桶 //
+		const std::int64_t sub_count = 1 << SUB_BUCKET_BITS;
+		if (ns < 2 * sub_count) return static_cast<aris::Size>(std::max(ns, std::int64_t(0)));
+
+		int e = 0;
+		for (auto v = ns; v > 1; v >>= 1) ++e;
+		auto bucket = static_cast<aris::Size>((e - SUB_BUCKET_BITS) * sub_count + (ns >> (e - SUB_BUCKET_BITS)));
+		return std::min(bucket, static_cast<aris::Size>(BUCKET_SIZE - 1));
+	}
+	auto Master::RtPhaseHistogram::bucketLowerBound(aris::Size bucket)->std::int64_t
+	{
+		const aris::Size sub_count = 1 << SUB_BUCKET_BITS;
+		if (bucket < 2 * sub_count) return static_cast<std::int64_t>(bucket);
+
+		auto e = bucket / sub_count + SUB_BUCKET_BITS - 1;
+		auto m = bucket % sub_count + sub_count;
+		return static_cast<std::int64_t>(m) << (e - SUB_BUCKET_BITS);
+	}
+	auto Master::RtPhaseHistogram::percentile(double percentile)const->std::int64_t
+	{
+		if (total_count == 0) return 0;
+
+		auto target = static_cast<std::int64_t>(std::ceil(percentile * total_count));
+		std::int64_t accumulated{ 0 };
+		for (aris::Size i = 0; i < BUCKET_SIZE - 1; ++i)
+		{
+			accumulated += count[i];
+			if (accumulated >= std::max(target, std::int64_t(1))) return std::min(bucketLowerBound(i + 1) - 1, max_time);
+		}
+		return max_time;
+	}
+	auto Master::rtPhaseHistogram(RtPhase phase, RtPhaseHistogram *histogram)const->void
+	{
+		auto &data = imp_->phase_histograms_.at(phase);
+		for (aris::Size i = 0; i < RtPhaseHistogram::BUCKET_SIZE; ++i)histogram->count[i] = data.count[i].load(std::memory_order_relaxed);
+		histogram->total_count = data.total_count.load(std::memory_order_relaxed);
+		histogram->max_time = data.max_time.load(std::memory_order_relaxed);
+	}
 	Master::~Master() = default;
 	Master::Master(const std::string &name) :imp_(new Imp), Object(name)
 	{
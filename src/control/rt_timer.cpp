@@ -18,6 +18,8 @@ namespace aris::control
 {
 #ifdef ARIS_USE_XENOMAI
 	thread_local std::int64_t last_time_;
+	thread_local std::int64_t period_ns_{ 1000000 };
+	thread_local std::int64_t correction_ns_{ 0 };
 
 
 	auto aris_mlockall()->void { if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) throw std::runtime_error("lock failed"); }
@@ -35,14 +37,37 @@ namespace aris::control
 	auto aris_rt_task_join(std::any& rt_task)->int { return rt_task_join(&std::any_cast<RT_TASK&>(rt_task)); }
 	auto aris_rt_task_set_periodic(int nanoseconds)->int 
 	{ 
+		period_ns_ = nanoseconds;
 		last_time_ = aris_rt_timer_read();
+		correction_ns_ = 0;
 		return rt_task_set_periodic(NULL, TM_NOW, nanoseconds);
 	}
 	auto aris_rt_task_wait_period()->int 
 	{ 
-		last_time_ += 1000000;
+		last_time_ += period_ns_;
+
+		// 有修正时，以修正后的时刻重新设置周期的起点 //
+		if (correction_ns_)
+		{
+			last_time_ += correction_ns_;
+			correction_ns_ = 0;
+
+			// 超时周期后 last_time_ 可能已落在过去，设置失败时以当前时刻重新对齐 //
+			if (rt_task_set_periodic(NULL, last_time_, period_ns_) < 0)
+			{
+				last_time_ = aris_rt_timer_read();
+				if (auto ret = rt_task_set_periodic(NULL, TM_NOW, period_ns_); ret < 0) return ret;
+			}
+		}
 		return rt_task_wait_period(NULL); 
 	}
+	auto aris_rt_task_restart_period()->int
+	{
+		last_time_ = aris_rt_timer_read();
+		return 0;
+	}
+	auto aris_rt_task_period_time()->std::int64_t { return last_time_; }
+	auto aris_rt_task_correct_period(std::int64_t ns)->void { correction_ns_ += ns; }
 	auto aris_rt_timer_read()->std::int64_t { return rt_timer_read(); }
 
 	auto aris_rt_time_since_last_time()->std::int64_t { return aris_rt_timer_read() - last_time_; }
@@ -50,6 +75,7 @@ namespace aris::control
 	// should not have global variables
 	thread_local int nanoseconds{ 1000 };
 	thread_local std::chrono::time_point<std::chrono::high_resolution_clock> last_time_, begin_time_;
+	thread_local std::int64_t correction_ns_{ 0 };
 	//
 
 	auto aris_mlockall()->void {}
@@ -68,14 +94,26 @@ namespace aris::control
 	{
 		control::nanoseconds = nanoseconds;
 		last_time_ = begin_time_ = std::chrono::high_resolution_clock::now();
+		correction_ns_ = 0;
 		return 0;
 	};
 	auto aris_rt_task_wait_period()->int
 	{
-		last_time_ += std::chrono::nanoseconds(nanoseconds);
+		last_time_ += std::chrono::nanoseconds(nanoseconds + correction_ns_);
+		correction_ns_ = 0;
 		std::this_thread::sleep_until(last_time_);
 		return 0;
 	};
+	auto aris_rt_task_restart_period()->int
+	{
+		last_time_ = std::chrono::high_resolution_clock::now();
+		return 0;
+	}
+	auto aris_rt_task_period_time()->std::int64_t
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(last_time_ - begin_time_).count();
+	}
+	auto aris_rt_task_correct_period(std::int64_t ns)->void { correction_ns_ += ns; }
 	auto aris_rt_timer_read()->std::int64_t
 	{
 		auto now = std::chrono::high_resolution_clock::now();
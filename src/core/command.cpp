@@ -1,6 +1,9 @@
 ﻿#include "aris/core/command.hpp"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -11,7 +14,7 @@
 
 namespace aris::core
 {
-	struct ParamBase::Imp { bool is_taken_{ false }; };
+	struct ParamBase::Imp {};
 	auto ParamBase::command()const->const Command & {
 		if (auto c = dynamic_cast<const Command *>(father()))
 			return *c;
@@ -78,109 +81,88 @@ namespace aris::core
 
 	struct Command::Imp
 	{
-		bool is_taken_;
+		// 解析时已经设置的参数，放在局部变量中，因此同一个 parser 可以在多个线程中同时解析 //
+		using Taken = std::vector<const Object*>;
+
 		std::string default_value_{ "" };
 		std::map<std::string, Param*> param_map_;
 		std::map<char, std::string> abbreviation_map_;
+		std::string index_error_;
+		std::size_t index_signature_{ 0 };
 
 		Imp(const std::string &default_param = std::string("")) :default_value_(default_param) {}
 
-		static auto take(Object* param)->void
+		static auto is_taken(const Taken &taken, const Object *param)->bool { return std::find(taken.begin(), taken.end(), param) != taken.end(); }
+		static auto take(Object* param, Taken &taken)->void
 		{
 			if (auto p = dynamic_cast<Param*>(param))
 			{
-				if (p->ParamBase::imp_->is_taken_)
+				if (is_taken(taken, p))
 					throw std::runtime_error("parse command error: command \"" + p->command().name() + "\"'s param \"" + p->name() + "\" has been set more than once");
-				p->ParamBase::imp_->is_taken_ = true;
-				take(param->father());
+				taken.push_back(p);
+				take(param->father(), taken);
 			}
 			else if (auto g = dynamic_cast<GroupParam*>(param))
 			{
-				if (!g->ParamBase::imp_->is_taken_)
+				if (!is_taken(taken, g))
 				{
-					g->ParamBase::imp_->is_taken_ = true;
-					take(param->father());
+					taken.push_back(g);
+					take(param->father(), taken);
 				}
 			}
 			else if (auto u = dynamic_cast<UniqueParam*>(param))
 			{
-				if (u->ParamBase::imp_->is_taken_)
+				if (is_taken(taken, u))
 					throw std::runtime_error("parse command error: command \"" + u->command().name() + "\"'s UNIQUE param \"" + u->name() + "\" has been set more than once");
-				u->ParamBase::imp_->is_taken_ = true;
-				take(param->father());
+				taken.push_back(u);
+				take(param->father(), taken);
 			}
 			else if (auto c = dynamic_cast<Command*>(param))
 			{
-				if (c->imp_->is_taken_)
+				if (is_taken(taken, c))
 					throw std::runtime_error("invalid param: some params of command \"" + c->name() + "\" has been set more than once");
-				c->imp_->is_taken_ = true;
+				taken.push_back(c);
 			}
 			else
 			{
 				throw std::runtime_error("wrong type when cmd parse in take");
 			}
 		}
-		static auto reset(Object* param)->void
+		static auto addDefaultParam(Object* param, const Taken &taken, std::map<std::string, std::string> &param_map_out)->void
 		{
 			if (auto p = dynamic_cast<Param*>(param))
 			{
-				p->ParamBase::imp_->is_taken_ = false;
+				if (!is_taken(taken, p))param_map_out.insert(std::make_pair(p->name(), p->imp_->default_value_));
 			}
 			else if (auto g = dynamic_cast<GroupParam*>(param))
 			{
-				g->ParamBase::imp_->is_taken_ = false;
-				for (auto &child : *g)reset(&child);
-			}
-			else if (auto u = dynamic_cast<UniqueParam*>(param))
-			{
-				u->ParamBase::imp_->is_taken_ = false;
-				for (auto &child : *u)reset(&child);
-			}
-			else if (auto c = dynamic_cast<Command*>(param))
-			{
-				c->imp_->is_taken_ = false;
-				for (auto &child : *c)reset(&child);
-			}
-			else
-			{
-				throw std::runtime_error("wrong type when cmd parse in reset");
-			}
-		}
-		static auto addDefaultParam(Object* param, std::map<std::string, std::string> &param_map_out)->void
-		{
-			if (auto p = dynamic_cast<Param*>(param))
-			{
-				if (!p->ParamBase::imp_->is_taken_)param_map_out.insert(std::make_pair(p->name(), p->imp_->default_value_));
-			}
-			else if (auto g = dynamic_cast<GroupParam*>(param))
-			{
-				for (auto &child : *g) { addDefaultParam(&child, param_map_out); }
+				for (auto &child : *g) { addDefaultParam(&child, taken, param_map_out); }
 			}
 			else if (auto u = dynamic_cast<UniqueParam*>(param))
 			{
 				if (u->size() == 0)return;
 
-				auto default_param_iter = std::find_if(u->begin(), u->end(), [](ParamBase &param)->bool { return param.imp_->is_taken_; });
+				auto default_param_iter = std::find_if(u->begin(), u->end(), [&](ParamBase &param)->bool { return is_taken(taken, &param); });
 				auto default_param_ptr = u->imp_->default_value_ == "" ? nullptr : &*u->findByName(u->imp_->default_value_);
 				auto default_param = default_param_iter == u->end() ? default_param_ptr : &*default_param_iter;
 				default_param = u->size() == 1 ? &u->front() : default_param;
 
 				if (!default_param)throw std::runtime_error("failed to find default param in command \"" + u->command().name() + "\" param \"" + u->name() + "\"");
 
-				addDefaultParam(default_param, param_map_out);
+				addDefaultParam(default_param, taken, param_map_out);
 			}
 			else if (auto c = dynamic_cast<Command*>(param))
 			{
 				if (c->size() == 0)return;
 
-				auto default_param_iter = std::find_if(c->begin(), c->end(), [](ParamBase &param)->bool { return param.imp_->is_taken_; });
+				auto default_param_iter = std::find_if(c->begin(), c->end(), [&](ParamBase &param)->bool { return is_taken(taken, &param); });
 				auto default_param_ptr = c->imp_->default_value_ == "" ? nullptr : &*c->findByName(c->imp_->default_value_);
 				auto default_param = default_param_iter == c->end() ? default_param_ptr : &*default_param_iter;
 				default_param = c->size() == 1 ? &c->front() : default_param;
 
 				if (!default_param)throw std::runtime_error("failed to find default param in command \"" + c->name() + "\"");
 
-				addDefaultParam(default_param, param_map_out);
+				addDefaultParam(default_param, taken, param_map_out);
 			}
 			else
 			{
@@ -212,6 +194,41 @@ namespace aris::core
 				for (auto &sub_param : param) add_param_map_and_check_default(cmd, sub_param);
 			}
 		}
+		static auto hash_combine(std::size_t seed, std::size_t h)->std::size_t { return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
+		static auto sign(std::size_t seed, const Object &obj)->std::size_t
+		{
+			seed = hash_combine(seed, reinterpret_cast<std::size_t>(&obj));
+			seed = hash_combine(seed, std::hash<std::string>()(obj.name()));
+			if (auto p = dynamic_cast<const Param*>(&obj))
+			{
+				seed = hash_combine(seed, static_cast<std::size_t>(p->abbreviation()));
+				seed = hash_combine(seed, std::hash<std::string>()(p->defaultValue()));
+			}
+			else if (auto u = dynamic_cast<const UniqueParam*>(&obj))
+			{
+				seed = hash_combine(seed, std::hash<std::string>()(u->defaultParam()));
+			}
+			seed = hash_combine(seed, obj.children().size());
+			for (auto &child : obj.children())seed = sign(seed, child);
+			return seed;
+		}
+		// 建立参数表与缩写表，命令本身的错误在解析该命令时再抛出，不影响其他命令 //
+		static auto build_index(Command *cmd)->void
+		{
+			cmd->imp_->param_map_.clear();
+			cmd->imp_->abbreviation_map_.clear();
+			cmd->imp_->index_error_.clear();
+			cmd->imp_->index_signature_ = cmd->signature();
+			try
+			{
+				if ((cmd->imp_->default_value_ != "") && (cmd->findByName(cmd->imp_->default_value_) == cmd->end())) throw std::runtime_error("Command \"" + cmd->name() + "\" has invalid default param name");
+				for (auto &param : *cmd) add_param_map_and_check_default(cmd, param);
+			}
+			catch (std::exception &e)
+			{
+				cmd->imp_->index_error_ = e.what();
+			}
+		}
 	};
 	auto Command::saveXml(aris::core::XmlElement &xml_ele) const->void
 	{
@@ -247,15 +264,51 @@ namespace aris::core
 
 		return nullptr;
 	}
+	auto Command::signature()const->std::size_t { return Imp::sign(std::hash<std::string>()(imp_->default_value_), *this); }
 	Command::~Command() = default;
 	Command::Command(const std::string &name, const std::string &default_param) :ObjectPool(name), imp_(new Imp(default_param)){}
 	ARIS_DEFINE_BIG_FOUR_CPP(Command);
 
-	struct CommandParser::Imp { ObjectPool<Command>* command_pool_; };
+	struct CommandParser::Imp 
+	{ 
+		ObjectPool<Command>* command_pool_; 
+
+		// 命令名到命令的索引，commandPool 中命令的增删替换或改名后在下一次解析时重建 //
+		bool is_indexed_{ false };
+		std::size_t pool_signature_{ 0 };
+		std::unordered_map<std::string, Command*> command_map_;
+
+		static auto pool_signature(const ObjectPool<Command> &pool)->std::size_t
+		{
+			std::size_t seed = pool.size();
+			for (auto &command : pool)
+			{
+				seed = Command::Imp::hash_combine(seed, reinterpret_cast<std::size_t>(&command));
+				seed = Command::Imp::hash_combine(seed, std::hash<std::string>()(command.name()));
+			}
+			return seed;
+		}
+
+		Imp() = default;
+		Imp(const Imp &other) :command_pool_(other.command_pool_) {}
+		auto operator=(const Imp &other)->Imp& { command_pool_ = other.command_pool_; is_indexed_ = false; command_map_.clear(); return *this; }
+	};
 	auto CommandParser::loadXml(const aris::core::XmlElement &xml_ele)->void
 	{
 		Object::loadXml(xml_ele);
 		imp_->command_pool_ = findOrInsertType<aris::core::ObjectPool<Command>>();
+		imp_->is_indexed_ = false;
+	}
+	auto CommandParser::init()->void
+	{
+		imp_->command_map_.clear();
+		for (auto &command : *imp_->command_pool_)
+		{
+			Command::Imp::build_index(&command);
+			imp_->command_map_.emplace(command.name(), &command);
+		}
+		imp_->pool_signature_ = Imp::pool_signature(*imp_->command_pool_);
+		imp_->is_indexed_ = true;
 	}
 	auto CommandParser::parse(const std::string &command_string, std::string &cmd_out, std::map<std::string, std::string> &param_out)->void
 	{
@@ -307,16 +360,15 @@ namespace aris::core
 
 			if (!(input_stream >> cmd))throw std::runtime_error("invalid command string: please at least contain a word");
 
-			auto command = imp_->command_pool_->findByName(cmd);
-			if (command == imp_->command_pool_->end()) throw std::runtime_error("invalid command name: server does not have this command \"" + cmd + "\"");
+			if (!imp_->is_indexed_ || imp_->pool_signature_ != Imp::pool_signature(*imp_->command_pool_))init();
 
-			// make map and abbrev map //
-			command->imp_->param_map_.clear();
-			command->imp_->abbreviation_map_.clear();
-			if ((command->imp_->default_value_ != "") && (command->findByName(command->imp_->default_value_) == command->end())) throw std::runtime_error("Command \"" + command->name() + "\" has invalid default param name");
-			for (auto &param : *command) Command::Imp::add_param_map_and_check_default(&*command, param);
+			auto found = imp_->command_map_.find(cmd);
+			if (found == imp_->command_map_.end()) throw std::runtime_error("invalid command name: server does not have this command \"" + cmd + "\"");
+			auto command = found->second;
+			if (command->imp_->index_signature_ != command->signature())Command::Imp::build_index(command);
+			if (!command->imp_->index_error_.empty()) throw std::runtime_error(command->imp_->index_error_);
 
-			Command::Imp::reset(&*command);
+			Command::Imp::Taken taken;
 			while (input_stream >> word)
 			{
 				if (word == std::string(1, '\0')) break; // 这意味着结束
@@ -340,7 +392,7 @@ namespace aris::core
 						: get_param_value(word.substr(word.find('=') + 1, std::string::npos), input_stream);
 
 					param_map.insert(make_pair(param_name, param_value));
-					Command::Imp::take(param);
+					Command::Imp::take(param, taken);
 				}
 				else if (param_name_origin.data()[0] == '-' && param_name_origin.data()[1] == '-')
 				{
@@ -354,7 +406,7 @@ namespace aris::core
 						: get_param_value(word.substr(word.find('=') + 1, std::string::npos), input_stream);
 
 					param_map.insert(make_pair(param_name, param_value));
-					Command::Imp::take(param);
+					Command::Imp::take(param, taken);
 				}
 				else
 				{
@@ -367,11 +419,11 @@ namespace aris::core
 						auto param_name = command->imp_->abbreviation_map_.at(abbrev);
 						auto param_value = param->defaultValue();
 						param_map.insert(make_pair(param_name, param_value));
-						Command::Imp::take(param);
+						Command::Imp::take(param, taken);
 					}
 				}
 			}
-			Command::Imp::addDefaultParam(&*command, param_map);
+			Command::Imp::addDefaultParam(command, taken, param_map);
 
 			cmd_out = cmd;
 			param_out = param_map;
@@ -0,0 +1,12 @@
+﻿#include "aris/core/completion.hpp"
+
+namespace aris::core
+{
+	auto completionNotifier()->Notifier& { static Notifier notifier; return notifier; }
+	auto Completion::finish()->void
+	{
+		is_finished_.store(true);
+		completionNotifier().notify();
+	}
+	auto Completion::wait()const->void { completionNotifier().wait([this]() { return is_finished_.load(); }); }
+}
@@ -0,0 +1,58 @@
+﻿#include <mutex>
+#include <atomic>
+
+#ifdef UNIX
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
+
+#include "aris/core/notifier.hpp"
+
+namespace aris::core
+{
+	struct Notifier::Imp
+	{
+		std::atomic<std::uint32_t> seq_{ 0 };
+		std::atomic<std::int32_t> waiter_num_{ 0 };
+#ifndef UNIX
+		std::mutex mu_;
+		std::condition_variable cv_;
+#endif
+	};
+	auto Notifier::notify()->void
+	{
+		imp_->seq_.fetch_add(1);
+		if (imp_->waiter_num_.load() == 0)return;
+#if defined(ARIS_USE_XENOMAI)
+#elif defined(UNIX)
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&imp_->seq_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+		std::lock_guard<std::mutex> lck(imp_->mu_);
+		imp_->cv_.notify_all();
+#endif
+	}
+	auto Notifier::wait(const std::function<bool()> &pred)->void
+	{
+		// 先读 seq 再检查条件，若其间有 notify，则 seq 已改变，下面的等待会立即返回 //
+		for (auto seq = imp_->seq_.load(); !pred(); seq = imp_->seq_.load())
+		{
+			imp_->waiter_num_.fetch_add(1);
+#if defined(ARIS_USE_XENOMAI)
+			timespec timeout{ 0, 1000000 };
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&imp_->seq_), FUTEX_WAIT_PRIVATE, seq, &timeout, nullptr, 0);
+#elif defined(UNIX)
+			syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&imp_->seq_), FUTEX_WAIT_PRIVATE, seq, nullptr, nullptr, 0);
+#else
+			std::unique_lock<std::mutex> lck(imp_->mu_);
+			imp_->cv_.wait(lck, [&]() { return imp_->seq_.load() != seq; });
+#endif
+			imp_->waiter_num_.fetch_sub(1);
+		}
+	}
+	Notifier::~Notifier() = default;
+	Notifier::Notifier() :imp_(new Imp) {}
+}
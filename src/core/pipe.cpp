@@ -3,63 +3,138 @@
 #include <iostream>
 #include <memory>
 #include <atomic>
+#include <algorithm>
 
 #include "aris/core/pipe.hpp"
 
 
 namespace aris::core
 {
+	// 消息在pool中总是连续存放，按8字节对齐，pool尾部放不下时从头开始 //
+	// 若尾部剩余空间能放下一个header，则写入一个 msg_size_ 为 WRAP_MARK 的header标记跳转 //
 	struct Pipe::Imp
 	{
+		static const MsgSize WRAP_MARK = 0xFFFFFFFF;
+		static auto align(std::size_t size)->std::size_t { return (size + 7) / 8 * 8; }
+
+		auto resetPool(std::size_t pool_size)->void
+		{
+			pool_size_ = align(pool_size);
+			pool_.reset(new std::uint64_t[pool_size_ / 8]());
+			send_pos_ = 0;
+			recv_pos_ = 0;
+		}
+		auto header(std::size_t pos)->MsgHeader* { return reinterpret_cast<MsgHeader*>(reinterpret_cast<char*>(pool_.get()) + pos); }
+
 		std::size_t pool_size_;
-		std::unique_ptr<char[]> pool_;
-		std::atomic_size_t send_pos_{ 0 }, recv_pos_{ 0 };
+		std::unique_ptr<std::uint64_t[]> pool_;
+
+		// 生产者与消费者的数据分别放在不同的cache line中 //
+		alignas(64) std::atomic_size_t send_pos_{ 0 };
+		std::size_t reserved_pos_{ 0 };
+		alignas(64) std::atomic_size_t recv_pos_{ 0 };
 	};
 	auto Pipe::loadXml(const aris::core::XmlElement &xml_ele)->void
 	{
-		imp_->pool_size_ = attributeInt32(xml_ele, "pool_size", 16384);
-		imp_->pool_.reset(new char[imp_->pool_size_]());
+		imp_->resetPool(attributeInt32(xml_ele, "pool_size", 16384));
 
 		Object::loadXml(xml_ele);
 	}
 	auto Pipe::sendMsg(const aris::core::MsgBase &msg)->bool
 	{
-		auto send_pos = imp_->send_pos_.load();// 原子操作
-		auto recv_pos = imp_->recv_pos_.load();// 原子操作
-
-		std::size_t remain_data_size = (send_pos - recv_pos + imp_->pool_size_) % imp_->pool_size_;
-		if (remain_data_size + sizeof(MsgHeader) + msg.size()> imp_->pool_size_) return false; // 查看现有数据容量加待发送数据容量，是否超过缓存大小
-		std::size_t send_num1 = send_pos + sizeof(MsgHeader) + msg.size() > imp_->pool_size_ ? imp_->pool_size_ - send_pos : sizeof(MsgHeader) + msg.size();
-		std::size_t send_num2 = sizeof(MsgHeader) + msg.size() - send_num1;
-		std::copy_n(reinterpret_cast<const char *>(&msg.header()), send_num1, &imp_->pool_[send_pos]);
-		std::copy_n(reinterpret_cast<const char *>(&msg.header()) + send_num1, send_num2, &imp_->pool_[0]);
-		imp_->send_pos_.store((send_pos + msg.size() + sizeof(MsgHeader)) % imp_->pool_size_); // 原子操作
+		auto header = reserveMsg(msg.size());
+		if (!header) return false;
+		std::copy_n(reinterpret_cast<const char *>(&msg.header()), sizeof(MsgHeader) + msg.size(), reinterpret_cast<char *>(header));
+		commitMsg();
 		return true;
 	}
 	auto Pipe::recvMsg(aris::core::MsgBase &msg)->bool
 	{
-		auto send_pos = imp_->send_pos_.load();// 原子操作
-		auto recv_pos = imp_->recv_pos_.load();// 原子操作
-
-		MsgHeader header;
-		if (send_pos == recv_pos) return false;
-		std::size_t recv_num1 = recv_pos + sizeof(MsgHeader) > imp_->pool_size_ ? imp_->pool_size_ - recv_pos : sizeof(MsgHeader);
-		std::size_t recv_num2 = sizeof(MsgHeader) - recv_num1;
-		std::copy_n(&imp_->pool_[recv_pos], recv_num1, reinterpret_cast<char *>(&header));
-		std::copy_n(&imp_->pool_[0], recv_num2, reinterpret_cast<char *>(&header) + recv_num1);
-		msg.resize(header.msg_size_);
-		recv_num1 = recv_pos + sizeof(MsgHeader) + msg.size() > imp_->pool_size_ ? imp_->pool_size_ - recv_pos : sizeof(MsgHeader) + msg.size();
-		recv_num2 = sizeof(MsgHeader) + msg.size() - recv_num1;
-		std::copy_n(&imp_->pool_[recv_pos], recv_num1, reinterpret_cast<char *>(&msg.header()));
-		std::copy_n(&imp_->pool_[0], recv_num2, reinterpret_cast<char *>(&msg.header()) + recv_num1);
-		imp_->recv_pos_.store((recv_pos + msg.size() + sizeof(MsgHeader)) % imp_->pool_size_);// 原子操作
+		auto send_pos = imp_->send_pos_.load(std::memory_order_acquire);
+		auto recv_pos = imp_->recv_pos_.load(std::memory_order_relaxed);
+
+		if (recv_pos == send_pos) return false;
+
+		// 跳过尾部的空白 //
+		if (imp_->pool_size_ - recv_pos < sizeof(MsgHeader) || imp_->header(recv_pos)->msg_size_ == Imp::WRAP_MARK)
+		{
+			recv_pos = 0;
+			if (recv_pos == send_pos)
+			{
+				imp_->recv_pos_.store(recv_pos, std::memory_order_release);
+				return false;
+			}
+		}
+
+		auto header = imp_->header(recv_pos);
+		msg.resize(header->msg_size_);
+		std::copy_n(reinterpret_cast<const char *>(header), sizeof(MsgHeader) + header->msg_size_, reinterpret_cast<char *>(&msg.header()));
+		imp_->recv_pos_.store((recv_pos + Imp::align(sizeof(MsgHeader) + msg.size())) % imp_->pool_size_, std::memory_order_release);
 		return true;
 	}
+	auto Pipe::reserveMsg(aris::core::MsgSize size)->aris::core::MsgHeader*
+	{
+		auto send_pos = imp_->send_pos_.load(std::memory_order_relaxed);
+		auto recv_pos = imp_->recv_pos_.load(std::memory_order_acquire);
+
+		auto msg_size = Imp::align(sizeof(MsgHeader) + size);
+		auto used_size = (send_pos - recv_pos + imp_->pool_size_) % imp_->pool_size_;
+		auto tail_size = imp_->pool_size_ - send_pos;
+
+		// 写满后 send_pos 与 recv_pos 相等，无法与空区分，因此必须严格小于 pool size //
+		auto pos = tail_size < msg_size ? 0 : send_pos;
+		auto need_size = tail_size < msg_size ? tail_size + msg_size : msg_size;
+		if (used_size + need_size >= imp_->pool_size_)
+		{
+			// 管道为空但两端都放不下时，先单独提交一个跳转，消费者跳过之后两端都回到0，下次即可写入 //
+			// 生产者不能直接改 recv_pos，消费者此时可能仍在读取旧的位置 //
+			if (used_size == 0 && send_pos != 0 && msg_size < imp_->pool_size_)
+			{
+				if (tail_size >= sizeof(MsgHeader)) imp_->header(send_pos)->msg_size_ = Imp::WRAP_MARK;
+				imp_->send_pos_.store(0, std::memory_order_release);
+			}
+			return nullptr;
+		}
+
+		if (pos != send_pos && tail_size >= sizeof(MsgHeader)) imp_->header(send_pos)->msg_size_ = Imp::WRAP_MARK;
+
+		imp_->reserved_pos_ = pos;
+		auto header = imp_->header(pos);
+		*header = MsgHeader{ size, 0, 0, 0, 0, 0 };
+		return header;
+	}
+	auto Pipe::commitMsg()->void
+	{
+		auto header = imp_->header(imp_->reserved_pos_);
+		imp_->send_pos_.store((imp_->reserved_pos_ + Imp::align(sizeof(MsgHeader) + header->msg_size_)) % imp_->pool_size_, std::memory_order_release);
+	}
+	auto Pipe::drainMsg(const std::function<void(const aris::core::MsgHeader &header, const char *data)> &func)->std::size_t
+	{
+		auto send_pos = imp_->send_pos_.load(std::memory_order_acquire);
+		auto recv_pos = imp_->recv_pos_.load(std::memory_order_relaxed);
+
+		std::size_t num{ 0 };
+		while (recv_pos != send_pos)
+		{
+			if (imp_->pool_size_ - recv_pos < sizeof(MsgHeader) || imp_->header(recv_pos)->msg_size_ == Imp::WRAP_MARK)
+			{
+				recv_pos = 0;
+				continue;
+			}
+
+			auto header = imp_->header(recv_pos);
+			func(*header, reinterpret_cast<const char *>(header) + sizeof(MsgHeader));
+			recv_pos = (recv_pos + Imp::align(sizeof(MsgHeader) + header->msg_size_)) % imp_->pool_size_;
+			++num;
+		}
+
+		imp_->recv_pos_.store(recv_pos, std::memory_order_release);
+		return num;
+	}
 	Pipe::~Pipe() = default;
 	Pipe::Pipe(const std::string &name, std::size_t pool_size) :Object(name), imp_(new Imp)
 	{
-		imp_->pool_size_ = pool_size;
-		imp_->pool_.reset(new char[imp_->pool_size_]());
+		imp_->resetPool(pool_size);
 	}
 	Pipe::Pipe(Pipe&&) = default;
 	Pipe& Pipe::operator=(Pipe&&) = default;
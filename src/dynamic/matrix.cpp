@@ -9,11 +9,344 @@
 #include <cstddef>
 #include <array>
 #include <list>
+#include <thread>
 
 #include "aris/dynamic/matrix.hpp"
 
 namespace aris::dynamic
 {
+	namespace
+	{
+		// 把 [0, size) 分成至多 thread_num 段，由多个线程同时计算，func(id, begin, end) //
+		// 每个线程至少 min_size，因此小问题只在当前线程计算 //
+		template<typename Func>
+		auto parallel_for(Size thread_num, Size size, Size min_size, Func &&func)->void
+		{
+			thread_num = std::max<Size>(std::min(thread_num, size / std::max<Size>(min_size, 1)), 1);
+			if (thread_num == 1) { func(Size(0), Size(0), size); return; }
+
+			std::vector<std::thread> threads;
+			Size started{ 1 };
+			try
+			{
+				threads.reserve(thread_num - 1);
+				for (; started < thread_num; ++started)
+					threads.emplace_back([&func, started, size, thread_num]() { func(started, size * started / thread_num, size * (started + 1) / thread_num); });
+			}
+			catch (std::exception &) {}
+
+			// 无法创建线程的部分，在当前线程中完成 //
+			func(Size(0), Size(0), size / thread_num);
+			for (Size i = started; i < thread_num; ++i)func(Size(0), size * i / thread_num, size * (i + 1) / thread_num);
+			for (auto &t : threads)t.join();
+		}
+
+		// 分块的大小：A 的块为 MC x KC，B 的块为 KC x NC，寄存器中为 MR x NR //
+		// 不打包时直接在原矩阵中读取 B 的块，取得小一些以留在二级缓存中 //
+		constexpr Size MC = 128, KC = 256, NC = 2048, DIRECT_NC = 256, MR = 4, NR = 8;
+
+		// 打包后，A 的每 MR 行为一组，组内按列连续存放，不足的部分补0 //
+		auto pack_a(Size mc, Size kc, const double *A, Stride a_t, double *buf)noexcept->void
+		{
+			for (Size i = 0; i < mc; i += MR)
+			{
+				const Size mr = std::min(MR, mc - i);
+				for (Size u = 0; u < kc; ++u, buf += MR)
+				{
+					for (Size ii = 0; ii < mr; ++ii)buf[ii] = A[at(i + ii, u, a_t)];
+					for (Size ii = mr; ii < MR; ++ii)buf[ii] = 0.0;
+				}
+			}
+		}
+		// 打包后，B 的每 NR 列为一组，组内按行连续存放，不足的部分补0 //
+		auto pack_b(Size kc, Size nc, const double *B, Stride b_t, double *buf)noexcept->void
+		{
+			for (Size j = 0; j < nc; j += NR)
+			{
+				const Size nr = std::min(NR, nc - j);
+				for (Size u = 0; u < kc; ++u, buf += NR)
+				{
+					for (Size jj = 0; jj < nr; ++jj)buf[jj] = B[at(u, j + jj, b_t)];
+					for (Size jj = nr; jj < NR; ++jj)buf[jj] = 0.0;
+				}
+			}
+		}
+		// 寄存器分块，循环次数为常量，编译器可以向量化 //
+		auto micro_kernel(Size kc, double alpha, const double *a, const double *b, Size mr, Size nr, double *C, Stride c_t)noexcept->void
+		{
+			double c[MR][NR]{};
+			for (Size u = 0; u < kc; ++u, a += MR, b += NR)
+				for (Size i = 0; i < MR; ++i)
+					for (Size j = 0; j < NR; ++j)
+						c[i][j] += a[i] * b[j];
+
+			for (Size i = 0; i < mr; ++i)
+				for (Size j = 0; j < nr; ++j)
+					C[at(i, j, c_t)] += alpha * c[i][j];
+		}
+		// 不打包的寄存器分块，每次从原矩阵中读出 A 的一列和 B 的一行，不足的部分补0 //
+		auto micro_kernel_direct(Size kc, double alpha, const double *A, Stride a_t, const double *B, Stride b_t, Size mr, Size nr, double *C, Stride c_t)noexcept->void
+		{
+			double c[MR][NR]{};
+			for (Size u = 0; u < kc; ++u)
+			{
+				double a[MR]{}, b[NR]{};
+				for (Size i = 0; i < mr; ++i)a[i] = A[at(i, u, a_t)];
+				for (Size j = 0; j < nr; ++j)b[j] = B[at(u, j, b_t)];
+				for (Size i = 0; i < MR; ++i)
+					for (Size j = 0; j < NR; ++j)
+						c[i][j] += a[i] * b[j];
+			}
+
+			for (Size i = 0; i < mr; ++i)
+				for (Size j = 0; j < nr; ++j)
+					C[at(i, j, c_t)] += alpha * c[i][j];
+		}
+	}
+	auto s_mma_blocked(Size m, Size n, Size k, double alpha, const double* A, Stride a_t, const double* B, Stride b_t, double *C, Stride c_t)noexcept->void
+	{
+		for (Size jc = 0; jc < n; jc += DIRECT_NC)
+		{
+			const Size nc = std::min(DIRECT_NC, n - jc);
+			for (Size pc = 0; pc < k; pc += KC)
+			{
+				const Size kc = std::min(KC, k - pc);
+				for (Size ic = 0; ic < m; ic += MC)
+				{
+					const Size mc = std::min(MC, m - ic);
+					for (Size jr = 0; jr < nc; jr += NR)
+						for (Size ir = 0; ir < mc; ir += MR)
+							micro_kernel_direct(kc, alpha, A + at(ic + ir, pc, a_t), a_t, B + at(pc, jc + jr, b_t), b_t, std::min(MR, mc - ir), std::min(NR, nc - jr), C + at(ic + ir, jc + jr, c_t), c_t);
+				}
+			}
+		}
+	}
+	auto s_mma_parallel(Size m, Size n, Size k, double alpha, const double* A, Stride a_t, const double* B, Stride b_t, double *C, Stride c_t, Size thread_num)->void
+	{
+		const Size m_blk_num = (m + MC - 1) / MC;
+		thread_num = std::max<Size>(std::min(thread_num, m_blk_num), 1);
+
+		std::vector<double> b_buf(KC * ((std::min(NC, n) + NR - 1) / NR * NR));
+		std::vector<std::vector<double>> a_bufs(thread_num, std::vector<double>(KC * MC));
+
+		for (Size jc = 0; jc < n; jc += NC)
+		{
+			const Size nc = std::min(NC, n - jc);
+			for (Size pc = 0; pc < k; pc += KC)
+			{
+				const Size kc = std::min(KC, k - pc);
+				pack_b(kc, nc, B + at(pc, jc, b_t), b_t, b_buf.data());
+
+				// 不同的行块写入 C 的不同部分，可以同时计算 //
+				parallel_for(thread_num, m_blk_num, m_blk_num / thread_num, [&](Size id, Size begin, Size end)
+				{
+					auto a_buf = a_bufs[id].data();
+					for (Size blk = begin; blk < end; ++blk)
+					{
+						const Size ic = blk * MC, mc = std::min(MC, m - ic);
+						pack_a(mc, kc, A + at(ic, pc, a_t), a_t, a_buf);
+
+						for (Size jr = 0; jr < nc; jr += NR)
+							for (Size ir = 0; ir < mc; ir += MR)
+								micro_kernel(kc, alpha, a_buf + ir * kc, b_buf.data() + jr * kc, std::min(MR, mc - ir), std::min(NR, nc - jr), C + at(ic + ir, jc + jr, c_t), c_t);
+					}
+				});
+			}
+		}
+	}
+	auto s_householder_utp_blocked(Size m, Size n, double *U, Size u_ld, double *tau, Size tau_ld, Size *p, Size &rank, double zero_check)noexcept->void
+	{
+		rank = 0;
+		std::iota(p, p + n, 0);
+
+		// 第 i 步时 tau 的第 i 到 n-1 个元素还没有用到，依次存放各列的模和 householder 更新的中间量 //
+		// 累加的顺序与逐列计算的版本相同，因此结果完全一致 //
+		for (Size i = 0; i < std::min(m, n); ++i)
+		{
+			// 逐行扫描，计算剩余各列的模 //
+			for (Size j = i; j < n; ++j)tau[j * tau_ld] = 0.0;
+			for (Size r = i; r < m; ++r)
+			{
+				const double *ur = U + r * u_ld;
+				for (Size j = i; j < n; ++j)tau[j * tau_ld] += ur[j] * ur[j];
+			}
+
+			// 找到模最大的一列 //
+			double max_value{ 0 };
+			Size max_pos{ i };
+			for (Size j = i; j < n; ++j)
+			{
+				max_pos = tau[j * tau_ld] > max_value ? j : max_pos;
+				max_value = tau[j * tau_ld] > max_value ? tau[j * tau_ld] : max_value;
+			}
+
+			// 判断是否返回 //
+			max_value = std::sqrt(max_value);
+			if (max_value < zero_check) { for (Size r = i; r < m; ++r)tau[r * tau_ld] = 0.0; return; }
+
+			++rank;
+			if (max_pos != i)
+			{
+				for (Size r = 0; r < m; ++r)std::swap(U[r * u_ld + max_pos], U[r * u_ld + i]);
+				std::swap(p[max_pos], p[i]);
+			}
+
+			// 若已经到达最后一行，那么就返回，因为最后一行不需要householder化 //
+			if (i == m - 1) return;
+
+			// compute householder vector //
+			const double uii = U[i * u_ld + i];
+			const double rho = -max_value * s_sgn2(uii);
+			const double t = uii / rho - 1.0;
+			const double scale = 1.0 / (uii - rho);
+			tau[i * tau_ld] = t;
+			U[i * u_ld + i] = rho;
+			for (Size r = i + 1; r < m; ++r)U[r * u_ld + i] *= scale;
+
+			if (i + 1 == n) continue;
+
+			// w = t * (U(i,:) + v' * U(i+1:m, :))，按行扫描 //
+			for (Size j = i + 1; j < n; ++j)tau[j * tau_ld] = 0.0;
+			for (Size r = i + 1; r < m; ++r)
+			{
+				const double v = U[r * u_ld + i];
+				const double *ur = U + r * u_ld;
+				for (Size j = i + 1; j < n; ++j)tau[j * tau_ld] += v * ur[j];
+			}
+			for (Size j = i + 1; j < n; ++j)
+			{
+				tau[j * tau_ld] = t * (tau[j * tau_ld] + U[i * u_ld + j]);
+				U[i * u_ld + j] += tau[j * tau_ld];
+			}
+
+			// U(i+1:m, :) += v * w' //
+			for (Size r = i + 1; r < m; ++r)
+			{
+				const double v = U[r * u_ld + i];
+				double *ur = U + r * u_ld;
+				for (Size j = i + 1; j < n; ++j)ur[j] += tau[j * tau_ld] * v;
+			}
+		}
+	}
+	auto s_householder_utp_parallel(Size m, Size n, double *U, Size u_ld, double *tau, Size tau_ld, Size *p, Size &rank, double zero_check, Size thread_num)->void
+	{
+		rank = 0;
+		std::iota(p, p + n, 0);
+
+		// 每个线程至少处理的行数 //
+		const Size min_rows = 4096;
+		thread_num = std::max<Size>(thread_num, 1);
+		const double tol = std::sqrt(std::numeric_limits<double>::epsilon());
+
+		// 各列的模的平方，以及上次重新计算时的值 //
+		std::vector<double> norm2(n, 0.0), ref_norm2(n), w(n);
+		std::vector<std::vector<double>> w_part(thread_num, std::vector<double>(n));
+		auto column_norm2 = [&](Size row_begin, Size col_begin)
+		{
+			for (auto &wp : w_part)std::fill(wp.begin() + col_begin, wp.end(), 0.0);
+			parallel_for(thread_num, m - row_begin, min_rows, [&](Size id, Size begin, Size end)
+			{
+				auto wp = w_part[id].data();
+				for (Size r = row_begin + begin; r < row_begin + end; ++r)
+					for (Size j = col_begin; j < n; ++j)wp[j] += U[r * u_ld + j] * U[r * u_ld + j];
+			});
+			for (Size j = col_begin; j < n; ++j)
+			{
+				norm2[j] = 0.0;
+				for (auto &wp : w_part)norm2[j] += wp[j];
+				ref_norm2[j] = norm2[j];
+			}
+		};
+		column_norm2(0, 0);
+
+		for (Size i = 0; i < std::min(m, n); ++i)
+		{
+			// 找到模最大的一列 //
+			double max_value{ 0 };
+			Size max_pos{ i };
+			for (Size j = i; j < n; ++j)
+			{
+				max_pos = norm2[j] > max_value ? j : max_pos;
+				max_value = norm2[j] > max_value ? norm2[j] : max_value;
+			}
+
+			// 判断是否返回 //
+			max_value = std::sqrt(max_value);
+			if (max_value < zero_check) { for (Size r = i; r < m; ++r)tau[r * tau_ld] = 0.0; return; }
+
+			++rank;
+			if (max_pos != i)
+			{
+				for (Size r = 0; r < m; ++r)std::swap(U[r * u_ld + max_pos], U[r * u_ld + i]);
+				std::swap(p[max_pos], p[i]);
+				std::swap(norm2[max_pos], norm2[i]);
+				std::swap(ref_norm2[max_pos], ref_norm2[i]);
+			}
+
+			// 若已经到达最后一行，那么就返回，因为最后一行不需要householder化 //
+			if (i == m - 1) return;
+
+			// compute householder vector //
+			const double uii = U[i * u_ld + i];
+			const double rho = -max_value * s_sgn2(uii);
+			const double t = uii / rho - 1.0;
+			const double scale = 1.0 / (uii - rho);
+			tau[i * tau_ld] = t;
+			U[i * u_ld + i] = rho;
+			for (Size r = i + 1; r < m; ++r)U[r * u_ld + i] *= scale;
+
+			if (i + 1 == n) continue;
+
+			// w = U(i,:) + v' * U(i+1:m, :)，按行扫描，每个线程累加自己的部分 //
+			for (auto &wp : w_part)std::fill(wp.begin() + i + 1, wp.end(), 0.0);
+			parallel_for(thread_num, m - i - 1, min_rows, [&](Size id, Size begin, Size end)
+			{
+				auto wp = w_part[id].data();
+				for (Size r = i + 1 + begin; r < i + 1 + end; ++r)
+				{
+					const double v = U[r * u_ld + i];
+					const double *ur = U + r * u_ld;
+					for (Size j = i + 1; j < n; ++j)wp[j] += v * ur[j];
+				}
+			});
+			for (Size j = i + 1; j < n; ++j)
+			{
+				w[j] = U[i * u_ld + j];
+				for (auto &wp : w_part)w[j] += wp[j];
+				w[j] *= t;
+				U[i * u_ld + j] += w[j];
+			}
+
+			// U(i+1:m, :) += v * w' //
+			parallel_for(thread_num, m - i - 1, min_rows, [&](Size, Size begin, Size end)
+			{
+				for (Size r = i + 1 + begin; r < i + 1 + end; ++r)
+				{
+					const double v = U[r * u_ld + i];
+					double *ur = U + r * u_ld;
+					for (Size j = i + 1; j < n; ++j)ur[j] += v * w[j];
+				}
+			});
+
+			// 更新列的模，相消过多时重新计算 //
+			bool need_recompute{ false };
+			for (Size j = i + 1; j < n; ++j)
+			{
+				norm2[j] -= U[i * u_ld + j] * U[i * u_ld + j];
+				if (norm2[j] <= tol * ref_norm2[j]) need_recompute = true;
+			}
+			if (need_recompute)
+			{
+				for (Size j = i + 1; j < n; ++j)
+				{
+					if (norm2[j] > tol * ref_norm2[j])continue;
+					norm2[j] = 0.0;
+					for (Size r = i + 1; r < m; ++r)norm2[j] += U[r * u_ld + j] * U[r * u_ld + j];
+					ref_norm2[j] = norm2[j];
+				}
+			}
+		}
+	}
 	auto dlmread(const char *FileName, double *pMatrix)->void
 	{
 		std::ifstream file;
@@ -12,6 +12,7 @@
 #include <numeric>
 #include <deque>
 #include <array>
+#include <thread>
 
 #include "aris/dynamic/model.hpp"
 #include "aris/plan/root.hpp"
@@ -471,7 +472,8 @@ namespace aris::dynamic
 		std::cout << "solve calibration matrix" << std::endl;
 		aris::Size rank;
 		double zero_check = 1e-6;
-		s_householder_utp(rows, n(), A.data(), A.data(), tau.data(), p.data(), rank, zero_check);
+		// 辨识矩阵很大，在非实时线程中用多个线程分解 //
+		s_householder_utp_parallel(rows, n(), A.data(), n(), tau.data(), 1, p.data(), rank, zero_check, std::max<Size>(std::thread::hardware_concurrency(), 1));
 		s_householder_utp_sov(rows, n(), 1, rank, A.data(), tau.data(), p.data(), b.data(), x.data(), zero_check);
 		std::cout << "rank:" << rank << std::endl;
 
@@ -656,7 +658,7 @@ namespace aris::dynamic
 		std::cout << "solve calibration matrix" << std::endl;
 		aris::Size rank;
 		double zero_check = 1e-4;
-		s_householder_utp(m()*num, n(), A.data(), A.data(), tau.data(), p.data(), rank, zero_check);
+		s_householder_utp_parallel(m()*num, n(), A.data(), n(), tau.data(), 1, p.data(), rank, zero_check, std::max<Size>(std::thread::hardware_concurrency(), 1));
 		//dlmwrite(num * m(), n(), A.data(), "C:\\Users\\py033\\Desktop\\data_after\\U.txt");
 		//std::vector<double> Q(num * m() * n(), 0.0);
 		//s_householder_ut2qmn(m()*num, rank, A.data(), n(), tau.data(),1, Q.data(),rank);
@@ -1085,7 +1087,7 @@ namespace aris::dynamic
 			aris::control::Master::RtStasticsData{ 0,0,0,0x8fffffff,0,0,0 },
 			std::any(),
 			aris::plan::PlanTarget::CANCELLED,
-			std::future<void>()
+			aris::core::Completion()
 		};
 
 		// 记录轨迹中的状态 //
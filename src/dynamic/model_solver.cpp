@@ -10,11 +10,143 @@
 #include <limits>
 #include <type_traits>
 #include <array>
+#include <atomic>
+#include <thread>
 
+#ifdef UNIX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "aris/core/notifier.hpp"
 #include "aris/dynamic/model.hpp"
 
 namespace aris::dynamic
 {
+	namespace
+	{
+		// 在自旋等待中降低功耗，并让出流水线给同一物理核上的另一个超线程 //
+		auto inline cpu_relax()noexcept->void
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		// 常驻的工作线程，在实时循环中反复使用，避免每次计算时创建线程 //
+		// run 时 i 号线程执行 i 号任务，主线程执行 0 号任务以及没有线程执行的任务，所有线程都完成后返回 //
+		// 工作线程和主线程都只自旋有限的次数，之后在 futex 上睡眠，不用让出时间片的方式忙等，也不加锁 //
+		// 因此在 SCHED_FIFO 下，即使与低优先级的线程共用一个核，也不会使其饿死 //
+		class WorkerPool
+		{
+		public:
+			static constexpr Size SPIN_COUNT = 2000;
+
+			auto threadNum()const->Size { return threads_.size() + 1; }
+			// cpus 的第 i 个为第 i+1 号线程绑定的核，不足时不绑定 //
+			// priority 大于0时工作线程使用 SCHED_FIFO，否则继承调用 start 的线程的调度策略和优先级 //
+			auto start(Size thread_num, const std::vector<int> &cpus, int priority)->void
+			{
+				if (threadNum() == thread_num && cpus_ == cpus && priority_ == priority)return;
+				stop();
+				cpus_ = cpus;
+				priority_ = priority;
+				is_running_ = true;
+#ifdef UNIX
+				int policy;
+				sched_param param;
+				pthread_getschedparam(pthread_self(), &policy, &param);
+				if (priority > 0) { policy = SCHED_FIFO; param.sched_priority = priority; }
+#endif
+				for (Size i = 1; i < thread_num; ++i)
+				{
+					try { threads_.emplace_back([this, i, seen = generation_.load()]() { work(i, seen); }); }
+					catch (std::exception &) { break; }// 无法创建线程时，剩下的任务由主线程计算
+#ifdef UNIX
+					auto handle = threads_.back().native_handle();
+					bool is_ok = pthread_setschedparam(handle, policy, &param) == 0;
+					if (i - 1 < cpus.size())
+					{
+						cpu_set_t cpu_set;
+						CPU_ZERO(&cpu_set);
+						CPU_SET(cpus[i - 1], &cpu_set);
+						is_ok = is_ok && cpus[i - 1] >= 0 && pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set) == 0;
+					}
+					if (!is_ok)
+					{
+						stop();
+						throw std::runtime_error("failed to set priority or cpu of solver worker thread " + std::to_string(i));
+					}
+#endif
+				}
+			}
+			auto stop()->void
+			{
+				if (threads_.empty())return;
+				is_running_ = false;
+				++generation_;
+				start_notifier_.notify();
+				for (auto &t : threads_)t.join();
+				threads_.clear();
+			}
+			template<typename Func>
+			auto run(Size task_num, Func &&func)->void
+			{
+				const Size worker_task_num = std::min(task_num, threadNum()) - 1;
+				if (worker_task_num > 0)
+				{
+					func_ = [](void *ctx, Size id) { (*static_cast<std::remove_reference_t<Func>*>(ctx))(id); };
+					ctx_ = &func;
+					task_num_ = worker_task_num + 1;
+					unfinished_ = threads_.size();
+					++generation_;
+					start_notifier_.notify();// 没有线程睡眠时不会进入内核 //
+				}
+
+				func(Size(0));
+				for (Size i = worker_task_num + 1; i < task_num; ++i)func(i);
+
+				// 先自旋，仍未完成时睡眠，由最后一个完成的线程唤醒 //
+				for (Size i = 0; i < SPIN_COUNT && unfinished_.load() > 0; ++i)cpu_relax();
+				if (unfinished_.load() > 0)done_notifier_.wait([this]() { return unfinished_.load() == 0; });
+			}
+
+			~WorkerPool() { stop(); }
+			WorkerPool() = default;
+			// 线程不能拷贝，拷贝后的求解器在 allocateMemory 时重新创建线程 //
+			WorkerPool(const WorkerPool &) {}
+			WorkerPool &operator=(const WorkerPool &) { stop(); return *this; }
+
+		private:
+			auto work(Size id, std::uint64_t seen)->void
+			{
+				for (;;)
+				{
+					for (Size i = 0; i < SPIN_COUNT && generation_.load() == seen; ++i)cpu_relax();
+					if (generation_.load() == seen)start_notifier_.wait([&]() { return generation_.load() != seen; });
+
+					seen = generation_.load();
+					if (!is_running_)return;
+					if (id < task_num_)func_(ctx_, id);
+					if (--unfinished_ == 0)done_notifier_.notify();
+				}
+			}
+
+			std::vector<std::thread> threads_;
+			std::vector<int> cpus_;
+			int priority_{ 0 };
+			aris::core::Notifier start_notifier_, done_notifier_;
+			std::atomic<std::uint64_t> generation_{ 0 };
+			std::atomic<Size> unfinished_{ 0 };
+			std::atomic_bool is_running_{ false };
+			void(*func_)(void *, Size) { nullptr };
+			void *ctx_{ nullptr };
+			Size task_num_{ 0 };
+		};
+	}
+
 	struct Solver::Imp
 	{
 		Size max_iter_count_, iter_count_;
@@ -69,6 +201,7 @@ namespace aris::dynamic
 		Size *p;
 		double dm[36], iv[10];
 		double pm1[16], pm2[16], *pm, *last_pm;
+		double sol1[16], sol2[16];// 上一次及上上次的求解结果，用于热启动
 		double xp[6], bp[6], *bc, *xc;
 		std::vector<double> bc_vec, xc_vec;
 
@@ -103,6 +236,8 @@ namespace aris::dynamic
 
 		double *F, *FU, *FT;
 		Size* FP;
+		std::vector<double> FU_vec, FT_vec;// F 的分解结果，热启动时需要保留，因此每个子系统单独存储
+		std::vector<Size> FP_vec;
 		double *G, *GU, *GT;
 		Size *GP;
 
@@ -117,6 +252,13 @@ namespace aris::dynamic
 		double error_, max_error_;
 		Size iter_count_, max_iter_count_;
 
+		// 热启动时，沿用上次的分解结果（固定雅可比），并根据上两次的解外推初值 //
+		bool warm_start_{ false }, has_factor_{ false };
+		Size sol_count_{ 0 };
+
+		// 由哪个线程求解，各子系统相互独立，可以同时求解 //
+		Size thread_id_{ 0 };
+
 		auto hasGround()const noexcept->bool { return has_ground_; }
 		// 从模型中跟新数据 //
 		auto updMakPm()noexcept->void;
@@ -131,6 +273,9 @@ namespace aris::dynamic
 		auto sovXp()noexcept->void;
 		auto updG()noexcept->void;
 		auto sovXc()noexcept->void;
+		// 热启动 //
+		auto extrapolatePm()noexcept->void;
+		auto recordPm()noexcept->void;
 		// 接口 //
 		auto kinPos()noexcept->void;
 		auto kinVel()noexcept->void;
@@ -423,7 +568,7 @@ namespace aris::dynamic
 		{
 			double tem[6];
 
-			s_mm(6, 1, 6, d->dm, 6, d->bp, 1, tem, 1);
+			s_mm<6, 1, 6>(d->dm, 6, d->bp, 1, tem, 1);
 
 			s_vc(6, tem, d->bp);
 			s_vc(6 - d->rel_.dim_, d->bp + d->rel_.dim_, bpf + d->rows);
@@ -458,7 +603,7 @@ namespace aris::dynamic
 			{
 				double tem[6];
 				s_mm(6, 1, r.rel_.size, b.is_I ? r.cmJ : r.cmI, xcf + cols, tem);
-				s_mma(6, 1, 6, b.diag->dm, 6, tem, 1, b.diag->bp, 1);
+				s_mma<6, 1, 6>(b.diag->dm, 6, tem, 1, b.diag->bp, 1);
 			}
 
 			cols += r.rel_.size;
@@ -485,8 +630,46 @@ namespace aris::dynamic
 			s_va(6, d->rd->xp, d->xp);
 		}
 	}
+	auto SubSystem::extrapolatePm()noexcept->void
+	{
+		// 杆件位姿被外部改过，则上两次的解不再可用 //
+		for (auto &d : diag_pool_)if (!std::equal(d.pm, d.pm + 16, d.sol1)) sol_count_ = 0;
+		if (sol_count_ < 2) return;
+
+		// pm = (sol1 * sol2^-1) * sol1，第一个杆件不动（地面或无地面时的参考杆件） //
+		// 外推会逐周期放大旋转矩阵的非正交误差，因此做一次正交化：R = 1.5 * R - 0.5 * R * R' * R //
+		for (auto d = diag_pool_.begin() + 1; d < diag_pool_.end(); ++d)
+		{
+			double delta[16], rrt[9], rrtr[9];
+			s_pm_dot_inv_pm(d->sol1, d->sol2, delta);
+			s_pm_dot_pm(delta, d->sol1, d->pm);
+
+			s_mm(3, 3, 3, d->pm, 4, d->pm, T(4), rrt, 3);
+			s_mm(3, 3, 3, rrt, 3, d->pm, 4, rrtr, 3);
+			for (Size i = 0; i < 3; ++i)for (Size j = 0; j < 3; ++j)d->pm[at(i, j, 4)] = 1.5 * d->pm[at(i, j, 4)] - 0.5 * rrtr[at(i, j, 3)];
+		}
+	}
+	auto SubSystem::recordPm()noexcept->void
+	{
+		if (error_ < max_error_)
+		{
+			for (auto &d : diag_pool_)
+			{
+				std::copy(d.sol1, d.sol1 + 16, d.sol2);
+				std::copy(d.pm, d.pm + 16, d.sol1);
+			}
+			sol_count_ = std::min(sol_count_ + 1, Size(2));
+		}
+		else
+		{
+			sol_count_ = 0;
+			has_factor_ = false;
+		}
+	}
 	auto SubSystem::kinPos()noexcept->void
 	{
+		if (warm_start_) extrapolatePm();
+
 		updMakPm();
 		updCpToBc();
 		updError();
@@ -494,11 +677,16 @@ namespace aris::dynamic
 		{
 			if (error_ < max_error_) return;
 
-			// make A
-			updDmCm();
+			// make A，热启动时沿用已有的分解，只有收敛变慢时才重新分解 //
+			const bool fresh = !(warm_start_ && has_factor_);
+			if (fresh)
+			{
+				updDmCm();
+				updF();
+				has_factor_ = true;
+			}
 
 			// solve
-			updF();
 			sovXp();
 
 			// 将xp更新成pm
@@ -515,6 +703,25 @@ namespace aris::dynamic
 			updCpToBc();
 			updError();
 
+			// 旧的雅可比不再适用：误差增大则退回并重新分解，收敛过慢则下次重新分解 //
+			// 收敛比取 0.01，实时循环中外推后的误差通常只需一步即可满足精度 //
+			if (!fresh)
+			{
+				if (error_ > last_error)
+				{
+					for (auto &d : diag_pool_)std::swap(d.pm, d.last_pm);
+					updMakPm();
+					updCpToBc();
+					updError();
+					has_factor_ = false;
+				}
+				else if (error_ > 0.01 * last_error)
+				{
+					has_factor_ = false;
+				}
+				continue;
+			}
+
 			// 对于非串联臂，当迭代误差反而再增大时，会主动缩小步长
 			if (!remainder_pool_.empty())// 只有不是串联臂才会用以下迭代
 			{
@@ -826,9 +1033,19 @@ namespace aris::dynamic
 		std::vector<Diag *> get_diag_from_part_id_;
 
 		std::vector<SubSystem> subsys_pool_;
+		bool warm_start_{ false };
 
-		std::vector<double> F_, FU_, FT_, G_, GU_, GT_, S_, QT_DOT_G_, xpf_, xcf_, bpf_, bcf_, beta_, cmI, cmJ, cmU, cmT;
-		std::vector<Size> FP_, GP_;
+		// 每个线程所用的临时内存 //
+		struct Workspace
+		{
+			std::vector<double> F_, G_, GU_, GT_, S_, QT_DOT_G_, xpf_, xcf_, bpf_, bcf_, beta_, cmI, cmJ, cmU, cmT;
+			std::vector<Size> GP_;
+		};
+		std::vector<Workspace> workspace_pool_;
+		Size thread_num_{ 1 }, task_num_{ 1 };
+		std::vector<int> thread_cpus_;
+		int thread_priority_{ 0 };
+		WorkerPool worker_pool_;
 
 		std::vector<double> Jg_, cg_;
 		std::vector<double> M_, h_;
@@ -867,7 +1084,7 @@ namespace aris::dynamic
 
 			double tem[36]{ 1,0,0,0,0,0,0,1,0,0,0,0,0,0,1,0,0,0,0,0,0,1,0,0,0,0,0,0,1,0,0,0,0,0,0,1 };
 			s_inv_um(6, d->cmU, d->rel_.size, tem, 6);
-			s_mm(6, 6, 6, tem, 6, Q, dynamic::ColMajor{ 6 }, d->dm, 6);
+			s_mm<6, 6, 6>(tem, 6, Q, dynamic::ColMajor{ 6 }, d->dm, 6);
 		}
 
 		static auto one_constraint_cpt_cp_from_pm(Diag *d)noexcept->void
@@ -883,7 +1100,7 @@ namespace aris::dynamic
 			s_rmz(m->mpInternal(), rm);
 
 			s_vc(16, c.pmJ, pm_j_should_be);
-			s_mm(3, 3, 3, c.pmJ, 4, rm, 3, pm_j_should_be, 4);
+			s_mm<3, 3, 3>(c.pmJ, 4, rm, 3, pm_j_should_be, 4);
 
 			double pm_j2i[16], ps_j2i[6];
 			s_inv_pm_dot_pm(c.pmI, pm_j_should_be, pm_j2i);
@@ -1198,54 +1415,79 @@ namespace aris::dynamic
 		imp_->get_diag_from_part_id_.resize(ancestor<Model>()->partPool().size(), nullptr);
 		for (auto &sys : imp_->subsys_pool_)for (auto &diag : sys.diag_pool_)imp_->get_diag_from_part_id_.at(diag.part->id()) = &diag;
 
-		// 分配计算所需内存 //
-		imp_->F_.resize(max_F_size);
-		imp_->FU_.resize(max_F_size);
-		imp_->FT_.resize(std::max(max_fm, max_fn));
-		imp_->FP_.resize(std::max(max_fm, max_fn));
-		imp_->G_.resize(max_G_size);
-		imp_->GU_.resize(max_G_size);
-		imp_->GT_.resize(std::max(max_gm, max_gn));
-		imp_->GP_.resize(std::max(max_gm, max_gn));
-		imp_->S_.resize(max_fm*max_fm, 0.0);
-		imp_->beta_.resize(max_gn, 0.0); // beta可能会存储无地面处的未知量
-		imp_->QT_DOT_G_.resize(max_G_size, 0.0);
-		imp_->xcf_.resize(std::max(max_fn, max_fm)); //s_house_holder_ut_q_dot要求x > b
-		imp_->xpf_.resize(std::max(max_fn, max_fm));
-		imp_->bcf_.resize(max_fn);
-		imp_->bpf_.resize(max_fm);
-		imp_->cmI.resize(max_cm_size * 6);
-		imp_->cmJ.resize(max_cm_size * 6);
-		imp_->cmU.resize(max_cm_size * 6);
-		imp_->cmT.resize(std::max(Size(6), max_cm_size));
+		// 把子系统分给各个线程，每次分给当前计算量最小的线程，计算量按杆件及约束的个数估计 //
+#ifdef ARIS_USE_XENOMAI
+		// 工作线程不是 xenomai 的实时任务，Notifier 也无法及时唤醒，因此总是在调用者的线程中求解 //
+		imp_->task_num_ = 1;
+#else
+		imp_->task_num_ = std::max(Size(1), std::min(imp_->thread_num_, Size(imp_->subsys_pool_.size())));
+#endif
+		std::vector<SubSystem*> sorted_subsys;
+		for (auto &sys : imp_->subsys_pool_)sorted_subsys.push_back(&sys);
+		auto cost = [](const SubSystem *sys) { return sys->diag_pool_.size() + sys->remainder_pool_.size(); };
+		std::stable_sort(sorted_subsys.begin(), sorted_subsys.end(), [&](const SubSystem *a, const SubSystem *b) { return cost(a) > cost(b); });
+		std::vector<Size> task_cost(imp_->task_num_, 0);
+		for (auto sys : sorted_subsys)
+		{
+			sys->thread_id_ = std::min_element(task_cost.begin(), task_cost.end()) - task_cost.begin();
+			task_cost[sys->thread_id_] += cost(sys);
+		}
+
+		// 分配计算所需内存，每个线程一份 //
+		imp_->workspace_pool_.clear();
+		imp_->workspace_pool_.resize(imp_->task_num_);
+		for (auto &ws : imp_->workspace_pool_)
+		{
+			ws.F_.resize(max_F_size);
+			ws.G_.resize(max_G_size);
+			ws.GU_.resize(max_G_size);
+			ws.GT_.resize(std::max(max_gm, max_gn));
+			ws.GP_.resize(std::max(max_gm, max_gn));
+			ws.S_.resize(max_fm*max_fm, 0.0);
+			ws.beta_.resize(max_gn, 0.0); // beta可能会存储无地面处的未知量
+			ws.QT_DOT_G_.resize(max_G_size, 0.0);
+			ws.xcf_.resize(std::max(max_fn, max_fm)); //s_house_holder_ut_q_dot要求x > b
+			ws.xpf_.resize(std::max(max_fn, max_fm));
+			ws.bcf_.resize(max_fn);
+			ws.bpf_.resize(max_fm);
+			ws.cmI.resize(max_cm_size * 6);
+			ws.cmJ.resize(max_cm_size * 6);
+			ws.cmU.resize(max_cm_size * 6);
+			ws.cmT.resize(std::max(Size(6), max_cm_size));
+		}
+		imp_->worker_pool_.start(imp_->task_num_, imp_->thread_cpus_, imp_->thread_priority_);
 
 		// 将内存付给子系统 //
 		for (auto &sys : imp_->subsys_pool_)
 		{
+			auto &ws = imp_->workspace_pool_[sys.thread_id_];
 			sys.has_ground_ = sys.diag_pool_.begin()->part == &ancestor<Model>()->ground();
 
-			sys.F = imp_->F_.data();
-			sys.FU = imp_->FU_.data();
-			sys.FT = imp_->FT_.data();
-			sys.FP = imp_->FP_.data();
-			sys.G = imp_->G_.data();
-			sys.GU = imp_->GU_.data();
-			sys.GT = imp_->GT_.data();
-			sys.GP = imp_->GP_.data();
-			sys.S = imp_->S_.data();
-			sys.beta = imp_->beta_.data();
-			sys.QT_DOT_G = imp_->QT_DOT_G_.data();
-			sys.xcf = imp_->xcf_.data();
-			sys.xpf = imp_->xpf_.data();
-			sys.bcf = imp_->bcf_.data();
-			sys.bpf = imp_->bpf_.data();
+			sys.F = ws.F_.data();
+			sys.FU_vec.resize(sys.fm * sys.fn);
+			sys.FU = sys.FU_vec.data();
+			sys.FT_vec.resize(std::max(sys.fm, sys.fn));
+			sys.FT = sys.FT_vec.data();
+			sys.FP_vec.resize(std::max(sys.fm, sys.fn));
+			sys.FP = sys.FP_vec.data();
+			sys.G = ws.G_.data();
+			sys.GU = ws.GU_.data();
+			sys.GT = ws.GT_.data();
+			sys.GP = ws.GP_.data();
+			sys.S = ws.S_.data();
+			sys.beta = ws.beta_.data();
+			sys.QT_DOT_G = ws.QT_DOT_G_.data();
+			sys.xcf = ws.xcf_.data();
+			sys.xpf = ws.xpf_.data();
+			sys.bcf = ws.bcf_.data();
+			sys.bpf = ws.bpf_.data();
 
 			for (auto &diag : sys.diag_pool_)
 			{
-				diag.cmI = imp_->cmI.data();
-				diag.cmJ = imp_->cmJ.data();
-				diag.cmU = imp_->cmU.data();
-				diag.cmT = imp_->cmT.data();
+				diag.cmI = ws.cmI.data();
+				diag.cmJ = ws.cmJ.data();
+				diag.cmU = ws.cmU.data();
+				diag.cmT = ws.cmT.data();
 			}
 		}
 
@@ -1265,14 +1507,27 @@ namespace aris::dynamic
 		// 将杆件位姿拷贝到局部变量中 //
 		for (auto &sys : imp_->subsys_pool_)for (auto &d : sys.diag_pool_)d.part->getPm(d.pm);
 
-		setError(0.0);
-		setIterCount(0);
 		for (auto &sys : imp_->subsys_pool_)
 		{
 			sys.max_error_ = maxError();
 			sys.max_iter_count_ = maxIterCount();
-			sys.kinPos();
+			sys.warm_start_ = imp_->warm_start_;
+		}
+		imp_->worker_pool_.run(imp_->task_num_, [&](Size id)
+		{
+			for (auto &sys : imp_->subsys_pool_)
+			{
+				if (sys.thread_id_ != id)continue;
+				sys.kinPos();
+				if (sys.warm_start_) sys.recordPm();
+			}
+		});
 
+		// 按子系统的顺序汇总，与线程数无关 //
+		setError(0.0);
+		setIterCount(0);
+		for (auto &sys : imp_->subsys_pool_)
+		{
 			setIterCount(std::max(iterCount(), sys.iter_count_));
 			setError(std::max(error(), sys.error_));
 		}
@@ -1286,7 +1541,7 @@ namespace aris::dynamic
 		for (auto &sys : imp_->subsys_pool_)for (auto &d : sys.diag_pool_)d.part->getPm(d.pm);
 
 		s_fill(6, 1, 0.0, const_cast<double *>(ancestor<Model>()->ground().vs()));
-		for (auto &sys : imp_->subsys_pool_)sys.kinVel();
+		imp_->worker_pool_.run(imp_->task_num_, [&](Size id) { for (auto &sys : imp_->subsys_pool_) if (sys.thread_id_ == id)sys.kinVel(); });
 
 		// 计算成功，设置各杆件 //
 		for (auto &sys : imp_->subsys_pool_) for (auto &d : sys.diag_pool_)s_va(6, d.xp, const_cast<double*>(d.part->vs()));
@@ -1318,7 +1573,7 @@ namespace aris::dynamic
 
 		// 更新地面的as //
 		s_fill(6, 1, 0.0, const_cast<double *>(ancestor<Model>()->ground().as()));
-		for (auto &sys : imp_->subsys_pool_) sys.dynAccAndFce();
+		imp_->worker_pool_.run(imp_->task_num_, [&](Size id) { for (auto &sys : imp_->subsys_pool_) if (sys.thread_id_ == id)sys.dynAccAndFce(); });
 
 		// 计算成功，设置各关节和杆件
 		for (auto &sys : imp_->subsys_pool_)
@@ -1582,6 +1837,22 @@ namespace aris::dynamic
 	auto UniversalSolver::nM()const noexcept->Size { return ancestor<Model>()->motionPool().size() + ancestor<Model>()->generalMotionPool().size() * 6; }
 	auto UniversalSolver::M()const noexcept->const double * { return imp_->M_.data(); }
 	auto UniversalSolver::h()const noexcept->const double * { return imp_->h_.data(); }
+	auto UniversalSolver::warmStart()const->bool { return imp_->warm_start_; }
+	auto UniversalSolver::setWarmStart(bool warm_start)->void
+	{
+		imp_->warm_start_ = warm_start;
+		for (auto &sys : imp_->subsys_pool_) 
+		{
+			sys.has_factor_ = false;
+			sys.sol_count_ = 0;
+		}
+	}
+	auto UniversalSolver::threadNum()const->Size { return imp_->thread_num_; }
+	auto UniversalSolver::setThreadNum(Size thread_num)->void { imp_->thread_num_ = std::max(thread_num, Size(1)); }
+	auto UniversalSolver::threadCpus()const->const std::vector<int>& { return imp_->thread_cpus_; }
+	auto UniversalSolver::setThreadCpus(const std::vector<int> &cpus)->void { imp_->thread_cpus_ = cpus; }
+	auto UniversalSolver::threadPriority()const->int { return imp_->thread_priority_; }
+	auto UniversalSolver::setThreadPriority(int priority)->void { imp_->thread_priority_ = priority; }
 	auto UniversalSolver::plotRelation()->void
 	{
 		for (Size i = 0; i < imp_->subsys_pool_.size(); ++i)
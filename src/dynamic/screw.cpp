@@ -10,6 +10,10 @@
 #include <array>
 #include <list>
 
+#ifdef ARIS_USE_AVX2
+#include <immintrin.h>
+#endif
+
 #include "aris/dynamic/screw.hpp"
 
 namespace aris::dynamic
@@ -59,6 +63,62 @@ namespace aris::dynamic
 	auto inline P()noexcept->const double3x3& { static const double p[3][3]{ { 0, -1, 1 },{ 1, 0, -1 },{ -1, 1, 0 } }; return p; }
 	auto inline Q()noexcept->const double3x3& { static const double q[3][3]{ { 1, 0, 0 },{ 0, 1, 0 },{ 0, 0, 1 } };	return q; }
 
+#ifdef ARIS_USE_AVX2
+	// 连续存储时的定长核函数，位姿矩阵的每一行正好是4个double，三维向量只用前3个通道 //
+	namespace
+	{
+		auto inline avx_fmadd(__m256d a, __m256d b, __m256d c)noexcept->__m256d
+		{
+#if defined(__FMA__) || defined(_MSC_VER)
+			return _mm256_fmadd_pd(a, b, c);
+#else
+			return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+		}
+		auto inline avx_mask3()noexcept->__m256i { return _mm256_set_epi64x(0, -1, -1, -1); }
+		auto inline avx_load3(const double *v)noexcept->__m256d { return _mm256_maskload_pd(v, avx_mask3()); }
+		auto inline avx_store3(double *v, __m256d a)noexcept->void { _mm256_maskstore_pd(v, avx_mask3(), a); }
+		// a x b，(a * b.yzx - a.yzx * b).yzx //
+		auto inline avx_c3(__m256d a, __m256d b)noexcept->__m256d
+		{
+			const auto c = _mm256_sub_pd(_mm256_mul_pd(a, _mm256_permute4x64_pd(b, 0xC9)), _mm256_mul_pd(_mm256_permute4x64_pd(a, 0xC9), b));
+			return _mm256_permute4x64_pd(c, 0xC9);
+		}
+		// 读取位姿矩阵的前三列及位置，第4个通道为0 //
+		auto inline avx_pm_columns(const double *pm, __m256d &c0, __m256d &c1, __m256d &c2, __m256d &pp)noexcept->void
+		{
+			const auto r0 = _mm256_loadu_pd(pm), r1 = _mm256_loadu_pd(pm + 4), r2 = _mm256_loadu_pd(pm + 8), r3 = _mm256_setzero_pd();
+			const auto t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+			const auto t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+			c0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+			c1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+			c2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+			pp = _mm256_permute2f128_pd(t1, t3, 0x31);
+		}
+		// c0 * v[0] + c1 * v[1] + c2 * v[2] //
+		auto inline avx_rm_dot_v3(__m256d c0, __m256d c1, __m256d c2, const double *v)noexcept->__m256d
+		{
+			return avx_fmadd(c2, _mm256_broadcast_sd(v + 2), avx_fmadd(c1, _mm256_broadcast_sd(v + 1), _mm256_mul_pd(c0, _mm256_broadcast_sd(v))));
+		}
+		auto inline avx_pm_dot_pm(const double *pm1, const double *pm2, double *pm_out)noexcept->void
+		{
+			const auto r0 = _mm256_loadu_pd(pm2), r1 = _mm256_loadu_pd(pm2 + 4), r2 = _mm256_loadu_pd(pm2 + 8), r3 = _mm256_set_pd(1.0, 0.0, 0.0, 0.0);
+			__m256d out[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				out[i] = _mm256_mul_pd(r0, _mm256_broadcast_sd(pm1 + 4 * i));
+				out[i] = avx_fmadd(r1, _mm256_broadcast_sd(pm1 + 4 * i + 1), out[i]);
+				out[i] = avx_fmadd(r2, _mm256_broadcast_sd(pm1 + 4 * i + 2), out[i]);
+				out[i] = avx_fmadd(r3, _mm256_broadcast_sd(pm1 + 4 * i + 3), out[i]);
+			}
+			_mm256_storeu_pd(pm_out, out[0]);
+			_mm256_storeu_pd(pm_out + 4, out[1]);
+			_mm256_storeu_pd(pm_out + 8, out[2]);
+			_mm256_storeu_pd(pm_out + 12, r3);
+		}
+	}
+#endif
+
 	auto s_inv_pm(const double *pm_in, double *pm_out) noexcept->void
 	{
 		//转置
@@ -87,6 +147,9 @@ namespace aris::dynamic
 	{
 		pm_out = pm_out ? pm_out : default_out();
 
+#ifdef ARIS_USE_AVX2
+		avx_pm_dot_pm(pm1, pm2, pm_out);
+#else
 		pm_out[0] = pm1[0] * pm2[0] + pm1[1] * pm2[4] + pm1[2] * pm2[8];
 		pm_out[1] = pm1[0] * pm2[1] + pm1[1] * pm2[5] + pm1[2] * pm2[9];
 		pm_out[2] = pm1[0] * pm2[2] + pm1[1] * pm2[6] + pm1[2] * pm2[10];
@@ -106,6 +169,7 @@ namespace aris::dynamic
 		pm_out[13] = 0;
 		pm_out[14] = 0;
 		pm_out[15] = 1;
+#endif
 
 		return pm_out;
 	}
@@ -175,9 +239,16 @@ namespace aris::dynamic
 	{
 		v3_out = v3_out ? v3_out : default_out();
 
+#ifdef ARIS_USE_AVX2
+		auto out = _mm256_mul_pd(_mm256_loadu_pd(inv_pm), _mm256_broadcast_sd(v3));
+		out = avx_fmadd(_mm256_loadu_pd(inv_pm + 4), _mm256_broadcast_sd(v3 + 1), out);
+		out = avx_fmadd(_mm256_loadu_pd(inv_pm + 8), _mm256_broadcast_sd(v3 + 2), out);
+		avx_store3(v3_out, out);
+#else
 		v3_out[0] = inv_pm[0] * v3[0] + inv_pm[4] * v3[1] + inv_pm[8] * v3[2];
 		v3_out[1] = inv_pm[1] * v3[0] + inv_pm[5] * v3[1] + inv_pm[9] * v3[2];
 		v3_out[2] = inv_pm[2] * v3[0] + inv_pm[6] * v3[1] + inv_pm[10] * v3[2];
+#endif
 
 		return v3_out;
 	}
@@ -287,9 +358,15 @@ namespace aris::dynamic
 	}
 	auto s_cf(const double *vs, const double *fs, double* vfs_out) noexcept->void
 	{
+#ifdef ARIS_USE_AVX2
+		const auto v = avx_load3(vs), w = avx_load3(vs + 3), f = avx_load3(fs), m = avx_load3(fs + 3);
+		avx_store3(vfs_out, avx_c3(w, f));
+		avx_store3(vfs_out + 3, _mm256_add_pd(avx_c3(w, m), avx_c3(v, f)));
+#else
 		s_c3(vs + 3, fs, vfs_out);
 		s_c3(vs + 3, fs + 3, vfs_out + 3);
 		s_c3a(vs, fs, vfs_out + 3);
+#endif
 	}
 	auto s_cf(double alpha, const double *vs, const double *fs, double* vfs_out) noexcept->void
 	{
@@ -348,9 +425,15 @@ namespace aris::dynamic
 	}
 	auto s_cv(const double *vs, const double *vs2, double* vvs_out) noexcept->void
 	{
+#ifdef ARIS_USE_AVX2
+		const auto v = avx_load3(vs), w = avx_load3(vs + 3), v2 = avx_load3(vs2), w2 = avx_load3(vs2 + 3);
+		avx_store3(vvs_out, _mm256_add_pd(avx_c3(w, v2), avx_c3(v, w2)));
+		avx_store3(vvs_out + 3, avx_c3(w, w2));
+#else
 		s_c3(vs + 3, vs2, vvs_out);
 		s_c3(vs + 3, vs2 + 3, vvs_out + 3);
 		s_c3a(vs, vs2 + 3, vvs_out);
+#endif
 	}
 	auto s_cv(double alpha, const double *vs, const double *vs2, double* vvs_out) noexcept->void
 	{
@@ -407,9 +490,17 @@ namespace aris::dynamic
 	}
 	auto s_tf(const double *pm, const double *fs, double *fs_out) noexcept->void
 	{
+#ifdef ARIS_USE_AVX2
+		__m256d c0, c1, c2, pp;
+		avx_pm_columns(pm, c0, c1, c2, pp);
+		const auto f = avx_rm_dot_v3(c0, c1, c2, fs), m = avx_rm_dot_v3(c0, c1, c2, fs + 3);
+		avx_store3(fs_out, f);
+		avx_store3(fs_out + 3, _mm256_add_pd(m, avx_c3(pp, f)));
+#else
 		s_pm_dot_v3(pm, fs, fs_out);
 		s_pm_dot_v3(pm, fs + 3, fs_out + 3);
 		s_c3a(pm + 3, 4, fs_out, 1, fs_out + 3, 1);
+#endif
 	}
 	auto s_tf(double alpha, const double *pm, const double *fs, double *fs_out) noexcept->void
 	{
@@ -478,9 +569,17 @@ namespace aris::dynamic
 	}
 	auto s_tv(const double *pm, const double *vs, double *vs_out) noexcept->void
 	{
+#ifdef ARIS_USE_AVX2
+		__m256d c0, c1, c2, pp;
+		avx_pm_columns(pm, c0, c1, c2, pp);
+		const auto v = avx_rm_dot_v3(c0, c1, c2, vs), w = avx_rm_dot_v3(c0, c1, c2, vs + 3);
+		avx_store3(vs_out, _mm256_add_pd(v, avx_c3(pp, w)));
+		avx_store3(vs_out + 3, w);
+#else
 		s_pm_dot_v3(pm, vs, vs_out);
 		s_pm_dot_v3(pm, vs + 3, vs_out + 3);
 		s_c3a(pm + 3, 4, vs_out + 3, 1, vs_out, 1);
+#endif
 	}
 	auto s_tv(double alpha, const double *pm, const double *vs, double *vs_out) noexcept->void
 	{
@@ -2228,6 +2327,9 @@ namespace aris::dynamic
 		to_pm = to_pm ? to_pm : default_out();
 
 		// 正式开始计算 //
+#ifdef ARIS_USE_AVX2
+		avx_pm_dot_pm(relative_pm, from_pm, to_pm);
+#else
 		s_mm(3, 4, 3, relative_pm, 4, from_pm, 4, to_pm, 4);
 
 		to_pm[3] += relative_pm[3];
@@ -2238,6 +2340,7 @@ namespace aris::dynamic
 		to_pm[13] = 0;
 		to_pm[14] = 0;
 		to_pm[15] = 1;
+#endif
 
 		return to_pm;
 	}
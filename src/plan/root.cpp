@@ -1,6 +1,11 @@
 ﻿#include <algorithm>
 #include <future>
 #include <array>
+#include <mutex>
+#include <unordered_map>
+#include <sstream>
+#include <limits>
+#include <cmath>
 
 #include"aris/plan/function.hpp"
 #include"aris/plan/root.hpp"
@@ -20,13 +25,96 @@ namespace aris::plan
 	}
 	ARIS_DEFINE_BIG_FOUR_CPP(Plan);
 
-	struct PlanRoot::Imp { Imp() {} };
+	struct PlanRoot::Imp 
+	{
+		// 命令索引，建好后不再修改，解析时持有其 shared_ptr，因此重建时正在进行的解析不受影响 //
+		// signatures_ 为建立索引时各 plan 命令定义的摘要，命令改变后索引过期 //
+		struct Index
+		{
+			std::vector<Plan*> plans_;
+			std::vector<std::size_t> signatures_;
+			aris::core::CommandParser parser_;
+			std::unordered_map<std::string, std::size_t> plan_map_;
+		};
+
+		std::mutex mu_;
+		std::shared_ptr<Index> index_;
+
+		Imp() {}
+		Imp(const Imp &) {}
+		auto operator=(const Imp &)->Imp& { index_.reset(); return *this; }
+
+		// 返回有效的索引，cmd_name 为空时检查所有命令，否则只检查 planPool 的结构和该命令 //
+		auto index(PlanRoot &root, const std::string *cmd_name)->std::shared_ptr<Index>
+		{
+			std::shared_ptr<Index> index;
+			{
+				std::lock_guard<std::mutex> lck(mu_);
+				index = index_;
+			}
+
+			auto &pool = root.planPool();
+			auto is_valid = index && index->plans_.size() == pool.size()
+				&& std::equal(index->plans_.begin(), index->plans_.end(), pool.begin(), [](const Plan *a, const Plan &b) { return a == &b; });
+			if (is_valid && cmd_name)
+			{
+				// 找不到该命令时，可能是某个命令改了名 //
+				auto found = index->plan_map_.find(*cmd_name);
+				if (found != index->plan_map_.end())
+					is_valid = index->signatures_[found->second] == pool.at(found->second).command().signature();
+				else
+					for (aris::Size i = 0; is_valid && i < pool.size(); ++i)is_valid = index->parser_.commandPool().at(i).name() == pool.at(i).command().name();
+			}
+			else if (is_valid)
+			{
+				for (aris::Size i = 0; is_valid && i < pool.size(); ++i)is_valid = index->signatures_[i] == pool.at(i).command().signature();
+			}
+
+			if (!is_valid)
+			{
+				root.init();
+				std::lock_guard<std::mutex> lck(mu_);
+				index = index_;
+			}
+			return index;
+		}
+	};
 	auto PlanRoot::planPool()->aris::core::ObjectPool<Plan> & { return dynamic_cast<aris::core::ObjectPool<Plan> &>(children().front()); }
-	auto PlanRoot::planParser()->aris::core::CommandParser
+	auto PlanRoot::init()->void
 	{
-		aris::core::CommandParser parser;
-		for (auto &plan : planPool()) parser.commandPool().add<aris::core::Command>(plan.command());
-		return parser;
+		auto index = std::make_shared<Imp::Index>();
+		for (auto &plan : planPool())
+		{
+			index->plan_map_.emplace(plan.command().name(), index->plans_.size());
+			index->plans_.push_back(&plan);
+			index->signatures_.push_back(plan.command().signature());
+			index->parser_.commandPool().add<aris::core::Command>(plan.command());
+		}
+		index->parser_.init();
+
+		std::lock_guard<std::mutex> lck(imp_->mu_);
+		imp_->index_ = index;
+	}
+	auto PlanRoot::planParser()->std::shared_ptr<aris::core::CommandParser>
+	{
+		auto index = imp_->index(*this, nullptr);
+		return std::shared_ptr<aris::core::CommandParser>(index, &index->parser_);
+	}
+	auto PlanRoot::findPlan(const std::string &cmd_name)->Plan*
+	{
+		auto index = imp_->index(*this, &cmd_name);
+		auto found = index->plan_map_.find(cmd_name);
+		return found == index->plan_map_.end() ? nullptr : index->plans_[found->second];
+	}
+	auto PlanRoot::parse(const std::string &cmd_string, std::map<std::string, std::string> &param_map_out)->Plan*
+	{
+		std::string cmd_name;
+		std::stringstream(cmd_string) >> cmd_name;
+		auto index = imp_->index(*this, &cmd_name);
+
+		std::string cmd;
+		index->parser_.parse(cmd_string, cmd, param_map_out);
+		return index->plans_[index->plan_map_.at(cmd)];
 	}
 	PlanRoot::~PlanRoot() = default;
 	PlanRoot::PlanRoot(const std::string &name) :Object(name)
@@ -538,6 +626,10 @@ namespace aris::plan
 		set_active_motor(params, target, param);
 		param.limit_time = std::stoi(params.at("limit_time"));
 
+		// 所有电机的回零参数一起异步下载，再一起读回校验，不同电机的SDO可同时进行 //
+		struct HomeSdo { std::uint16_t index; std::uint8_t subindex; std::int32_t value; aris::Size byte_size; const char *name; };
+		struct HomeSdoRequest { HomeSdo sdo; std::shared_ptr<aris::control::SdoRequest> write, read; };
+		std::vector<HomeSdoRequest> requests;
 		for (aris::Size i = 0; i<param.active_motor.size(); ++i)
 		{
 			if (param.active_motor[i])
@@ -552,31 +644,30 @@ namespace aris::plan
 				std::uint32_t acc = std::stoi(params.at(std::string("acceleration")));
 
 				auto &cm = dynamic_cast<aris::control::EthercatMotion &>(target.controller->motionPool()[i]);
-			
-				cm.writeSdo(0x6098, 0x00, method);
-				std::int8_t method_read;
-				cm.readSdo(0x6098, 0x00, method_read);
-				if (method_read != method)throw std::runtime_error("home sdo write failed method");
-				cm.writeSdo(0x607C, 0x00, offset);
-				std::int32_t offset_read;
-				cm.readSdo(0x607C, 0x00, offset_read);
-				if (offset_read != offset)throw std::runtime_error("home sdo write failed offset");
-				cm.writeSdo(0x6099, 0x01, high_speed);
-				std::int32_t high_speed_read;
-				cm.readSdo(0x6099, 0x01, high_speed_read);
-				if (high_speed_read != high_speed)throw std::runtime_error("home sdo write failed high_speed");
-				cm.writeSdo(0x6099, 0x02, low_speed);
-				std::int32_t low_speed_read;
-				cm.readSdo(0x6099, 0x02, low_speed_read);
-				if (low_speed_read != low_speed)throw std::runtime_error("home sdo write failed low_speed");
-				cm.writeSdo(0x609A, 0x00, acc);
-				std::int32_t acc_read;
-				cm.readSdo(0x609A, 0x00, acc_read);
-				if (acc_read != acc)throw std::runtime_error("home sdo write failed acc");
-				
+				for (auto &sdo : {
+					HomeSdo{ 0x6098, 0x00, method, sizeof(method), "method" },
+					HomeSdo{ 0x607C, 0x00, offset, sizeof(offset), "offset" },
+					HomeSdo{ 0x6099, 0x01, static_cast<std::int32_t>(high_speed), sizeof(high_speed), "high_speed" },
+					HomeSdo{ 0x6099, 0x02, static_cast<std::int32_t>(low_speed), sizeof(low_speed), "low_speed" },
+					HomeSdo{ 0x609A, 0x00, static_cast<std::int32_t>(acc), sizeof(acc), "acc" } })
+				{
+					auto write = cm.writeSdoAsync(sdo.index, sdo.subindex, &sdo.value, sdo.byte_size);
+					requests.push_back(HomeSdoRequest{ sdo, write, cm.readSdoAsync(sdo.index, sdo.subindex, sdo.byte_size) });
+				}
 			}
 		}
-
+		// 写入本身失败时，读回的可能是从站原有的相同数值，因此写和读都要检查 //
+		for (auto &r : requests)
+		{
+			r.write->finished.wait();
+			r.read->finished.wait();
+			if (r.write->state != aris::control::SdoRequest::SUCCESS)
+				throw std::runtime_error(std::string("home sdo write failed ") + r.sdo.name + ", state:" + std::to_string(r.write->state.load()) + ", abort code:" + std::to_string(r.write->abort_code));
+
+			std::int32_t value_read = r.sdo.byte_size == 1 ? r.read->value<std::int8_t>() : r.read->value<std::int32_t>();
+			if (r.read->state != aris::control::SdoRequest::SUCCESS || value_read != r.sdo.value)
+				throw std::runtime_error(std::string("home sdo write failed ") + r.sdo.name);
+		}
 
 		target.param = param;
 	}
@@ -911,6 +1002,12 @@ namespace aris::plan
 		check_input_movement(params, target, param);
 
 		param.axis_begin_pos_vec.resize(target.controller->motionPool().size());
+
+		// 终点在规划前已知，未选中的电机不运动 //
+		target.blend_count = std::stoi(params.at("blend_count"));
+		target.blend_end_pos.assign(target.controller->motionPool().size(), std::numeric_limits<double>::quiet_NaN());
+		for (Size i = 0; i < param.active_motor.size(); ++i)if (param.active_motor[i])target.blend_end_pos[i] = param.axis_pos_vec[i];
+
 		target.param = param;
 	}
 	auto MoveAbsJ::executeRT(PlanTarget &target)->int
@@ -957,6 +1054,7 @@ namespace aris::plan
 			"		<Param name=\"vel\" default=\"1.0\"/>"
 			"		<Param name=\"acc\" default=\"1.0\"/>"
 			"		<Param name=\"dec\" default=\"1.0\"/>"
+			"		<Param name=\"blend_count\" default=\"0\"/>"
 					SELECT_MOTOR_STRING
 					CHECK_PARAM_STRING
 			"	</GroupParam>"
@@ -964,6 +1062,22 @@ namespace aris::plan
 	}
 	ARIS_DEFINE_BIG_FOUR_CPP(MoveAbsJ);
 
+	auto sync_model_to_target(PlanTarget &target)->bool
+	{
+		// 模型与电机目标位置不一致时（例如上一条指令直接控制电机，或混合时停在其终点），由正解把模型同步到电机目标位置 //
+		auto &mm = target.model->motionPool();
+		auto &cm = target.controller->motionPool();
+		bool is_synced = true;
+		for (Size i = 0; i < std::min(cm.size(), mm.size()); ++i)
+		{
+			if (std::abs(mm[i].mp() - cm[i].targetPos()) > 1e-10)is_synced = false;
+			mm[i].setMp(cm[i].targetPos());
+		}
+		if (is_synced)return true;
+
+		auto forward = std::find_if(target.model->solverPool().begin(), target.model->solverPool().end(), [](auto &s) { return dynamic_cast<aris::dynamic::ForwardKinematicSolver*>(&s); });
+		return forward != target.model->solverPool().end() && forward->kinPos();
+	}
 	auto check_eul_validity(const std::string &eul_type)->bool
 	{
 		if (eul_type.size()<3)return false;
@@ -1032,6 +1146,7 @@ namespace aris::plan
 	{
 		std::vector<double> joint_vel, joint_acc, joint_dec, ee_pq, joint_pos_begin, joint_pos_end;
 		std::vector<Size> total_count;
+		Size max_total_count;
 	};
 	struct MoveJ::Imp {};
 	auto MoveJ::prepairNrt(const std::map<std::string, std::string> &params, PlanTarget &target)->void
@@ -1048,6 +1163,10 @@ namespace aris::plan
 		mvj_param.joint_pos_end.resize(target.model->motionPool().size(), 0.0);
 		mvj_param.total_count.resize(target.model->motionPool().size(), 0);
 
+		// 终点在第一个周期反解后才能得到 //
+		target.blend_count = std::stoi(params.at("blend_count"));
+		target.blend_end_pos.assign(target.controller->motionPool().size(), std::numeric_limits<double>::quiet_NaN());
+
 		// find joint acc/vel/dec/
 		for (auto cmd_param : params)
 		{
@@ -1108,7 +1227,7 @@ namespace aris::plan
 
 		// 取得起始位置 //
 		double p, v, a;
-		static Size max_total_count;
+		auto &max_total_count = mvj_param->max_total_count;
 		if (target.count == 1)
 		{
 			// inverse kinematic //
@@ -1122,6 +1241,7 @@ namespace aris::plan
 			{
 				mvj_param->joint_pos_begin[i] = controller->motionPool()[i].targetPos();
 				mvj_param->joint_pos_end[i] = target.model->motionPool()[i].mp();
+				target.blend_end_pos[i] = mvj_param->joint_pos_end[i];
 				aris::plan::moveAbsolute(target.count, mvj_param->joint_pos_begin[i], mvj_param->joint_pos_end[i]
 					, mvj_param->joint_vel[i] / 1000, mvj_param->joint_acc[i] / 1000 / 1000, mvj_param->joint_dec[i] / 1000 / 1000
 					, p, v, a, mvj_param->total_count[i]);
@@ -1161,6 +1281,7 @@ namespace aris::plan
 			"		<Param name=\"joint_acc\" default=\"0.1\"/>"
 			"		<Param name=\"joint_vel\" default=\"0.1\"/>"
 			"		<Param name=\"joint_dec\" default=\"0.1\"/>"
+			"		<Param name=\"blend_count\" default=\"0\"/>"
 					CHECK_PARAM_STRING
 			"	</GroupParam>"
 			"</Command>");
@@ -1174,6 +1295,10 @@ namespace aris::plan
 
 		double acc, vel, dec;
 		double angular_acc, angular_vel, angular_dec;
+
+		// 混合时前后两条 mvl 交替执行，起点等状态不能放在静态变量中 //
+		double begin_pm[16], relative_pa[6], pos_ratio, ori_ratio, norm_pos, norm_ori;
+		Size pos_total_count, ori_total_count;
 	};
 	struct MoveL::Imp {};
 	auto MoveL::prepairNrt(const std::map<std::string, std::string> &params, PlanTarget &target)->void
@@ -1212,6 +1337,10 @@ namespace aris::plan
 			}
 		}
 
+		// 终点在第一个周期反解后才能得到 //
+		target.blend_count = std::stoi(params.at("blend_count"));
+		target.blend_end_pos.assign(target.controller->motionPool().size(), std::numeric_limits<double>::quiet_NaN());
+
 		target.option |= USE_TARGET_POS;
 		target.param = mvl_param;
 	}
@@ -1221,17 +1350,30 @@ namespace aris::plan
 		auto controller = target.controller;
 
 		// 取得起始位置 //
-		static double begin_pm[16], relative_pm[16], relative_pa[6], pos_ratio, ori_ratio, norm_pos, norm_ori;
+		auto &begin_pm = mvl_param->begin_pm;
+		auto &relative_pa = mvl_param->relative_pa;
+		auto &pos_ratio = mvl_param->pos_ratio, &ori_ratio = mvl_param->ori_ratio, &norm_pos = mvl_param->norm_pos, &norm_ori = mvl_param->norm_ori;
+		auto &pos_total_count = mvl_param->pos_total_count, &ori_total_count = mvl_param->ori_total_count;
 		double p, v, a;
-		aris::Size pos_total_count, ori_total_count;
 		if (target.count == 1)
 		{
-			double end_pm[16];
+			if (!sync_model_to_target(target))return -1;
+
+			double end_pm[16], relative_pm[16];
 			aris::dynamic::s_pq2pm(mvl_param->ee_pq.data(), end_pm);
 			target.model->generalMotionPool().at(0).updMpm();
 			target.model->generalMotionPool().at(0).getMpm(begin_pm);
 			aris::dynamic::s_inv_pm_dot_pm(begin_pm, end_pm, relative_pm);
 
+			// 反解终点，供混合使用 //
+			target.model->generalMotionPool().at(0).setMpm(end_pm);
+			if (!target.model->solverPool().at(0).kinPos())return -1;
+			for (Size i = 0; i < std::min(controller->motionPool().size(), target.model->motionPool().size()); ++i)
+				target.blend_end_pos[i] = target.model->motionPool()[i].mp();
+
+			// 恢复到起点构型，使第一个轨迹点仍从起点附近迭代，避免收敛到其他分支 //
+			if (!sync_model_to_target(target))return -1;
+
 			// relative_pa //
 			aris::dynamic::s_pm2pa(relative_pm, relative_pa);
 
@@ -1266,17 +1408,19 @@ namespace aris::plan
 		////////////////////////////////////// log ///////////////////////////////////////
 		double pq[7];
 		aris::dynamic::s_pm2pq(*target.model->generalMotionPool().at(0).mpm(), pq);
-		target.controller->lout() << target.count << " " << pq[0] << " " << pq[1] << " " << pq[2] << " " << pq[3] << " " << pq[4] << " " << pq[5] << " " << pq[6] << "  ";
+		target.controller->loutRecord("{} {} {} {} {} {} {} {}  ", target.count, pq[0], pq[1], pq[2], pq[3], pq[4], pq[5], pq[6]);
 
 		for (auto &cm : controller->motionPool())
 		{
-			target.controller->lout() << "  " << cm.targetPos() << "  " << cm.actualPos() << "  " << cm.actualVel() << "  " << cm.actualCur() << "  ";
+			target.controller->loutRecord("  {}  {}  {}  {}  ", cm.targetPos(), cm.actualPos(), cm.actualVel(), cm.actualCur());
 		}
-		target.controller->lout() << "\n";
+		target.controller->loutRecord("\n");
 		//////////////////////////////////////////////////////////////////////////////////
 
 
-		return std::max(pos_total_count, ori_total_count) > target.count ? 1 : 0;
+		// 返回剩余周期数，供混合使用 //
+		auto total_count = static_cast<std::int64_t>(std::max(pos_total_count, ori_total_count));
+		return static_cast<int>(std::max<std::int64_t>(total_count - static_cast<std::int64_t>(target.count), 0));
 	}
 	MoveL::~MoveL() = default;
 	MoveL::MoveL(const std::string &name) :Plan(name), imp_(new Imp)
@@ -1300,6 +1444,7 @@ namespace aris::plan
 			"		<Param name=\"angular_acc\" default=\"0.1\"/>"
 			"		<Param name=\"angular_vel\" default=\"0.1\"/>"
 			"		<Param name=\"angular_dec\" default=\"0.1\"/>"
+			"		<Param name=\"blend_count\" default=\"0\"/>"
 					CHECK_PARAM_STRING
 			"	</GroupParam>"
 			"</Command>");
@@ -1675,14 +1820,282 @@ namespace aris::plan
 	}
 	ARIS_DEFINE_BIG_FOUR_CPP(ManualMove);
 
+	struct StreamMoveParam
+	{
+		bool is_start, is_joint;
+		aris::Size dim, interval, max_latency, underrun_limit;
+		std::string eul_type;
+
+		// 实时线程中的插值状态，笛卡尔空间下存放位置与四元数 //
+		double prev[StreamMove::MAX_DIM], next[StreamMove::MAX_DIM];
+		aris::Size phase, underrun;
+
+		// 开启时占用流模式，释放时复位 is_running_ 与 is_accepting_ //
+		// 正常情况下在 collectNrt 中释放，若提交失败，则随 target 析构释放 //
+		std::shared_ptr<void> session;
+	};
+	auto stream_slerp(const double *q0, const double *q1, double t, double *q)->void
+	{
+		// 取最短路径，避免欧拉角在 ±π 处插值时的跳变 //
+		double dot = aris::dynamic::s_vv(4, q0, q1);
+		double sign = dot < 0.0 ? -1.0 : 1.0;
+		dot = std::min(std::abs(dot), 1.0);
+
+		double k0{ 1.0 - t }, k1{ t };
+		if (dot < 1.0 - 1e-10)
+		{
+			double theta = std::acos(dot);
+			k0 = std::sin((1.0 - t) * theta) / std::sin(theta);
+			k1 = std::sin(t * theta) / std::sin(theta);
+		}
+		for (int i = 0; i < 4; ++i)q[i] = k0 * q0[i] + sign * k1 * q1[i];
+		aris::dynamic::s_nv(4, 1.0 / aris::dynamic::s_norm(4, q), q);
+	}
+	struct StreamMove::Imp
+	{
+		// is_running_ 在开启时置位，实时部分结束并收集后复位；is_accepting_ 在终止时复位，此后不再接受设定点 //
+		static std::atomic_bool is_running_, is_accepting_;
+		static std::atomic<aris::Size> dim_, underrun_count_, dropped_count_;
+
+		// 单生产者单消费者的环形队列，生产者之间用 push_mutex_ 互斥，实时线程只做原子读写 //
+		static std::mutex push_mutex_;
+		static std::atomic<aris::Size> head_, tail_;
+		static double ring_[RING_SIZE][MAX_DIM];
+
+		static auto pop(double *setpoint, aris::Size dim, aris::Size max_latency)->bool
+		{
+			auto head = head_.load(std::memory_order_relaxed);
+			auto tail = tail_.load(std::memory_order_acquire);
+			if (head == tail)return false;
+
+			// 积压过多时跳过最旧的设定点，使延迟不超过 max_latency 个设定点 //
+			if (tail - head > max_latency)
+			{
+				dropped_count_.fetch_add(tail - head - max_latency, std::memory_order_relaxed);
+				head = tail - max_latency;
+			}
+
+			std::copy_n(ring_[head % RING_SIZE], dim, setpoint);
+			head_.store(head + 1, std::memory_order_release);
+			return true;
+		}
+	};
+	std::atomic_bool StreamMove::Imp::is_running_ = false;
+	std::atomic_bool StreamMove::Imp::is_accepting_ = false;
+	std::atomic<aris::Size> StreamMove::Imp::dim_ = 0;
+	std::atomic<aris::Size> StreamMove::Imp::underrun_count_ = 0;
+	std::atomic<aris::Size> StreamMove::Imp::dropped_count_ = 0;
+	std::mutex StreamMove::Imp::push_mutex_;
+	std::atomic<aris::Size> StreamMove::Imp::head_ = 0;
+	std::atomic<aris::Size> StreamMove::Imp::tail_ = 0;
+	double StreamMove::Imp::ring_[StreamMove::RING_SIZE][StreamMove::MAX_DIM];
+	auto StreamMove::pushSetpoint(const double *setpoint, aris::Size count)->aris::Size
+	{
+		std::lock_guard<std::mutex> lck(Imp::push_mutex_);
+		if (!Imp::is_accepting_.load())return 0;
+
+		auto dim = Imp::dim_.load();
+		auto tail = Imp::tail_.load(std::memory_order_relaxed);
+		aris::Size i{ 0 };
+		for (; i < count && tail - Imp::head_.load(std::memory_order_acquire) < RING_SIZE; ++i, ++tail)
+		{
+			std::copy_n(setpoint + i * dim, dim, Imp::ring_[tail % RING_SIZE]);
+			Imp::tail_.store(tail + 1, std::memory_order_release);
+		}
+		return i;
+	}
+	auto StreamMove::pendingSetpoint()->aris::Size { return Imp::tail_.load() - Imp::head_.load(); }
+	auto StreamMove::underrunCount()->aris::Size { return Imp::underrun_count_.load(); }
+	auto StreamMove::droppedCount()->aris::Size { return Imp::dropped_count_.load(); }
+	auto StreamMove::prepairNrt(const std::map<std::string, std::string> &params, PlanTarget &target)->void
+	{
+		set_check_option(params, target);
+
+		target.option = 0;
+
+		StreamMoveParam param;
+		param.is_start = false;
+		for (auto cmd_param : params)
+		{
+			if (cmd_param.first == "start")
+			{
+				if (bool expected = false; !Imp::is_running_.compare_exchange_strong(expected, true))throw std::runtime_error("stream mode already started");
+				param.session = std::shared_ptr<void>(nullptr, [](void*)
+				{
+					Imp::is_accepting_.store(false);
+					Imp::is_running_.store(false);
+				});
+
+				param.is_start = true;
+				param.is_joint = params.at("space") == "joint";
+				if (param.is_joint)
+				{
+					param.dim = target.model->motionPool().size();
+					if (param.dim > MAX_DIM)THROW_FILE_AND_LINE("too many motions for stream mode");
+				}
+				else if (params.at("space") == "pe")
+				{
+					param.dim = 6;
+					param.eul_type = params.at("eul_type");
+					if (!check_eul_validity(param.eul_type))THROW_FILE_AND_LINE("");
+				}
+				else THROW_FILE_AND_LINE("invalid space : " + params.at("space"));
+
+				param.interval = std::stoi(params.at("interval"));
+				param.max_latency = std::stoi(params.at("max_latency"));
+				param.underrun_limit = std::stoi(params.at("underrun_limit"));
+				if (param.interval < 1 || param.interval > 1e5)THROW_FILE_AND_LINE("");
+				if (param.max_latency < 1 || param.max_latency > RING_SIZE)THROW_FILE_AND_LINE("");
+
+				// 上一次的实时部分已结束，可以安全地清空队列 //
+				{
+					std::lock_guard<std::mutex> lck(Imp::push_mutex_);
+					Imp::head_.store(Imp::tail_.load());
+					Imp::dim_.store(param.dim);
+					Imp::underrun_count_.store(0);
+					Imp::dropped_count_.store(0);
+					Imp::is_accepting_.store(true);
+				}
+				target.option |= EXECUTE_WHEN_ALL_PLAN_COLLECTED | NOT_PRINT_EXECUTE_COUNT | USE_TARGET_POS;
+			}
+			else if (cmd_param.first == "stop")
+			{
+				if (!Imp::is_accepting_.load())throw std::runtime_error("stream mode not started, when stop");
+
+				Imp::is_accepting_.store(false);
+				target.option |= NOT_RUN_EXECUTE_FUNCTION | NOT_RUN_COLLECT_FUNCTION;
+			}
+			else if (cmd_param.first == "data")
+			{
+				if (!Imp::is_accepting_.load())throw std::runtime_error("stream mode not started, when data");
+
+				auto mat = target.model->calculator().calculateExpression(params.at("data"));
+				auto dim = Imp::dim_.load();
+				if (dim == 0 || mat.size() % dim != 0)THROW_FILE_AND_LINE("invalid setpoint size");
+				if (pushSetpoint(mat.data(), mat.size() / dim) < mat.size() / dim)throw std::runtime_error("stream queue is full");
+
+				target.option |= NOT_RUN_EXECUTE_FUNCTION | NOT_RUN_COLLECT_FUNCTION | NOT_PRINT_CMD_INFO | NOT_LOG_CMD_INFO;
+			}
+		}
+
+		target.option |= NOT_CHECK_POS_FOLLOWING_ERROR;
+		target.param = param;
+	}
+	auto StreamMove::executeRT(PlanTarget &target)->int
+	{
+		auto param = std::any_cast<StreamMoveParam>(&target.param);
+		auto &gm = target.model->generalMotionPool();
+
+		// 从当前位置开始 //
+		if (target.count == 1)
+		{
+			if (param->is_joint)
+			{
+				for (Size i = 0; i < param->dim; ++i)
+					param->next[i] = i < target.controller->motionPool().size() ? target.controller->motionPool()[i].targetPos() : target.model->motionPool()[i].mp();
+			}
+			else
+			{
+				if (!sync_model_to_target(target))return -1;
+				gm.at(0).updMpm();
+				gm.at(0).getMpq(param->next);
+			}
+			std::copy_n(param->next, MAX_DIM, param->prev);
+			param->phase = param->interval;
+			param->underrun = 0;
+		}
+
+		// 上一段插值结束，取下一个设定点 //
+		if (param->phase >= param->interval)
+		{
+			double setpoint[MAX_DIM];
+			if (Imp::pop(setpoint, param->dim, param->max_latency))
+			{
+				std::copy_n(param->next, MAX_DIM, param->prev);
+				if (param->is_joint)std::copy_n(setpoint, param->dim, param->next);
+				else aris::dynamic::s_pe2pq(setpoint, param->next, param->eul_type.c_str());
+				param->phase = 0;
+				param->underrun = 0;
+			}
+			// 队列为空：已终止时结束，否则保持在最后一个设定点 //
+			else
+			{
+				if (!Imp::is_accepting_.load())return 0;
+
+				Imp::underrun_count_.fetch_add(1, std::memory_order_relaxed);
+				if (param->underrun_limit && ++param->underrun > param->underrun_limit)
+				{
+					target.controller->mout() << "stream underrun for " << param->underrun_limit << " counts, stream stopped\n";
+					return 0;
+				}
+			}
+		}
+
+		if (param->phase < param->interval)++param->phase;
+		const double t = static_cast<double>(param->phase) / param->interval;
+		double pos[MAX_DIM];
+
+		// 关节空间线性插值，笛卡尔空间位置线性插值、姿态球面插值 //
+		if (param->is_joint)
+		{
+			for (Size i = 0; i < param->dim; ++i)
+				target.model->motionPool()[i].setMp(param->prev[i] + (param->next[i] - param->prev[i]) * t);
+		}
+		else
+		{
+			for (Size i = 0; i < 3; ++i)pos[i] = param->prev[i] + (param->next[i] - param->prev[i]) * t;
+			stream_slerp(param->prev + 3, param->next + 3, t, pos + 3);
+			gm.at(0).setMpq(pos);
+			if (!target.model->solverPool().at(0).kinPos())return -1;
+		}
+
+		return 1;
+	}
+	auto StreamMove::collectNrt(PlanTarget &target)->void
+	{
+		std::any_cast<StreamMoveParam>(&target.param)->session.reset();
+	}
+	StreamMove::~StreamMove() = default;
+	StreamMove::StreamMove(const std::string &name) : Plan(name), imp_(new Imp)
+	{
+		command().loadXmlStr(
+			"<Command name=\"stm\">"
+			"	<GroupParam>"
+			"		<UniqueParam default=\"start_group\">"
+			"			<GroupParam name=\"start_group\">"
+			"				<Param name=\"start\"/>"
+			"				<Param name=\"space\" default=\"joint\"/>"
+			"				<Param name=\"eul_type\" default=\"321\"/>"
+			"				<Param name=\"interval\" default=\"1\"/>"
+			"				<Param name=\"max_latency\" default=\"100\"/>"
+			"				<Param name=\"underrun_limit\" default=\"1000\"/>"
+			"			</GroupParam>"
+			"			<Param name=\"stop\"/>"
+			"			<Param name=\"data\" default=\"{0}\"/>"
+			"		</UniqueParam>"
+					CHECK_PARAM_STRING
+			"	</GroupParam>"
+			"</Command>");
+	}
+	ARIS_DEFINE_BIG_FOUR_CPP(StreamMove);
+
 	auto GetPartPq::prepairNrt(const std::map<std::string, std::string> &params, PlanTarget &target)->void
 	{
+		// 优先使用实时快照，不必等待实时线程 //
+		aris::server::RtSnapshot snapshot;
 		auto pm = std::make_any<std::vector<double> >(target.model->partPool().size() * 16);
-		target.server->getRtData([](aris::server::ControlServer& cs, std::any& data)
+		if (target.server->rtSnapshot(snapshot) && snapshot.part_pm.size() == target.model->partPool().size() * 16)
 		{
-			for (aris::Size i(-1); ++i < cs.model().partPool().size();)
-				cs.model().partPool().at(i).getPm(std::any_cast<std::vector<double>& >(data).data() + i * 16);
-		}, pm);
+			pm = snapshot.part_pm;
+		}
+		else
+		{
+			target.server->getRtData([](aris::server::ControlServer& cs, std::any& data)
+			{
+				for (aris::Size i(-1); ++i < cs.model().partPool().size();)
+					cs.model().partPool().at(i).getPm(std::any_cast<std::vector<double>& >(data).data() + i * 16);
+			}, pm);
+		}
 
 		auto pq = std::vector<double>(target.model->partPool().size() * 7);
 
@@ -134,6 +134,7 @@ namespace aris::robot
 
 		plan_root->planPool().add<aris::plan::MoveL>();
 		plan_root->planPool().add<aris::plan::MoveJ>();
+		plan_root->planPool().add<aris::plan::StreamMove>();
 
 		plan_root->planPool().add<aris::plan::GetPartPq>();
 		plan_root->planPool().add<aris::plan::GetXml>();
@@ -0,0 +1,211 @@
+#include <cmath>
+#include <algorithm>
+
+#include "aris/server/motion_checker.hpp"
+#include "aris/plan/root.hpp"
+
+namespace aris::server
+{
+	// 每一项检查对应的 option，count 不大于 start_count 时使用 not_check_at_start //
+	struct CheckItem
+	{
+		std::uint32_t violation;
+		std::uint64_t not_check, not_check_at_start;
+		std::uint32_t start_count;
+		const char *name;
+	};
+	const CheckItem check_items[]
+	{
+		{ MotionChecker::POS_MAX, aris::plan::Plan::NOT_CHECK_POS_MAX, aris::plan::Plan::NOT_CHECK_POS_MAX, 0, "position beyond MAX" },
+		{ MotionChecker::POS_MIN, aris::plan::Plan::NOT_CHECK_POS_MIN, aris::plan::Plan::NOT_CHECK_POS_MIN, 0, "position beyond MIN" },
+		{ MotionChecker::POS_CONTINUOUS, aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS, aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_AT_START, 1, "position NOT CONTINUOUS" },
+		{ MotionChecker::POS_CONTINUOUS_SECOND_ORDER, aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_SECOND_ORDER, aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_SECOND_ORDER_AT_START, 2, "position NOT SECOND CONTINUOUS" },
+		{ MotionChecker::POS_FOLLOWING_ERROR, aris::plan::Plan::NOT_CHECK_POS_FOLLOWING_ERROR, aris::plan::Plan::NOT_CHECK_POS_FOLLOWING_ERROR, 0, "position has FOLLOW ERROR" },
+		{ MotionChecker::VEL_MAX, aris::plan::Plan::NOT_CHECK_VEL_MAX, aris::plan::Plan::NOT_CHECK_VEL_MAX, 0, "velocity beyond MAX" },
+		{ MotionChecker::VEL_MIN, aris::plan::Plan::NOT_CHECK_VEL_MIN, aris::plan::Plan::NOT_CHECK_VEL_MIN, 0, "velocity beyond MIN" },
+		{ MotionChecker::VEL_CONTINUOUS, aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS, aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS_AT_START, 1, "velocity NOT CONTINUOUS" },
+		{ MotionChecker::VEL_FOLLOWING_ERROR, aris::plan::Plan::NOT_CHECK_VEL_FOLLOWING_ERROR, aris::plan::Plan::NOT_CHECK_VEL_FOLLOWING_ERROR, 0, "velocity has FOLLOW ERROR" },
+	};
+	// 各运行模式下需要检查的项，8:位置 9:速度 10:电流 //
+	const std::uint32_t POS_MODE_CHECKS = MotionChecker::POS_MAX | MotionChecker::POS_MIN | MotionChecker::POS_CONTINUOUS | MotionChecker::POS_CONTINUOUS_SECOND_ORDER | MotionChecker::POS_FOLLOWING_ERROR;
+	const std::uint32_t VEL_MODE_CHECKS = MotionChecker::VEL_MAX | MotionChecker::VEL_MIN | MotionChecker::VEL_CONTINUOUS | MotionChecker::VEL_FOLLOWING_ERROR;
+	const std::uint32_t CUR_MODE_CHECKS = MotionChecker::POS_MAX | MotionChecker::POS_MIN | MotionChecker::VEL_MAX | MotionChecker::VEL_MIN | MotionChecker::VEL_CONTINUOUS;
+
+	struct MotionChecker::Imp
+	{
+		std::vector<aris::control::Motion*> motions_;
+
+		// 限位 //
+		std::vector<double> max_pos_, min_pos_, max_vel_, min_vel_, max_acc_, min_acc_, max_pfe_, max_vfe_;
+		// 本周期状态 //
+		std::vector<std::uint16_t> status_word_;
+		std::vector<std::uint8_t> mode_of_operation_, mode_of_display_;
+		std::vector<double> target_pos_, target_vel_, target_cur_, actual_pos_, actual_vel_;
+		// 上一次及上上次的指令 //
+		std::vector<double> last_p_, last_v_, last_c_, last_last_p_, last_last_v_, last_last_c_;
+
+		std::vector<std::uint32_t> violation_;
+		aris::Size first_axis_{ 0 };
+	};
+	auto MotionChecker::enabledMask(std::uint64_t option, std::uint32_t count)->std::uint32_t
+	{
+		std::uint32_t mask{ 0 };
+		for (auto &item : check_items)
+			if (!(option & (count > item.start_count ? item.not_check : item.not_check_at_start)))mask |= item.violation;
+		return mask;
+	}
+	auto MotionChecker::violationName(std::uint32_t violation)->const char*
+	{
+		auto found = std::find_if(std::begin(check_items), std::end(check_items), [violation](const auto &item) { return item.violation & violation; });
+		return found == std::end(check_items) ? "" : found->name;
+	}
+	auto MotionChecker::resize(aris::Size axis_num)->void
+	{
+		for (auto v : { &imp_->max_pos_, &imp_->min_pos_, &imp_->max_vel_, &imp_->min_vel_, &imp_->max_acc_, &imp_->min_acc_, &imp_->max_pfe_, &imp_->max_vfe_
+			, &imp_->target_pos_, &imp_->target_vel_, &imp_->target_cur_, &imp_->actual_pos_, &imp_->actual_vel_
+			, &imp_->last_p_, &imp_->last_v_, &imp_->last_c_, &imp_->last_last_p_, &imp_->last_last_v_, &imp_->last_last_c_ })
+		{
+			v->assign(axis_num, 0.0);
+		}
+		imp_->status_word_.assign(axis_num, 0);
+		imp_->mode_of_operation_.assign(axis_num, 0);
+		imp_->mode_of_display_.assign(axis_num, 0);
+		imp_->violation_.assign(axis_num, 0);
+		imp_->first_axis_ = axis_num;
+	}
+	auto MotionChecker::axisNum()const->aris::Size { return imp_->violation_.size(); }
+	auto MotionChecker::limits(aris::Size i)const->Limits
+	{
+		return Limits{ imp_->max_pos_.at(i), imp_->min_pos_.at(i), imp_->max_vel_.at(i), imp_->min_vel_.at(i), imp_->max_acc_.at(i), imp_->min_acc_.at(i), imp_->max_pfe_.at(i), imp_->max_vfe_.at(i) };
+	}
+	auto MotionChecker::setLimits(aris::Size i, const Limits &limits)->void
+	{
+		imp_->max_pos_.at(i) = limits.max_pos;
+		imp_->min_pos_.at(i) = limits.min_pos;
+		imp_->max_vel_.at(i) = limits.max_vel;
+		imp_->min_vel_.at(i) = limits.min_vel;
+		imp_->max_acc_.at(i) = limits.max_acc;
+		imp_->min_acc_.at(i) = limits.min_acc;
+		imp_->max_pfe_.at(i) = limits.max_pos_following_error;
+		imp_->max_vfe_.at(i) = limits.max_vel_following_error;
+	}
+	auto MotionChecker::state(aris::Size i)const->State
+	{
+		return State{ imp_->status_word_.at(i), imp_->mode_of_operation_.at(i), imp_->mode_of_display_.at(i)
+			, imp_->target_pos_.at(i), imp_->target_vel_.at(i), imp_->target_cur_.at(i), imp_->actual_pos_.at(i), imp_->actual_vel_.at(i) };
+	}
+	auto MotionChecker::setState(aris::Size i, const State &state)->void
+	{
+		imp_->status_word_.at(i) = state.status_word;
+		imp_->mode_of_operation_.at(i) = state.mode_of_operation;
+		imp_->mode_of_display_.at(i) = state.mode_of_display;
+		imp_->target_pos_.at(i) = state.target_pos;
+		imp_->target_vel_.at(i) = state.target_vel;
+		imp_->target_cur_.at(i) = state.target_cur;
+		imp_->actual_pos_.at(i) = state.actual_pos;
+		imp_->actual_vel_.at(i) = state.actual_vel;
+	}
+	auto MotionChecker::lastPvc(aris::Size i)const->std::array<double, 3> { return { imp_->last_p_.at(i), imp_->last_v_.at(i), imp_->last_c_.at(i) }; }
+	auto MotionChecker::lastLastPvc(aris::Size i)const->std::array<double, 3> { return { imp_->last_last_p_.at(i), imp_->last_last_v_.at(i), imp_->last_last_c_.at(i) }; }
+	auto MotionChecker::resetHistory(aris::Size i, double p, double v, double c)->void
+	{
+		imp_->last_p_.at(i) = imp_->last_last_p_.at(i) = p;
+		imp_->last_v_.at(i) = imp_->last_last_v_.at(i) = v;
+		imp_->last_c_.at(i) = imp_->last_last_c_.at(i) = c;
+	}
+	auto MotionChecker::bind(aris::control::Controller &controller)->void
+	{
+		std::vector<aris::Size> motions;
+		for (auto &s : controller.slavePool())if (dynamic_cast<aris::control::Motion*>(&s))motions.push_back(motions.size());
+		bind(controller, motions);
+	}
+	auto MotionChecker::bind(aris::control::Controller &controller, const std::vector<aris::Size> &motions)->void
+	{
+		std::vector<aris::control::Motion*> all;
+		for (auto &s : controller.slavePool())if (auto cm = dynamic_cast<aris::control::Motion*>(&s))all.push_back(cm);
+
+		imp_->motions_.clear();
+		for (auto id : motions)imp_->motions_.push_back(all.at(id));
+
+		resize(imp_->motions_.size());
+		for (aris::Size i = 0; i < imp_->motions_.size(); ++i)
+		{
+			auto cm = imp_->motions_[i];
+			setLimits(i, Limits{ cm->maxPos(), cm->minPos(), cm->maxVel(), cm->minVel(), cm->maxAcc(), cm->minAcc(), cm->maxPosFollowingError(), cm->maxVelFollowingError() });
+		}
+	}
+	auto MotionChecker::loadState()->void
+	{
+		auto &d = *imp_;
+		for (aris::Size i = 0; i < d.motions_.size(); ++i)
+		{
+			auto cm = d.motions_[i];
+			d.status_word_[i] = cm->statusWord();
+			d.mode_of_operation_[i] = cm->modeOfOperation();
+			d.target_pos_[i] = cm->targetPos();
+			d.target_vel_[i] = cm->targetVel();
+			d.target_cur_[i] = cm->targetCur();
+
+			// 只读取当前模式需要检查的反馈量，未映射的pdo不会被访问 //
+			if ((d.status_word_[i] & 0x6f) != 0x27)continue;
+			d.mode_of_display_[i] = d.mode_of_operation_[i] == 8 ? 8 : cm->modeOfDisplay();
+			if (d.mode_of_display_[i] == 8 || d.mode_of_display_[i] == 10)d.actual_pos_[i] = cm->actualPos();
+			if (d.mode_of_display_[i] == 9 || d.mode_of_display_[i] == 10)d.actual_vel_[i] = cm->actualVel();
+		}
+	}
+	auto MotionChecker::check(std::uint64_t option, std::uint32_t count)->std::uint32_t
+	{
+		auto &d = *imp_;
+		const auto enabled = enabledMask(option, count);
+		const auto n = d.violation_.size();
+
+		// 所有比较都按位组合，循环体内没有数据相关的分支 //
+		std::uint32_t all{ 0 };
+		for (aris::Size i = 0; i < n; ++i)
+		{
+			const std::uint32_t is_op = (d.status_word_[i] & 0x6f) == 0x27;
+			const std::uint32_t is_pos = is_op & (d.mode_of_operation_[i] == 8);
+			const std::uint32_t is_vel = is_op & (is_pos ^ 1) & (d.mode_of_display_[i] == 9);
+			const std::uint32_t is_cur = is_op & (is_pos ^ 1) & (is_vel ^ 1) & (d.mode_of_display_[i] == 10);
+
+			// 电流模式下检查实际位置与速度 //
+			const double p = is_cur ? d.actual_pos_[i] : d.target_pos_[i];
+			const double v = is_cur ? d.actual_vel_[i] : d.target_vel_[i];
+			const double dp = d.target_pos_[i] - d.last_p_[i];
+			const double ddp = d.target_pos_[i] + d.last_last_p_[i] - 2 * d.last_p_[i];
+			const double dv = v - d.last_v_[i];
+
+			std::uint32_t m{ 0 };
+			m |= std::uint32_t(p > d.max_pos_[i]) * POS_MAX;
+			m |= std::uint32_t(p < d.min_pos_[i]) * POS_MIN;
+			m |= std::uint32_t((dp > 0.001 * d.max_vel_[i]) | (dp < 0.001 * d.min_vel_[i])) * POS_CONTINUOUS;
+			m |= std::uint32_t((ddp > 1e-6 * d.max_acc_[i]) | (ddp < 1e-6 * d.min_acc_[i])) * POS_CONTINUOUS_SECOND_ORDER;
+			m |= std::uint32_t(std::abs(d.target_pos_[i] - d.actual_pos_[i]) > d.max_pfe_[i]) * POS_FOLLOWING_ERROR;
+			m |= std::uint32_t(v > d.max_vel_[i]) * VEL_MAX;
+			m |= std::uint32_t(v < d.min_vel_[i]) * VEL_MIN;
+			m |= std::uint32_t((dv > 0.001 * d.max_acc_[i]) | (dv < 0.001 * d.min_acc_[i])) * VEL_CONTINUOUS;
+			m |= std::uint32_t(std::abs(d.target_vel_[i] - d.actual_vel_[i]) > d.max_vfe_[i]) * VEL_FOLLOWING_ERROR;
+
+			const std::uint32_t mode_mask = ((0u - is_pos) & POS_MODE_CHECKS) | ((0u - is_vel) & VEL_MODE_CHECKS) | ((0u - is_cur) & CUR_MODE_CHECKS);
+			d.violation_[i] = m & mode_mask & enabled;
+			all |= d.violation_[i];
+		}
+
+		d.first_axis_ = all ? std::find_if(d.violation_.begin(), d.violation_.end(), [](std::uint32_t v) { return v != 0; }) - d.violation_.begin() : n;
+		return all;
+	}
+	auto MotionChecker::violation(aris::Size i)const->std::uint32_t { return imp_->violation_.at(i); }
+	auto MotionChecker::firstAxis()const->aris::Size { return imp_->first_axis_; }
+	auto MotionChecker::commit()->void
+	{
+		std::swap(imp_->last_p_, imp_->last_last_p_);
+		std::swap(imp_->last_v_, imp_->last_last_v_);
+		std::swap(imp_->last_c_, imp_->last_last_c_);
+		std::copy(imp_->target_pos_.begin(), imp_->target_pos_.end(), imp_->last_p_.begin());
+		std::copy(imp_->target_vel_.begin(), imp_->target_vel_.end(), imp_->last_v_.begin());
+		std::copy(imp_->target_cur_.begin(), imp_->target_cur_.end(), imp_->last_c_.begin());
+	}
+	MotionChecker::~MotionChecker() = default;
+	MotionChecker::MotionChecker() :imp_(new Imp) {}
+	ARIS_DEFINE_BIG_FOUR_CPP(MotionChecker);
+}
@@ -0,0 +1,37 @@
+#include <sstream>
+
+#include "aris/server/motion_group.hpp"
+
+namespace aris::server
+{
+	struct MotionGroup::Imp
+	{
+		std::vector<aris::Size> motions_;
+	};
+	auto MotionGroup::loadXml(const aris::core::XmlElement &xml_ele)->void
+	{
+		Object::loadXml(xml_ele);
+
+		// motions="0 1 2" //
+		std::vector<aris::Size> motions;
+		std::stringstream ss(attributeString(xml_ele, "motions", ""));
+		for (std::string word; ss >> word;)motions.push_back(std::stoul(word));
+		setMotions(motions);
+	}
+	auto MotionGroup::saveXml(aris::core::XmlElement &xml_ele) const->void
+	{
+		Object::saveXml(xml_ele);
+
+		std::string motions;
+		for (auto id : imp_->motions_)motions += (motions.empty() ? "" : " ") + std::to_string(id);
+		xml_ele.SetAttribute("motions", motions.c_str());
+	}
+	auto MotionGroup::motions()const->const std::vector<aris::Size>& { return imp_->motions_; }
+	auto MotionGroup::setMotions(const std::vector<aris::Size> &motions)->void { imp_->motions_ = motions; }
+	MotionGroup::~MotionGroup() = default;
+	MotionGroup::MotionGroup(const std::string &name, const std::vector<aris::Size> &motions) :Object(name), imp_(new Imp)
+	{
+		imp_->motions_ = motions;
+	}
+	ARIS_DEFINE_BIG_FOUR_CPP(MotionGroup);
+}
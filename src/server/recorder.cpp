@@ -0,0 +1,418 @@
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "aris/server/recorder.hpp"
+
+namespace aris::server
+{
+	struct ChannelTypeName { Recorder::ChannelType type; const char *name; aris::Size column_size; };
+	const ChannelTypeName channel_type_names[]
+	{
+		{ Recorder::TARGET_POS, "target_pos", 1 },
+		{ Recorder::TARGET_VEL, "target_vel", 1 },
+		{ Recorder::TARGET_CUR, "target_cur", 1 },
+		{ Recorder::ACTUAL_POS, "actual_pos", 1 },
+		{ Recorder::ACTUAL_VEL, "actual_vel", 1 },
+		{ Recorder::ACTUAL_CUR, "actual_cur", 1 },
+		{ Recorder::MODEL_MP, "mp", 1 },
+		{ Recorder::MODEL_MV, "mv", 1 },
+		{ Recorder::MODEL_MF, "mf", 1 },
+		{ Recorder::PART_PQ, "part_pq", 7 },
+	};
+	auto channelTypeName(Recorder::ChannelType type)->const ChannelTypeName&
+	{
+		return *std::find_if(std::begin(channel_type_names), std::end(channel_type_names), [type](const auto &n) {return n.type == type; });
+	}
+
+	struct Recorder::Imp
+	{
+		// 展开后的一个通道，实时线程按顺序依次写入 //
+		struct Item
+		{
+			ChannelType type;
+			aris::control::Motion *cm;
+			aris::dynamic::Motion *mm;
+			aris::dynamic::Part *part;
+		};
+
+		// 每个运动组正在写的文件，运动组的指令改变时换新文件 //
+		struct Stream
+		{
+			std::ofstream file;
+			std::int64_t command_id{ 0 };
+			bool is_open{ false }, is_failed{ false };
+			std::vector<double> block;
+			aris::Size row_count{ 0 }, written_count{ 0 };  // 当前block中的行数，以及其中已计入 written_rows_ 的行数 //
+			std::streampos block_pos;
+		};
+
+		auto set_error(const std::string &error)->void
+		{
+			LOG_ERROR << error << std::endl;
+			std::lock_guard<std::mutex> lck(mu_);
+			last_error_ = error;
+		}
+		auto write_block(Stream &s)->void
+		{
+			if (s.is_failed)return;
+
+			auto row_count = static_cast<std::int64_t>(s.row_count);
+			s.file.seekp(s.block_pos);
+			s.file.write(reinterpret_cast<const char*>(&row_count), sizeof(std::int64_t));
+			s.file.write(reinterpret_cast<const char*>(s.block.data()), s.block.size() * sizeof(double));
+
+			if (s.file.good())
+			{
+				written_rows_.fetch_add(s.row_count - s.written_count, std::memory_order_relaxed);
+			}
+			else
+			{
+				failed_rows_.fetch_add(s.row_count - s.written_count, std::memory_order_relaxed);
+				s.is_failed = true;
+				set_error("recorder failed to write file of command " + std::to_string(s.command_id));
+			}
+			s.written_count = s.row_count;
+		}
+		auto open_file(Stream &s, std::int64_t command_id)->void
+		{
+			s.is_open = true;
+			s.is_failed = false;
+			s.command_id = command_id;
+			s.block.assign(block_rows_ * (column_names_.size() + 1), 0.0);
+			s.row_count = 0;
+			s.written_count = 0;
+
+			// 写文件线程中不能抛出异常，失败时该指令的数据计入 failed_rows_ //
+			std::error_code ec;
+			auto dir = file_directory_.empty() ? aris::core::logDirPath() : file_directory_;
+			std::filesystem::create_directories(dir, ec);
+			auto path = dir / ("record--" + aris::core::logFileTimeFormat(std::chrono::system_clock::now()) + "--" + std::to_string(command_id) + ".arec");
+
+			auto &file = s.file;
+			file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				s.is_failed = true;
+				set_error("recorder failed to open file " + path.string() + (ec ? " : " + ec.message() : ""));
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> lck(mu_);
+				last_file_ = path;
+			}
+
+			FileHeader header{};
+			std::memcpy(header.magic, "ARISREC", 8);
+			header.version = 1;
+			header.column_size = static_cast<std::uint32_t>(column_names_.size());
+			header.block_rows = static_cast<std::uint32_t>(block_rows_);
+			header.name_size = NAME_SIZE;
+			header.command_id = command_id;
+			header.data_offset = sizeof(FileHeader) + column_names_.size() * NAME_SIZE;
+			header.block_bytes = sizeof(std::int64_t) + s.block.size() * sizeof(double);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+
+			for (auto &name : column_names_)
+			{
+				char buf[NAME_SIZE]{};
+				std::strncpy(buf, name.c_str(), NAME_SIZE - 1);
+				file.write(buf, NAME_SIZE);
+			}
+
+			s.block_pos = file.tellp();
+		}
+		auto close_file(Stream &s)->void
+		{
+			if (!s.is_open)return;
+			if (s.row_count > s.written_count)write_block(s);
+			s.file.close();
+			s.is_open = false;
+		}
+		auto writer_loop()->void
+		{
+			std::vector<Stream> streams;
+			const auto column_size = column_names_.size();
+
+			for (bool running = true; running;)
+			{
+				// 缓冲区中积累的行数达到 notify_rows_、有flush请求或停止时被唤醒 //
+				writer_notifier_.wait([&]()
+				{
+					return !is_writer_running_.load() || flush_request_.load() > flush_done_.load()
+						|| head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed) >= static_cast<std::int64_t>(notify_rows_);
+				});
+
+				running = is_writer_running_.load();
+				auto flush_request = flush_request_.load();
+
+				auto head = head_.load(std::memory_order_acquire);
+				auto tail = tail_.load(std::memory_order_relaxed);
+				for (; tail < head; ++tail)
+				{
+					auto slot = static_cast<aris::Size>(tail % capacity_);
+					auto group = static_cast<aris::Size>(ring_id_[slot * 3]);
+					auto command_id = ring_id_[slot * 3 + 1];
+					auto count = ring_id_[slot * 3 + 2];
+
+					// 该运动组开始了新的指令，写新的文件 //
+					if (group >= streams.size())streams.resize(group + 1);
+					auto &s = streams[group];
+					if (!s.is_open || command_id != s.command_id)
+					{
+						close_file(s);
+						open_file(s, command_id);
+					}
+					if (s.is_failed)
+					{
+						failed_rows_.fetch_add(1, std::memory_order_relaxed);
+						continue;
+					}
+
+					// 转置到列存的block中, block 布局为 count[block_rows], column[column_size][block_rows] //
+					std::memcpy(s.block.data() + s.row_count, &count, sizeof(std::int64_t));
+					for (aris::Size j = 0; j < column_size; ++j)
+						s.block[(j + 1) * block_rows_ + s.row_count] = ring_[slot * column_size + j];
+
+					if (++s.row_count == block_rows_)
+					{
+						write_block(s);
+						s.block_pos = s.file.tellp();
+						s.row_count = 0;
+						s.written_count = 0;
+						std::fill(s.block.begin(), s.block.end(), 0.0);
+					}
+				}
+				tail_.store(tail, std::memory_order_release);
+
+				if (!running)break;
+
+				// 处理flush请求，不满的block也写入文件，之后再写满时会覆盖 //
+				if (flush_request > flush_done_.load())
+				{
+					for (auto &s : streams)
+					{
+						if (!s.is_open || s.is_failed)continue;
+						if (s.row_count > s.written_count)write_block(s);
+						s.file.flush();
+					}
+					flush_done_.store(flush_request);
+					flush_notifier_.notify();
+				}
+			}
+
+			for (auto &s : streams)close_file(s);
+			flush_notifier_.notify();
+		}
+
+		// 配置 //
+		std::vector<Channel> channels_;
+		aris::Size capacity_{ 4096 }, block_rows_{ 1000 };
+		std::filesystem::path file_directory_;
+
+		// 启动后的数据 //
+		bool enabled_{ false };
+		std::vector<Item> items_;
+		std::vector<std::string> column_names_;
+		std::vector<double> ring_;
+		std::vector<std::int64_t> ring_id_;  // 每行为 group, command_id, count //
+		aris::Size notify_rows_{ 1 };
+		alignas(64) std::atomic<std::int64_t> head_{ 0 };
+		alignas(64) std::atomic<std::int64_t> tail_{ 0 };
+		alignas(64) std::atomic<std::int64_t> dropped_rows_{ 0 }, written_rows_{ 0 }, failed_rows_{ 0 };
+
+		// 写文件线程 //
+		std::thread writer_thread_;
+		std::atomic_bool is_writer_running_{ false };
+		std::atomic<std::int64_t> flush_request_{ 0 }, flush_done_{ 0 };
+		aris::core::Notifier writer_notifier_, flush_notifier_;
+		mutable std::mutex mu_;
+		std::filesystem::path last_file_;
+		std::string last_error_;
+	};
+	auto Recorder::loadXml(const aris::core::XmlElement &xml_ele)->void
+	{
+		Object::loadXml(xml_ele);
+		setCapacity(attributeInt64(xml_ele, "capacity", 4096));
+		setBlockRows(attributeInt64(xml_ele, "block_rows", 1000));
+		setFileDirectory(attributeString(xml_ele, "file_directory", ""));
+
+		// channels="actual_pos target_pos:0 part_pq:2"，不带序号表示所有电机或杆件 //
+		clearChannels();
+		std::stringstream ss(attributeString(xml_ele, "channels", ""));
+		for (std::string word; ss >> word;)
+		{
+			auto pos = word.find(':');
+			auto type_name = word.substr(0, pos);
+			auto found = std::find_if(std::begin(channel_type_names), std::end(channel_type_names), [&](const auto &n) {return type_name == n.name; });
+			if (found == std::end(channel_type_names))throw std::runtime_error("unknown record channel \"" + type_name + "\"");
+			addChannel(found->type, pos == std::string::npos ? ALL : std::stoul(word.substr(pos + 1)));
+		}
+	}
+	auto Recorder::saveXml(aris::core::XmlElement &xml_ele) const->void
+	{
+		Object::saveXml(xml_ele);
+		xml_ele.SetAttribute("capacity", static_cast<std::int64_t>(capacity()));
+		xml_ele.SetAttribute("block_rows", static_cast<std::int64_t>(blockRows()));
+		if (!fileDirectory().empty())xml_ele.SetAttribute("file_directory", fileDirectory().string().c_str());
+
+		std::string channels;
+		for (auto &c : imp_->channels_)
+		{
+			channels += (channels.empty() ? "" : " ") + std::string(channelTypeName(c.type).name);
+			if (c.index != ALL)channels += ":" + std::to_string(c.index);
+		}
+		if (!channels.empty())xml_ele.SetAttribute("channels", channels.c_str());
+	}
+	auto Recorder::addChannel(ChannelType type, aris::Size index)->void
+	{
+		if (imp_->is_writer_running_)throw std::runtime_error("recorder is running, can not change channels");
+		imp_->channels_.push_back(Channel{ type, index });
+	}
+	auto Recorder::clearChannels()->void
+	{
+		if (imp_->is_writer_running_)throw std::runtime_error("recorder is running, can not change channels");
+		imp_->channels_.clear();
+	}
+	auto Recorder::channels()const->const std::vector<Channel>& { return imp_->channels_; }
+	auto Recorder::capacity()const->aris::Size { return imp_->capacity_; }
+	auto Recorder::setCapacity(aris::Size rows)->void
+	{
+		if (imp_->is_writer_running_)throw std::runtime_error("recorder is running, can not change capacity");
+		if (rows == 0)throw std::runtime_error("recorder capacity must be positive");
+		imp_->capacity_ = rows;
+	}
+	auto Recorder::blockRows()const->aris::Size { return imp_->block_rows_; }
+	auto Recorder::setBlockRows(aris::Size rows)->void
+	{
+		if (imp_->is_writer_running_)throw std::runtime_error("recorder is running, can not change block rows");
+		if (rows == 0)throw std::runtime_error("recorder block rows must be positive");
+		imp_->block_rows_ = rows;
+	}
+	auto Recorder::fileDirectory()const->std::filesystem::path { return imp_->file_directory_; }
+	auto Recorder::setFileDirectory(const std::filesystem::path &dir)->void { imp_->file_directory_ = dir; }
+	auto Recorder::columnNames()const->const std::vector<std::string>& { return imp_->column_names_; }
+	auto Recorder::droppedRows()const->std::int64_t { return imp_->dropped_rows_.load(); }
+	auto Recorder::writtenRows()const->std::int64_t { return imp_->written_rows_.load(); }
+	auto Recorder::failedRows()const->std::int64_t { return imp_->failed_rows_.load(); }
+	auto Recorder::lastFile()const->std::filesystem::path { std::lock_guard<std::mutex> lck(imp_->mu_); return imp_->last_file_; }
+	auto Recorder::lastError()const->std::string { std::lock_guard<std::mutex> lck(imp_->mu_); return imp_->last_error_; }
+	auto Recorder::start(aris::control::Controller &controller, aris::dynamic::Model &model)->void
+	{
+		if (imp_->is_writer_running_)throw std::runtime_error("recorder already started");
+
+		// 控制器的motionPool在其启动时才建立，这里按相同的顺序从slavePool中取 //
+		std::vector<aris::control::Motion*> cms;
+		for (auto &s : controller.slavePool())if (auto cm = dynamic_cast<aris::control::Motion*>(&s))cms.push_back(cm);
+
+		// 展开通道 //
+		imp_->items_.clear();
+		imp_->column_names_.clear();
+		for (auto &c : imp_->channels_)
+		{
+			auto &type_name = channelTypeName(c.type);
+			auto is_part = c.type == PART_PQ;
+			auto is_model = c.type == MODEL_MP || c.type == MODEL_MV || c.type == MODEL_MF;
+			auto size = is_part ? model.partPool().size() : is_model ? model.motionPool().size() : cms.size();
+
+			auto begin = c.index == ALL ? 0 : c.index;
+			auto end = c.index == ALL ? size : c.index + 1;
+			if (end > size)throw std::runtime_error(std::string("record channel \"") + type_name.name + "\" index out of range");
+
+			for (auto i = begin; i < end; ++i)
+			{
+				imp_->items_.push_back(Imp::Item{ c.type,
+					is_part || is_model ? nullptr : cms.at(i),
+					is_model ? &model.motionPool().at(i) : nullptr,
+					is_part ? &model.partPool().at(i) : nullptr });
+
+				if (type_name.column_size == 1)
+					imp_->column_names_.push_back(std::string(type_name.name) + "." + std::to_string(i));
+				else
+					for (aris::Size j = 0; j < type_name.column_size; ++j)
+						imp_->column_names_.push_back(std::string(type_name.name) + "." + std::to_string(i) + "." + std::to_string(j));
+			}
+		}
+
+		imp_->enabled_ = !imp_->items_.empty();
+		if (!imp_->enabled_)return;
+
+		// 预分配所有内存，实时线程中不再分配 //
+		imp_->ring_.assign(imp_->capacity_ * imp_->column_names_.size(), 0.0);
+		imp_->ring_id_.assign(imp_->capacity_ * 3, 0);
+		imp_->notify_rows_ = std::max<aris::Size>(1, std::min(imp_->block_rows_, imp_->capacity_ / 4));
+		imp_->head_.store(0);
+		imp_->tail_.store(0);
+		imp_->dropped_rows_.store(0);
+		imp_->written_rows_.store(0);
+		imp_->failed_rows_.store(0);
+		imp_->last_error_.clear();
+		imp_->flush_request_.store(0);
+		imp_->flush_done_.store(0);
+
+		imp_->is_writer_running_ = true;
+		imp_->writer_thread_ = std::thread([this]() { imp_->writer_loop(); });
+	}
+	auto Recorder::stop()->void
+	{
+		if (!imp_->is_writer_running_)return;
+		imp_->is_writer_running_ = false;
+		imp_->writer_notifier_.notify();
+		imp_->writer_thread_.join();
+		imp_->enabled_ = false;
+	}
+	auto Recorder::enabled()const->bool { return imp_->enabled_; }
+	auto Recorder::record(std::int64_t command_id, std::int64_t count, aris::Size group)->void
+	{
+		if (!imp_->enabled_)return;
+
+		auto head = imp_->head_.load(std::memory_order_relaxed);
+		auto tail = imp_->tail_.load(std::memory_order_acquire);
+		if (head - tail >= static_cast<std::int64_t>(imp_->capacity_))
+		{
+			imp_->dropped_rows_.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto slot = static_cast<aris::Size>(head % imp_->capacity_);
+		imp_->ring_id_[slot * 3] = static_cast<std::int64_t>(group);
+		imp_->ring_id_[slot * 3 + 1] = command_id;
+		imp_->ring_id_[slot * 3 + 2] = count;
+
+		auto row = imp_->ring_.data() + slot * imp_->column_names_.size();
+		for (auto &item : imp_->items_)
+		{
+			switch (item.type)
+			{
+			case TARGET_POS: *row++ = item.cm->targetPos(); break;
+			case TARGET_VEL: *row++ = item.cm->targetVel(); break;
+			case TARGET_CUR: *row++ = item.cm->targetCur(); break;
+			case ACTUAL_POS: *row++ = item.cm->actualPos(); break;
+			case ACTUAL_VEL: *row++ = item.cm->actualVel(); break;
+			case ACTUAL_CUR: *row++ = item.cm->actualCur(); break;
+			case MODEL_MP: *row++ = item.mm->mp(); break;
+			case MODEL_MV: *row++ = item.mm->mv(); break;
+			case MODEL_MF: *row++ = item.mm->mf(); break;
+			case PART_PQ: item.part->getPq(row); row += 7; break;
+			}
+		}
+
+		imp_->head_.store(head + 1, std::memory_order_release);
+
+		// 只有积累够一批数据时才唤醒写文件线程，写文件线程未等待时 notify 只是一次原子加法 //
+		if (head + 1 - tail >= static_cast<std::int64_t>(imp_->notify_rows_))imp_->writer_notifier_.notify();
+	}
+	auto Recorder::flush()->void
+	{
+		if (!imp_->is_writer_running_)return;
+		auto request = ++imp_->flush_request_;
+		imp_->writer_notifier_.notify();
+		imp_->flush_notifier_.wait([&]() { return imp_->flush_done_.load() >= request || !imp_->is_writer_running_; });
+	}
+	Recorder::~Recorder() { stop(); }
+	Recorder::Recorder(const std::string &name) :Object(name), imp_(new Imp) {}
+}
@@ -0,0 +1,79 @@
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+#include "aris/server/server.hpp"
+#include "aris/server/replay.hpp"
+
+namespace aris::server
+{
+	auto loadReplayScript(std::istream &is)->std::vector<ReplayCommand>
+	{
+		std::vector<ReplayCommand> script;
+		for (std::string line; std::getline(is, line);)
+		{
+			auto begin = line.find_first_not_of(" \t\r");
+			if (begin == std::string::npos || line[begin] == '#')continue;
+
+			std::stringstream ss(line.substr(begin));
+			ReplayCommand cmd;
+			if (!(ss >> cmd.count) || cmd.count < 0)THROW_FILE_AND_LINE("invalid replay line : " + line);
+			std::getline(ss >> std::ws, cmd.cmd);
+			if (cmd.cmd.empty())THROW_FILE_AND_LINE("invalid replay line : " + line);
+			script.push_back(cmd);
+		}
+		return script;
+	}
+	auto replay(ControlServer &cs, const std::vector<ReplayCommand> &script)->ReplayResult
+	{
+		auto &c = cs.controller();
+		if (!cs.running() || !c.isVirtualTime())THROW_FILE_AND_LINE("replay needs a server running in virtual time");
+
+		auto sorted = script;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const ReplayCommand &a, const ReplayCommand &b) { return a.count < b.count; });
+
+		// 在本线程中提交，提交过程等待实时循环时由服务器逐周期推进，prepairNrt 等非实时部分的耗时不影响周期数 //
+		struct StepGuard
+		{
+			ControlServer &cs;
+			bool is_step;
+			~StepGuard() { cs.setStepOnRtWait(is_step); }
+		};
+		StepGuard step_guard{ cs, cs.stepOnRtWait() };
+		cs.setStepOnRtWait(true);
+
+		ReplayResult result;
+		auto begin_count = static_cast<std::int64_t>(c.cycleCount());
+		auto begin_time = std::chrono::steady_clock::now();
+
+		for (auto &cmd : sorted)
+		{
+			if (auto now = static_cast<std::int64_t>(c.cycleCount()) - begin_count; cmd.count > now)c.step(cmd.count - now);
+
+			try
+			{
+				result.targets.push_back(cs.executeCmd(aris::core::Msg(cmd.cmd)));
+			}
+			catch (std::exception &)
+			{
+				result.targets.push_back(nullptr);
+			}
+		}
+
+		// 推进到所有运动组空闲，再多运行一个周期，使收集线程可以收集最后一条指令 //
+		auto group_num = std::max<aris::Size>(cs.motionGroupPool().size(), 1);
+		auto is_busy = [&]()
+		{
+			for (aris::Size g = 0; g < group_num; ++g)if (cs.currentExecuteId(g))return true;
+			return false;
+		};
+		while (is_busy())c.step(1);
+		c.step(1);
+		for (auto &target : result.targets)if (target)target->finished.wait();
+
+		result.total_count = static_cast<std::int64_t>(c.cycleCount()) - begin_count;
+		result.wall_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin_time).count();
+		c.rtPhaseHistogram(aris::control::Master::RT_STRATEGY, &result.strategy_histogram);
+		return result;
+	}
+}
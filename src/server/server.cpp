@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <memory>
 #include <cinttypes>
+#include <cmath>
 #include <queue>
 
 #include <aris/core/core.hpp>
@@ -17,44 +18,133 @@ namespace aris::server
 		aris::plan::Plan::NOT_CHECK_POS_MAX | 
 		aris::plan::Plan::NOT_CHECK_POS_MIN;
 	
-	struct ControlServer::Imp
+	// PlanTarget 的预分配内存池，allocate_shared 把控制块与 PlanTarget 放在同一个块中 //
+	// 空闲链表头以 (版本, 序号) 打包在一个64位整数中做 CAS，避免 ABA //
+	class TargetPool
 	{
-		struct InternalData
+	public:
+		enum : std::uint32_t { BLOCK_SIZE = 512, BLOCK_NUM = 2048, EMPTY = 0xFFFFFFFF };
+
+		auto allocate()->void*
 		{
-			std::shared_ptr<aris::plan::PlanTarget> target;
-			std::promise<void> ret_promise;
-		};
-		
+			for (auto head = head_.load();;)
+			{
+				auto idx = static_cast<std::uint32_t>(head);
+				if (idx == EMPTY)return nullptr;
+				auto new_head = ((head >> 32) + 1) << 32 | next_[idx].load(std::memory_order_relaxed);
+				if (head_.compare_exchange_weak(head, new_head))return blocks_ + static_cast<std::size_t>(idx) * BLOCK_SIZE;
+			}
+		}
+		auto deallocate(void *p)->bool
+		{
+			auto offset = static_cast<char*>(p) - blocks_;
+			if (offset < 0 || offset >= static_cast<std::ptrdiff_t>(sizeof(blocks_)))return false;
+
+			auto idx = static_cast<std::uint32_t>(offset / BLOCK_SIZE);
+			for (auto head = head_.load();;)
+			{
+				next_[idx].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+				if (head_.compare_exchange_weak(head, ((head >> 32) + 1) << 32 | idx))return true;
+			}
+		}
+
+		TargetPool()
+		{
+			for (std::uint32_t i = 0; i < BLOCK_NUM; ++i)next_[i].store(i + 1 < BLOCK_NUM ? i + 1 : EMPTY);
+			head_.store(0);
+		}
+
+	private:
+		alignas(64) char blocks_[BLOCK_SIZE * BLOCK_NUM];
+		std::atomic<std::uint32_t> next_[BLOCK_NUM];
+		alignas(64) std::atomic<std::uint64_t> head_;
+	};
+	// 调用者持有的 PlanTarget 可能比 ControlServer 活得更久，因此内存池不释放 //
+	auto targetPool()->TargetPool& { static auto pool = new TargetPool; return *pool; }
+	template<typename T> struct TargetAllocator
+	{
+		using value_type = T;
+
+		auto allocate(std::size_t n)->T*
+		{
+			if (n * sizeof(T) <= TargetPool::BLOCK_SIZE && alignof(T) <= 64)
+				if (auto p = targetPool().allocate())return static_cast<T*>(p);
+			
+			// 内存池用完时退回到堆上分配 //
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+		auto deallocate(T *p, std::size_t)->void { if (!targetPool().deallocate(p))::operator delete(p); }
+
+		TargetAllocator() = default;
+		template<typename U> TargetAllocator(const TargetAllocator<U> &) {}
+		template<typename U> auto operator==(const TargetAllocator<U> &)const->bool { return true; }
+		template<typename U> auto operator!=(const TargetAllocator<U> &)const->bool { return false; }
+	};
+
+	struct ControlServer::Imp
+	{
+		struct Group;
 		auto tg()->void;
-		auto executeCmd(aris::plan::PlanTarget &target)->int;
-		auto checkMotion(std::uint64_t option)->int;
+		auto executeCmd(Group &group, aris::plan::PlanTarget &target, std::uint32_t count)->int;
+		auto blendCmd(Group &group, aris::plan::PlanTarget &target, int ret, std::int64_t cmd_now, std::int64_t cmd_end, std::int64_t global_count)->int;
+		auto checkMotion(Group &group, std::uint64_t option)->int;
+		auto publishSnapshot(std::int64_t global_count)->void;
+		// 非实时线程等待实时线程，need_rt() 为真表示只有实时循环继续运行才能满足 pred() //
+		auto waitRt(aris::core::Notifier &notifier, const std::function<bool()> &pred, const std::function<bool()> &need_rt)->void;
+		// 等待本运动组收集时，收集线程是否在等待实时循环 //
+		auto collectNeedRt(Group &group)->bool;
 
 		Imp(ControlServer *server) :server_(server) {}
 		Imp(const Imp&) = delete;
 
 		std::recursive_mutex mu_running_;
 		std::atomic_bool is_running_{ false };
+		std::atomic_bool is_step_on_rt_wait_{ false };
 
 		ControlServer *server_;
 
 		// 实时循环中的轨迹参数 //
-		enum { CMD_POOL_SIZE = 1000 };
-		std::shared_ptr<InternalData> internal_data_queue_[CMD_POOL_SIZE];
+		enum { CMD_POOL_SIZE = 1000, MAX_GROUP_NUM = aris::control::Master::MAX_STASTICS_SLOT };
+
+		// 每个运动组有独立的指令队列，预先分配，运行中不会重新分配 //
+		struct Group
+		{
+			std::shared_ptr<aris::plan::PlanTarget> target_queue_[CMD_POOL_SIZE];
+
+			// cmd系列参数
+			// 多个线程可同时提交指令：先用 cmd_reserve_ 预留位置，写入后按预留顺序推进 cmd_end_ //
+			std::atomic<std::int64_t> cmd_now_{ 0 }, cmd_end_{ 0 }, cmd_collect_{ 0 }, cmd_reserve_{ 0 };
+			std::uint32_t count_{ 1 };
+			std::int64_t last_cmd_now_{ 0 };
+
+			// 组内的电机，以及安全检查，储存各轴的限位及上一次motion的数据 //
+			std::vector<aris::Size> motions_;
+			MotionChecker checker_;
+			int idle_error_code_{ 0 }, error_code_{ 0 };
+			bool is_correcting_{ false };
+
+			// 轨迹混合，下一条指令与当前指令同时执行，输出为当前指令的输出加上下一条指令相对当前指令终点的偏移 //
+			bool is_blending_{ false }, is_blend_finished_{ false };
+			std::uint32_t blend_count_{ 1 };
+			std::vector<double> blend_pos_, blend_offset_;
+
+			// 统计数据 //
+			std::atomic<std::int64_t> executed_cmd_count_{ 0 }, failed_cmd_count_{ 0 }, busy_count_{ 0 };
+		};
+		Group groups_[MAX_GROUP_NUM];
+		std::atomic<aris::Size> group_num_{ 1 };
 		
 		// 全局count //
 		std::atomic<std::int64_t> global_count_{ 0 };
 
-		// cmd系列参数
-		std::atomic<std::int64_t> cmd_now_, cmd_end_, cmd_collect_;
-		std::uint32_t count_{ 1 };
+		std::atomic<std::int32_t> submitting_num_{ 0 };
 
 		// collect系列参数
 		std::thread collect_thread_;
 		std::atomic_bool is_collect_running_;
 
-		// 储存上一次motion的数据 //
-		struct PVC { double p; double v; double c; };
-		std::vector<PVC> last_pvc, last_last_pvc;
+		// cmd_now_ 改变及数据已取出时由实时线程通知，cmd_collect_ 改变时由收集线程通知 //
+		aris::core::Notifier rt_notifier_, collect_notifier_, submit_notifier_, snapshot_notifier_;
 
 		// 储存Model, Controller, SensorRoot, PlanRoot //
 		aris::dynamic::Model* model_;
@@ -62,98 +152,170 @@ namespace aris::server
 		aris::sensor::SensorRoot* sensor_root_;
 		aris::plan::PlanRoot* plan_root_;
 		InterfaceRoot *interface_root_;
+		Recorder *recorder_;
+		aris::core::ObjectPool<MotionGroup> *motion_group_pool_;
 
 		// 打洞，读取数据 //
 		std::atomic_bool if_get_data_{ false }, if_get_data_ready_{ false };
 		const std::function<void(ControlServer&, std::any&)>* get_data_func_;
 		std::any *get_data_;
+
+		// 状态快照，两份缓冲区交替写入，每份带有顺序锁，读者发现写入期间被改写时重新读取 //
+		struct SnapshotSlot
+		{
+			std::atomic<std::uint64_t> seq_{ 0 };
+			RtSnapshot data_;
+		};
+		SnapshotSlot snapshot_[2];
+		std::atomic<int> snapshot_published_{ -1 };
+		std::uint32_t snapshot_items_{ RtSnapshot::MOTION_STATE }, snapshot_items_running_{ 0 };
+		// 正在复制快照的线程数，start() 重新分配快照前等待它们结束 //
+		std::atomic<std::int32_t> snapshot_reading_num_{ 0 };
 	};
 	auto ControlServer::Imp::tg()->void
 	{
 		auto global_count = ++global_count_; // 原子操作
 
-		auto cmd_now = cmd_now_.load();//原子操作
-		auto cmd_end = cmd_end_.load();//原子操作
+		// 各运动组依次执行，互不影响 //
+		for (aris::Size g = 0; g < group_num_.load(std::memory_order_relaxed); ++g)
+		{
+			auto &group = groups_[g];
+			auto cmd_now = group.cmd_now_.load();//原子操作
+			auto cmd_end = group.cmd_end_.load();//原子操作
 
-		// global error code, 存储上一次的错误 //
-		static int idle_error_code{ 0 };
+			// cmd_now_ 在上一周期中改变（命令结束或被stop清空），上一周期的统计数据已写完，收集线程可以收集 //
+			if (cmd_now != group.last_cmd_now_)
+			{
+				group.last_cmd_now_ = cmd_now;
+				rt_notifier_.notify();
+			}
 
-		// 执行cmd queue中的cmd //
-		if (cmd_end > cmd_now)
-		{
-			auto &target = *internal_data_queue_[cmd_now % CMD_POOL_SIZE]->target;
-			
-			// 在第一回合初始化，包括log，初始化target等 //
-			if (count_ == 1)
+			// 执行cmd queue中的cmd //
+			if (cmd_end > cmd_now)
 			{
-				// 初始化target
-				target.begin_global_count = global_count;
-				
-				// 创建rt_log文件 //
-				char name[1000];
-				std::sprintf(name, "%" PRId64 "", target.command_id);
-				server_->controller().logFile(name);
+				auto &target = *group.target_queue_[cmd_now % CMD_POOL_SIZE];
+				++group.busy_count_;
 
-				// 初始化统计数据 //
-				server_->controller().resetRtStasticData(&target.rt_stastic, true);
-			}
+				// 在第一回合初始化，包括log，初始化target等 //
+				if (group.count_ == 1)
+				{
+					// 初始化target
+					target.begin_global_count = global_count;
+
+					// 创建rt_log文件，lout 只有一个，因此其它运动组已经在执行指令时不切换文件，只在其中标记本指令的开始 //
+					bool is_other_busy{ false };
+					for (aris::Size i = 0; i < group_num_.load(std::memory_order_relaxed); ++i)
+						is_other_busy = is_other_busy || (i != g && groups_[i].count_ > 1 && groups_[i].cmd_end_.load() > groups_[i].cmd_now_.load());
+					if (is_other_busy)
+					{
+						server_->controller().loutRecord("cmd {} of motion group {} begins at global count {}\n", target.command_id, g, global_count);
+					}
+					else
+					{
+						char name[1000];
+						std::sprintf(name, "%" PRId64 "", target.command_id);
+						server_->controller().logFile(name);
+					}
 
-			// 执行命令
-			auto ret = executeCmd(target);
+					// 初始化统计数据，每个运动组使用独立的统计位置 //
+					server_->controller().resetRtStasticData(&target.rt_stastic, true, g);
+				}
 
-			// 检查错误 //
-			if (checkMotion(target.option) || ret < 0)
-			{
-				target.ret_code = aris::plan::PlanTarget::ERROR;
-				
-				server_->controller().mout() << "failed, cmd queue cleared\n";
-				count_ = 1;
-				cmd_now_.store(cmd_end);//原子操作
+				// 执行命令，并与下一条指令混合
+				auto ret = executeCmd(group, target, group.count_);
+				auto blend_ret = blendCmd(group, target, ret, cmd_now, cmd_end, global_count);
+				auto check_ret = checkMotion(group, target.option);
+				group.error_code_ = ret < 0 || blend_ret < 0 ? -1 : check_ret;
 
-				server_->controller().resetRtStasticData(nullptr, false);
-			}
-			// 命令正常结束，结束统计数据 //
-			else if (ret == 0)
-			{
-				target.ret_code = aris::plan::PlanTarget::SUCCESS;
-				
-				if(!(target.option & aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT))
-					server_->controller().mout() << "cmd finished, spend " << count_ << " counts\n\n";
-				count_ = 1;
-				cmd_now_.store(cmd_now + 1);//原子操作
+				// 记录本周期数据，多个运动组同时执行时，每个运动组各记录一行到自己的指令中 //
+				recorder_->record(target.command_id, global_count, g);
+
+				// 检查错误，只清空本运动组的指令 //
+				if (check_ret || ret < 0 || blend_ret < 0)
+				{
+					target.ret_code = aris::plan::PlanTarget::ERROR;
+					if (group.is_blending_)group.target_queue_[(cmd_now + 1) % CMD_POOL_SIZE]->ret_code = aris::plan::PlanTarget::ERROR;
+
+					server_->controller().mout() << "failed, cmd queue cleared\n";
+					group.is_blending_ = false;
+					group.count_ = 1;
+					group.failed_cmd_count_ += cmd_end - cmd_now;
+					group.cmd_now_.store(cmd_end);//原子操作
+					rt_notifier_.notify();
 
-				server_->controller().resetRtStasticData(nullptr, false);
+					server_->controller().resetRtStasticData(nullptr, false, g);
+				}
+				// 命令正常结束，结束统计数据 //
+				else if (ret == 0)
+				{
+					target.ret_code = aris::plan::PlanTarget::SUCCESS;
+
+					if (!(target.option & aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT))
+						server_->controller().mout() << "cmd finished, spend " << group.count_ << " counts\n\n";
+					++group.executed_cmd_count_;
+
+					// 正在混合的下一条指令成为当前指令，若它已经结束，则一起结束 //
+					if (group.is_blending_ && !group.is_blend_finished_)
+					{
+						auto &next = *group.target_queue_[(cmd_now + 1) % CMD_POOL_SIZE];
+						group.is_blending_ = false;
+						group.count_ = group.blend_count_;
+						group.cmd_now_.store(cmd_now + 1);//原子操作
+						server_->controller().resetRtStasticData(&next.rt_stastic, false, g);
+					}
+					else if (group.is_blending_)
+					{
+						group.target_queue_[(cmd_now + 1) % CMD_POOL_SIZE]->ret_code = aris::plan::PlanTarget::SUCCESS;
+						++group.executed_cmd_count_;
+						group.is_blending_ = false;
+						group.count_ = 1;
+						group.cmd_now_.store(cmd_now + 2);//原子操作
+						server_->controller().resetRtStasticData(nullptr, false, g);
+					}
+					else
+					{
+						group.count_ = 1;
+						group.cmd_now_.store(cmd_now + 1);//原子操作
+						server_->controller().resetRtStasticData(nullptr, false, g);
+					}
+					rt_notifier_.notify();
+				}
+				// 命令仍在执行 //
+				else
+				{
+					if (++group.count_ % 1000 == 0 && !(target.option & aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT))
+						server_->controller().mout() << "execute cmd in count: " << group.count_ << "\n";
+				}
 			}
-			// 命令仍在执行 //
-			else
+			else if (auto error_code = group.idle_error_code_; group.idle_error_code_ = checkMotion(group, global_option) && group.idle_error_code_ != error_code)
 			{
-				if (++count_ % 1000 == 0 && !(target.option & aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT))
-					server_->controller().mout() << "execute cmd in count: " << count_ << "\n";
+				// 只有错误代码改变时，才会打印 //
+				server_->controller().mout() << "failed when idle " << group.idle_error_code_ << "\n";
 			}
 		}
-		else if (auto error_code = idle_error_code; idle_error_code = checkMotion(global_option) && idle_error_code != error_code)
-		{
-			// 只有错误代码改变时，才会打印 //
-			server_->controller().mout() << "failed when idle " << idle_error_code << "\n";
-		}
+
+		publishSnapshot(global_count);
 
 		// 给与外部想要的数据 //
 		if (if_get_data_.exchange(false))// 原子操作
 		{
 			get_data_func_->operator()(ControlServer::instance(), *get_data_);
 			if_get_data_ready_.store(true); // 原子操作
+			rt_notifier_.notify();
 		}
 	}
-	auto ControlServer::Imp::executeCmd(aris::plan::PlanTarget &target)->int
+	auto ControlServer::Imp::executeCmd(Group &group, aris::plan::PlanTarget &target, std::uint32_t count)->int
 	{
-		target.count = count_;
+		target.count = count;
 
 		// 执行plan函数 //
 		int ret = target.plan->executeRT(target);
 
-		// 控制电机 //
-		for (std::size_t i = 0; i < std::min(controller_->motionPool().size(), model_->motionPool().size()); ++i)
+		// 控制本运动组的电机 //
+		for (auto i : group.motions_)
 		{
+			if (i >= std::min(controller_->motionPool().size(), model_->motionPool().size()))continue;
+
 			auto &cm = controller_->motionPool().at(i);
 			auto &mm = model_->motionPool().at(i);
 
@@ -169,269 +331,197 @@ namespace aris::server
 
 		return ret;
 	}
-	auto ControlServer::Imp::checkMotion(std::uint64_t option)->int
+	auto ControlServer::Imp::blendCmd(Group &group, aris::plan::PlanTarget &target, int ret, std::int64_t cmd_now, std::int64_t cmd_end, std::int64_t global_count)->int
 	{
-		static bool is_correcting{ false };
-		if (is_correcting)goto FAILED;
+		auto &cms = controller_->motionPool();
 
-		// 检查规划的指令是否合理（包括电机是否已经跟随上） //
-		for (std::size_t i = 0; i < controller_->motionPool().size(); ++i)
+		// 当前指令剩余周期数进入混合区，且下一条指令已经在队列中并允许混合时，开始混合 //
+		if (!group.is_blending_)
 		{
-			auto &cm = controller_->motionPool().at(i);
-			auto &ld = last_pvc.at(i);
-			auto &lld = last_last_pvc.at(i);
+			if (target.blend_count <= 0 || ret <= 0 || ret > target.blend_count || cmd_now + 1 >= cmd_end)return 0;
+			if (target.blend_end_pos.size() < cms.size())return 0;
 
-#ifndef WIN32
-			/*
-			if (!(option & aris::plan::Plan::NOT_CHECK_OPERATION_ENABLE)
-				&& ((cm.statusWord() & 0x6f) != 0x27))
-			{
-				server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-				server_->controller().mout() << "Motor " << i << " not in operation enable mode in count " << count_ << ":\n";
-				server_->controller().mout() << "max: " << cm.maxPos() << "\t" << "now: " << cm.targetPos() << "\n";
-				goto FAILED;
-			}
-			*/
-#endif
-
-			if ((cm.statusWord() & 0x6f) == 0x27)
-			{
-				if (cm.modeOfOperation() == 8)
-				{
-					// check pos max //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_MAX)
-						&& (cm.targetPos() > cm.maxPos()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position beyond MAX in count " << count_ << ":\n";
-						server_->controller().mout() << "max: " << cm.maxPos() << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+			auto &next = *group.target_queue_[(cmd_now + 1) % CMD_POOL_SIZE];
+			if (next.blend_count <= 0 || next.option & aris::plan::Plan::NOT_RUN_EXECUTE_FUNCTION)return 0;
 
-					// check pos min //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_MIN)
-						&& (cm.targetPos() < cm.minPos()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position beyond MIN in count " << count_ << ":\n";
-						server_->controller().mout() << "min: " << cm.minPos() << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+			next.begin_global_count = global_count;
+			group.is_blending_ = true;
+			group.is_blend_finished_ = false;
+			group.blend_count_ = 1;
+		}
 
-					// check pos continuous //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS)
-						&& count_ > 1
-						&& ((cm.targetPos() - ld.p) > 0.001 * cm.maxVel() || (cm.targetPos() - ld.p) < 0.001 * cm.minVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).p << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+		auto &next = *group.target_queue_[(cmd_now + 1) % CMD_POOL_SIZE];
+		for (aris::Size k = 0; k < group.motions_.size(); ++k)group.blend_pos_[k] = cms.at(group.motions_[k]).targetPos();
 
-					// check pos continuous at start //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_AT_START)
-						&& count_ <= 1
-						&& ((cm.targetPos() - ld.p) > 0.001 * cm.maxVel() || (cm.targetPos() - ld.p) < 0.001 * cm.minVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).p << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+		if (!group.is_blend_finished_)
+		{
+			// 下一条指令从当前指令的终点开始规划 //
+			if (group.blend_count_ == 1)
+				for (auto id : group.motions_)if (!std::isnan(target.blend_end_pos[id]))cms.at(id).setTargetPos(target.blend_end_pos[id]);
 
-					// check pos continuous second order //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_SECOND_ORDER)
-						&& count_ > 2
-						&& ((cm.targetPos() + lld.p - 2 * ld.p) > 1e-6 * cm.maxAcc() || (cm.targetPos() + lld.p - 2 * ld.p) < 1e-6 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position NOT SECOND CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last last: " << lld.p << "\tlast:" << ld.p << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+			auto next_ret = executeCmd(group, next, group.blend_count_);
+			if (next_ret < 0)return -1;
 
-					// check pos continuous second order at start //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_SECOND_ORDER_AT_START)
-						&& count_ <= 2
-						&& ((cm.targetPos() + lld.p - 2 * ld.p) > 1e-6 * cm.maxAcc() || (cm.targetPos() + lld.p - 2 * ld.p) < 1e-6 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position NOT SECOND CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last last: " << lld.p << "\tlast:" << ld.p << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
+			for (aris::Size k = 0; k < group.motions_.size(); ++k)
+			{
+				auto end = target.blend_end_pos[group.motions_[k]];
+				group.blend_offset_[k] = cms.at(group.motions_[k]).targetPos() - (std::isnan(end) ? group.blend_pos_[k] : end);
+			}
 
-					// check pos following error //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_FOLLOWING_ERROR)
-						&& (std::abs(cm.targetPos() - cm.actualPos()) > cm.maxPosFollowingError()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position has FOLLOW ERROR: " << count_ << "\n";
-						server_->controller().mout() << "target: " << cm.targetPos() << "\t" << "actual: " << cm.actualPos() << "\n";
-						goto FAILED;
-					}
-				}
-				else if (cm.modeOfDisplay() == 9)
-				{
-					// check vel max //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_MAX)
-						&& (cm.targetVel() > cm.maxVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity beyond MAX in count " << count_ << ":\n";
-						server_->controller().mout() << "max: " << cm.maxVel() << "\t" << "now: " << cm.targetVel() << "\n";
-						goto FAILED;
-					}
+			// 下一条指令先于当前指令结束时，保持其终点偏移 //
+			if (next_ret == 0)group.is_blend_finished_ = true;
+			else ++group.blend_count_;
+		}
 
-					// check vel min //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_MIN)
-						&& (cm.targetVel() < cm.minVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target veolcity beyond MIN in count " << count_ << ":\n";
-						server_->controller().mout() << "min: " << cm.minVel() << "\t" << "now: " << cm.targetVel() << "\n";
-						goto FAILED;
-					}
+		for (aris::Size k = 0; k < group.motions_.size(); ++k)cms.at(group.motions_[k]).setTargetPos(group.blend_pos_[k] + group.blend_offset_[k]);
+		return 0;
+	}
+	auto ControlServer::Imp::waitRt(aris::core::Notifier &notifier, const std::function<bool()> &pred, const std::function<bool()> &need_rt)->void
+	{
+		if (!is_step_on_rt_wait_ || !controller_->isVirtualTime())return notifier.wait(pred);
 
-					// check vel continuous //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS)
-						&& count_ > 1
-						&& ((cm.targetVel() - ld.v) > 0.001 * cm.maxAcc() || (cm.targetVel() - ld.v) < 0.001 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).v << "\t" << "now: " << controller_->motionPool().at(i).targetVel() << "\n";
-						goto FAILED;
-					}
+		// 虚拟时间下由等待的线程逐周期推进，只在确实需要实时循环时推进，每个周期后重新检查 //
+		// 等待收集线程时不推进，因此推进的周期数与非实时部分的耗时无关 //
+		while (!pred())
+		{
+			if (need_rt())controller_->step(1);
+			else notifier.wait([&]() { return pred() || need_rt(); });
+		}
+	}
+	auto ControlServer::Imp::collectNeedRt(Group &group)->bool
+	{
+		// 本组没有已执行完的指令，或收集线程正在等待某条指令的最后一个周期结束 //
+		if (group.cmd_collect_.load() >= group.cmd_now_.load())return true;
+		for (aris::Size g = 0; g < group_num_.load(); ++g)
+		{
+			auto cmd_collect = groups_[g].cmd_collect_.load();
+			if (cmd_collect >= groups_[g].cmd_now_.load())continue;
 
-					// check vel continuous at start //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS_AT_START)
-						&& count_ <= 1
-						&& ((cm.targetVel() - ld.v) > 0.001 * cm.maxAcc() || (cm.targetVel() - ld.v) < 0.001 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).v << "\t" << "now: " << controller_->motionPool().at(i).targetVel() << "\n";
-						goto FAILED;
-					}
+			auto &target = *groups_[g].target_queue_[cmd_collect % CMD_POOL_SIZE];
+			if (global_count_.load() < target.begin_global_count + target.count)return true;
+		}
+		return false;
+	}
+	auto ControlServer::Imp::publishSnapshot(std::int64_t global_count)->void
+	{
+		auto idx = snapshot_published_.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+		auto &slot = snapshot_[idx];
+		auto seq = slot.seq_.load(std::memory_order_relaxed);
+		slot.seq_.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		auto &s = slot.data_;
+		s.global_count = global_count;
+		for (aris::Size g = 0; g < s.command_id.size(); ++g)
+		{
+			auto &group = groups_[g];
+			auto cmd_now = group.cmd_now_.load();
+			auto is_busy = cmd_now < group.cmd_end_.load();
+			s.command_id[g] = is_busy ? group.target_queue_[cmd_now % CMD_POOL_SIZE]->command_id : 0;
+			s.error_code[g] = is_busy ? group.error_code_ : group.idle_error_code_;
+		}
 
-					// check vel following error //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_FOLLOWING_ERROR)
-						&& (std::abs(cm.targetVel() - cm.actualVel()) > cm.maxVelFollowingError()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity has FOLLOW ERROR: " << count_ << "\n";
-						server_->controller().mout() << "target: " << cm.targetVel() << "\t" << "actual: " << cm.actualVel() << "\n";
-						goto FAILED;
-					}
-				}
-				else if (cm.modeOfDisplay() == 10)
+		// 直接使用安全检查已经读到的数据，不再访问pdo //
+		if (snapshot_items_running_ & RtSnapshot::MOTION_STATE)
+		{
+			for (aris::Size g = 0; g < s.command_id.size(); ++g)
+			{
+				auto &group = groups_[g];
+				for (aris::Size k = 0; k < group.motions_.size(); ++k)
 				{
-					// check pos max //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_MAX)
-						&& (cm.actualPos() > cm.maxPos()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position beyond MAX in count " << count_ << ":\n";
-						server_->controller().mout() << "max: " << cm.maxPos() << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
-
-					// check pos min //
-					if (!(option & aris::plan::Plan::NOT_CHECK_POS_MIN)
-						&& (cm.actualPos() < cm.minPos()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target position beyond MIN in count " << count_ << ":\n";
-						server_->controller().mout() << "min: " << cm.minPos() << "\t" << "now: " << cm.targetPos() << "\n";
-						goto FAILED;
-					}
-
-					// check vel max //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_MAX)
-						&& (cm.actualVel() > cm.maxVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity beyond MAX in count " << count_ << ":\n";
-						server_->controller().mout() << "max: " << cm.maxVel() << "\t" << "now: " << cm.targetVel() << "\n";
-						goto FAILED;
-					}
-
-					// check vel min //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_MIN)
-						&& (cm.actualVel() < cm.minVel()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target veolcity beyond MIN in count " << count_ << ":\n";
-						server_->controller().mout() << "min: " << cm.minVel() << "\t" << "now: " << cm.targetVel() << "\n";
-						goto FAILED;
-					}
-
-					// check vel continuous //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS)
-						&& count_ > 1
-						&& ((cm.actualVel() - ld.v) > 0.001 * cm.maxAcc() || (cm.actualVel() - ld.v) < 0.001 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).v << "\t" << "now: " << controller_->motionPool().at(i).targetVel() << "\n";
-						goto FAILED;
-					}
-
-					// check vel continuous at start //
-					if (!(option & aris::plan::Plan::NOT_CHECK_VEL_CONTINUOUS_AT_START)
-						&& count_ <= 1
-						&& ((cm.actualVel() - ld.v) > 0.001 * cm.maxAcc() || (cm.actualVel() - ld.v) < 0.001 * cm.minAcc()))
-					{
-						server_->controller().mout() << __FILE__ << __LINE__ << "\n";
-						server_->controller().mout() << "Motor " << i << " target velocity NOT CONTINUOUS in count " << count_ << "\n";
-						server_->controller().mout() << "last: " << last_pvc.at(i).v << "\t" << "now: " << controller_->motionPool().at(i).targetVel() << "\n";
-						goto FAILED;
-					}
+					auto state = group.checker_.state(k);
+					auto m = group.motions_[k];
+					s.status_word[m] = state.status_word;
+					s.target_pos[m] = state.target_pos;
+					s.target_vel[m] = state.target_vel;
+					s.target_cur[m] = state.target_cur;
+					s.actual_pos[m] = state.actual_pos;
+					s.actual_vel[m] = state.actual_vel;
 				}
 			}
-			
+		}
+		if (snapshot_items_running_ & RtSnapshot::MOTION_ACTUAL)
+		{
+			for (aris::Size i = 0; i < std::min(s.actual_pos.size(), controller_->motionPool().size()); ++i)
+			{
+				auto &cm = controller_->motionPool()[i];
+				s.actual_pos[i] = cm.actualPos();
+				s.actual_vel[i] = cm.actualVel();
+				s.actual_cur[i] = cm.actualCur();
+			}
+		}
+		if (snapshot_items_running_ & RtSnapshot::PART_PM)
+		{
+			for (aris::Size i = 0; i < std::min(s.part_pm.size() / 16, model_->partPool().size()); ++i)
+				model_->partPool()[i].getPm(s.part_pm.data() + i * 16);
 		}
 
-		// 储存电机指令 //
-		for (std::size_t i = 0; i < controller_->motionPool().size(); ++i)
+		slot.seq_.store(seq + 2, std::memory_order_release);
+		snapshot_published_.store(idx, std::memory_order_release);
+	}
+	auto ControlServer::Imp::checkMotion(Group &group, std::uint64_t option)->int
+	{
+		if (group.is_correcting_)goto FAILED;
+
+		// 检查规划的指令是否合理（包括电机是否已经跟随上） //
+		group.checker_.loadState();
+		if (group.checker_.check(option, group.count_))
 		{
-			last_last_pvc.at(i).p = controller_->motionPool().at(i).targetPos();
-			last_last_pvc.at(i).v = controller_->motionPool().at(i).targetVel();
-			last_last_pvc.at(i).c = controller_->motionPool().at(i).targetCur();
+			auto i = group.checker_.firstAxis();
+			auto first = group.checker_.violation(i) & (0u - group.checker_.violation(i));
+			auto limits = group.checker_.limits(i);
+			auto state = group.checker_.state(i);
+			auto last = group.checker_.lastPvc(i);
+			auto &out = server_->controller().mout();
+
+			out << __FILE__ << __LINE__ << "\n";
+			out << "Motor " << group.motions_[i] << " target " << MotionChecker::violationName(first) << " in count " << group.count_ << "\n";
+			switch (first)
+			{
+			case MotionChecker::POS_MAX: out << "max: " << limits.max_pos << "\t" << "now: " << state.target_pos << "\n"; break;
+			case MotionChecker::POS_MIN: out << "min: " << limits.min_pos << "\t" << "now: " << state.target_pos << "\n"; break;
+			case MotionChecker::POS_CONTINUOUS: out << "last: " << last[0] << "\t" << "now: " << state.target_pos << "\n"; break;
+			case MotionChecker::POS_CONTINUOUS_SECOND_ORDER: out << "last last: " << group.checker_.lastLastPvc(i)[0] << "\tlast:" << last[0] << "\t" << "now: " << state.target_pos << "\n"; break;
+			case MotionChecker::POS_FOLLOWING_ERROR: out << "target: " << state.target_pos << "\t" << "actual: " << state.actual_pos << "\n"; break;
+			case MotionChecker::VEL_MAX: out << "max: " << limits.max_vel << "\t" << "now: " << state.target_vel << "\n"; break;
+			case MotionChecker::VEL_MIN: out << "min: " << limits.min_vel << "\t" << "now: " << state.target_vel << "\n"; break;
+			case MotionChecker::VEL_CONTINUOUS: out << "last: " << last[1] << "\t" << "now: " << state.target_vel << "\n"; break;
+			case MotionChecker::VEL_FOLLOWING_ERROR: out << "target: " << state.target_vel << "\t" << "actual: " << state.actual_vel << "\n"; break;
+			default:break;
+			}
+			goto FAILED;
 		}
-		std::swap(last_pvc, last_last_pvc);
+
+		// 储存电机指令 //
+		group.checker_.commit();
 		return 0;
 
 	FAILED:
-		is_correcting = false;
-		for (std::size_t i = 0; i < controller_->motionPool().size(); ++i)
+		group.is_correcting_ = false;
+		for (std::size_t i = 0; i < group.motions_.size(); ++i)
 		{
 			// correct
-			auto &cm = controller_->motionPool().at(i);
+			auto &cm = controller_->motionPool().at(group.motions_[i]);
 			switch (cm.modeOfOperation())
 			{
 			case 8:
 				cm.setTargetPos(cm.actualPos());
-				//is_correcting = cm.disable();
+				//group.is_correcting_ = cm.disable();
 				break;
 			case 9:
 				cm.setTargetVel(0.0);
-				//is_correcting = cm.disable();
+				//group.is_correcting_ = cm.disable();
 				break;
 			case 10:
 				cm.setTargetCur(0.0);
-				is_correcting = cm.disable();
+				group.is_correcting_ = cm.disable();
 				break;
 			default:
-				is_correcting = cm.disable();
+				group.is_correcting_ = cm.disable();
 			}
 			
 			// store correct data
-			last_pvc.at(i).p = last_last_pvc.at(i).p = controller_->motionPool().at(i).targetPos();
-			last_pvc.at(i).v = last_last_pvc.at(i).v = controller_->motionPool().at(i).targetVel();
-			last_pvc.at(i).c = last_last_pvc.at(i).c = controller_->motionPool().at(i).targetCur();
+			group.checker_.resetHistory(i, cm.targetPos(), cm.targetVel(), cm.targetCur());
 		}
 		return -1;
 	}
@@ -469,6 +559,7 @@ namespace aris::server
 	auto ControlServer::sensorRoot()->sensor::SensorRoot& { return *imp_->sensor_root_; }
 	auto ControlServer::planRoot()->plan::PlanRoot& { return *imp_->plan_root_; }
 	auto ControlServer::interfaceRoot()->InterfaceRoot& { return *imp_->interface_root_; }
+	auto ControlServer::recorder()->Recorder& { return *imp_->recorder_; }
 	auto ControlServer::loadXml(const aris::core::XmlElement &xml_ele)->void
 	{
 		Object::loadXml(xml_ele);
@@ -477,46 +568,43 @@ namespace aris::server
 		imp_->sensor_root_ = findOrInsertType<aris::sensor::SensorRoot>();
 		imp_->plan_root_ = findOrInsertType<aris::plan::PlanRoot>();
 		imp_->interface_root_ = findOrInsertType<aris::server::InterfaceRoot>();
+		imp_->recorder_ = findOrInsertType<aris::server::Recorder>();
+		imp_->motion_group_pool_ = findOrInsertType<aris::core::ObjectPool<MotionGroup>>();
 	}
-	auto ControlServer::executeCmd(const aris::core::Msg &msg)->std::shared_ptr<aris::plan::PlanTarget>
+	auto ControlServer::executeCmd(const aris::core::Msg &msg)->std::shared_ptr<aris::plan::PlanTarget> { return executeCmd(msg, 0); }
+	auto ControlServer::executeCmd(const aris::core::Msg &msg, const std::string &motion_group)->std::shared_ptr<aris::plan::PlanTarget>
 	{
-		std::unique_lock<std::recursive_mutex> running_lck(imp_->mu_running_);
-
-		static std::uint64_t cmd_id{ 0 };
-		++cmd_id;
+		auto &pool = motionGroupPool();
+		auto found = std::find_if(pool.begin(), pool.end(), [&](const MotionGroup &g) { return g.name() == motion_group; });
+		if (found == pool.end())LOG_AND_THROW(std::runtime_error("failed to execute command, because motion group \"" + motion_group + "\" does not exist"));
+		return executeCmd(msg, static_cast<aris::Size>(found - pool.begin()));
+	}
+	auto ControlServer::executeCmd(const aris::core::Msg &msg, aris::Size motion_group)->std::shared_ptr<aris::plan::PlanTarget>
+	{
+		// 解析、prepair 与打印可以在多个线程中并行，只有放入实时队列时需要同步（无锁） //
+		static std::atomic<std::uint64_t> cmd_id_count{ 0 };
+		const std::uint64_t cmd_id = ++cmd_id_count;
 
 		LOG_INFO << "server receive cmd " << std::to_string(cmd_id) << " : " << msg.toString() << std::endl;
-		auto cmd_end = imp_->cmd_end_.load();
 
 		// 找到命令对应的plan //
-		std::string cmd;
 		std::map<std::string, std::string> params;
-		planRoot().planParser().parse(msg.toString(), cmd, params);
-		auto plan_iter = std::find_if(planRoot().planPool().begin(), planRoot().planPool().end(), [&](const plan::Plan &p) {return p.command().name() == cmd; });
-
-		// 初始化plan target //
-		auto internal_data = std::make_shared<Imp::InternalData>(Imp::InternalData{
-			std::make_shared<aris::plan::PlanTarget>(
-				aris::plan::PlanTarget
-				{ 
-					&*plan_iter, 
-					this, 
-					&model(), 
-					&controller(), 
-					cmd_id, 
-					static_cast<std::uint64_t>(msg.header().reserved1_), 
-					std::any(), 
-					0, 
-					0, 
-					aris::control::Master::RtStasticsData{ 0,0,0,0x8fffffff,0,0,0 },
-					std::any(),
-					aris::plan::PlanTarget::CANCELLED,
-					std::future<void>()
-				}),
-			std::promise<void>()
-			});
-		auto &target = internal_data->target;
-		target->finished = internal_data->ret_promise.get_future();
+		auto plan = planRoot().parse(msg.toString(), params);
+		const auto &cmd = plan->command().name();
+
+		// 初始化plan target，从内存池中分配 //
+		auto target = std::allocate_shared<aris::plan::PlanTarget>(TargetAllocator<aris::plan::PlanTarget>());
+		target->plan = plan;
+		target->server = this;
+		target->model = &model();
+		target->controller = &controller();
+		target->command_id = cmd_id;
+		target->option = static_cast<std::uint64_t>(msg.header().reserved1_);
+		target->count = 0;
+		target->begin_global_count = 0;
+		target->rt_stastic = aris::control::Master::RtStasticsData{ 0,0,0,0x8fffffff,0,0,0 };
+		target->ret_code = aris::plan::PlanTarget::CANCELLED;
+		target->motion_group = motion_group;
 
 		// prepair //
 		if (!(target->option & aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION))
@@ -528,7 +616,7 @@ namespace aris::server
 			if (target->option & aris::plan::Plan::PREPAIR_WHEN_ALL_PLAN_COLLECTED)waitForAllCollection();
 
 			LOG_INFO << "server prepair cmd " << std::to_string(cmd_id) << std::endl;
-			plan_iter->prepairNrt(params, *target);
+			plan->prepairNrt(params, *target);
 		}
 
 		// print and log cmd info /////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -549,9 +637,24 @@ namespace aris::server
 		if (!(target->option & aris::plan::Plan::NOT_PRINT_CMD_INFO))std::cout << std::endl;
 		// print over ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+		// prepair 中可以修改运动组 //
+		if (target->motion_group >= imp_->group_num_.load())
+			LOG_AND_THROW(std::runtime_error("failed to execute command, because motion group " + std::to_string(target->motion_group) + " does not exist"));
+		auto &group = imp_->groups_[target->motion_group];
+		auto cmd_end = group.cmd_end_.load();
+
 		// execute //
 		if (!(target->option & aris::plan::Plan::NOT_RUN_EXECUTE_FUNCTION))
 		{
+			// 登记正在提交，stop() 会等待所有提交结束后再清空队列 //
+			struct SubmitGuard
+			{
+				Imp *imp;
+				~SubmitGuard() { if (--imp->submitting_num_ == 0)imp->submit_notifier_.notify(); }
+			};
+			++imp_->submitting_num_;
+			SubmitGuard submit_guard{ imp_.get() };
+
 			// 只有实时循环才需要 server 已经在运行
 			if (!imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to execute command, because ControlServer is not running"));
 			
@@ -561,16 +664,32 @@ namespace aris::server
 			// 等待所有任务收集 //
 			if (target->option & aris::plan::Plan::EXECUTE_WHEN_ALL_PLAN_COLLECTED)waitForAllCollection();
 
-			// 判断是否等待命令池清空 //
-			if ((!(target->option & aris::plan::Plan::WAIT_IF_CMD_POOL_IS_FULL)) && (cmd_end - imp_->cmd_collect_.load()) >= Imp::CMD_POOL_SIZE)//原子操作(cmd_now)
-				LOG_AND_THROW(std::runtime_error("failed to execute plan, because command pool is full"));
-			else
-				while ((cmd_end - imp_->cmd_collect_.load()) >= Imp::CMD_POOL_SIZE)std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			// 预留队列位置，判断是否等待命令池清空 //
+			for (cmd_end = group.cmd_reserve_.load();;)
+			{
+				if ((cmd_end - group.cmd_collect_.load()) < Imp::CMD_POOL_SIZE)//原子操作
+				{
+					if (group.cmd_reserve_.compare_exchange_weak(cmd_end, cmd_end + 1))break;
+					continue;
+				}
+
+				if (!(target->option & aris::plan::Plan::WAIT_IF_CMD_POOL_IS_FULL))
+					LOG_AND_THROW(std::runtime_error("failed to execute plan, because command pool is full"));
+				
+				imp_->waitRt(imp_->collect_notifier_
+					, [&]() { return !imp_->is_running_ || (group.cmd_reserve_.load() - group.cmd_collect_.load()) < Imp::CMD_POOL_SIZE; }
+					, [&]() { return imp_->collectNeedRt(group); });
+				if (!imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to execute command, because ControlServer is stopped"));
+				cmd_end = group.cmd_reserve_.load();
+			}
 
 			// 添加命令 //
+			group.target_queue_[cmd_end % Imp::CMD_POOL_SIZE] = target;
+
+			// 按预留顺序发布，更早的提交者在预留与发布之间没有阻塞操作，这里最多短暂让出 //
+			for (auto expected = cmd_end; !group.cmd_end_.compare_exchange_weak(expected, cmd_end + 1); expected = cmd_end)std::this_thread::yield();
+			++cmd_end;
 			LOG_INFO << "server execute cmd " << std::to_string(cmd_id) << std::endl;
-			imp_->internal_data_queue_[cmd_end % Imp::CMD_POOL_SIZE] = internal_data;
-			imp_->cmd_end_.store(++cmd_end); // 原子操作 //
 
 			// 等待当前任务完成 //
 			if(target->option & aris::plan::Plan::WAIT_FOR_EXECUTION)waitForAllExecution();
@@ -583,15 +702,17 @@ namespace aris::server
 			if (target->option & aris::plan::Plan::NOT_RUN_EXECUTE_FUNCTION)
 			{
 				// 等待所有任务完成，原子操作 //
-				while ((target->option & aris::plan::Plan::COLLECT_WHEN_ALL_PLAN_EXECUTED) && (cmd_end != imp_->cmd_now_.load()))std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				if (target->option & aris::plan::Plan::COLLECT_WHEN_ALL_PLAN_EXECUTED)
+					imp_->waitRt(imp_->rt_notifier_, [&]() { return cmd_end == group.cmd_now_.load(); }, []() { return true; });
 
 				// 等待所有任务收集，原子操作 //
-				while ((target->option & aris::plan::Plan::COLLECT_WHEN_ALL_PLAN_COLLECTED) && (cmd_end != imp_->cmd_collect_.load()))std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				if (target->option & aris::plan::Plan::COLLECT_WHEN_ALL_PLAN_COLLECTED)
+					imp_->waitRt(imp_->collect_notifier_, [&]() { return cmd_end == group.cmd_collect_.load(); }, [&]() { return imp_->collectNeedRt(group); });
 
 				LOG_INFO << "server collect cmd " << target->command_id << std::endl;
-				plan_iter->collectNrt(*target);
-				internal_data->target->ret_code = aris::plan::PlanTarget::SUCCESS;
-				internal_data->ret_promise.set_value();
+				plan->collectNrt(*target);
+				target->ret_code = aris::plan::PlanTarget::SUCCESS;
+				target->finished.finish();
 			}
 			// 等待当前实时任务收集 //
 			else
@@ -604,69 +725,137 @@ namespace aris::server
 		{
 			if (target->option & aris::plan::Plan::NOT_RUN_EXECUTE_FUNCTION)
 			{
-				internal_data->target->ret_code = aris::plan::PlanTarget::SUCCESS;
-				internal_data->ret_promise.set_value();
+				target->ret_code = aris::plan::PlanTarget::SUCCESS;
+				target->finished.finish();
 			}
 		}
 
 		return target;
 	}
 	auto ControlServer::globalCount()->std::int64_t { return imp_->global_count_.load(); }
-	auto ControlServer::currentExecuteId()->std::int64_t
+	auto ControlServer::currentExecuteId(aris::Size motion_group)->std::int64_t
 	{
 		std::unique_lock<std::recursive_mutex> running_lck(imp_->mu_running_);
 		if (!imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to get current execute ID, because ControlServer is not running"));
+		if (motion_group >= imp_->group_num_.load())LOG_AND_THROW(std::runtime_error("failed to get current execute ID, because motion group does not exist"));
 
 		// 只有execute_cmd函数才可能会改变cmd_queue中的数据
-		auto cmd_end = imp_->cmd_end_.load();
-		auto cmd_now = imp_->cmd_now_.load();
+		auto &group = imp_->groups_[motion_group];
+		auto cmd_end = group.cmd_end_.load();
+		auto cmd_now = group.cmd_now_.load();
 
-		return cmd_now<cmd_end ? imp_->internal_data_queue_[cmd_now % Imp::CMD_POOL_SIZE]->target->command_id : 0;
+		return cmd_now<cmd_end ? group.target_queue_[cmd_now % Imp::CMD_POOL_SIZE]->command_id : 0;
 	}
-	auto ControlServer::currentCollectId()->std::int64_t
+	auto ControlServer::currentCollectId(aris::Size motion_group)->std::int64_t
 	{
 		std::unique_lock<std::recursive_mutex> running_lck(imp_->mu_running_);
 		if (!imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to get current collect ID, because ControlServer is not running"));
+		if (motion_group >= imp_->group_num_.load())LOG_AND_THROW(std::runtime_error("failed to get current collect ID, because motion group does not exist"));
 
 		// 只有execute_cmd函数才可能会改变cmd_queue中的数据
-		auto cmd_end = imp_->cmd_end_.load();
-		auto cmd_collect = imp_->cmd_collect_.load();
+		auto &group = imp_->groups_[motion_group];
+		auto cmd_end = group.cmd_end_.load();
+		auto cmd_collect = group.cmd_collect_.load();
 
-		return cmd_collect<cmd_end ? imp_->internal_data_queue_[cmd_collect % Imp::CMD_POOL_SIZE]->target->command_id : 0;
+		return cmd_collect<cmd_end ? group.target_queue_[cmd_collect % Imp::CMD_POOL_SIZE]->command_id : 0;
 	}
 	auto ControlServer::start()->void
 	{
 		std::unique_lock<std::recursive_mutex> running_lck(imp_->mu_running_);
 		if (imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to start server, because it is already started "));
-		imp_->is_running_ = true;
+		// 检查运动组，未配置时所有电机构成一个运动组 //
+		std::vector<std::vector<aris::Size>> group_motions;
+		aris::Size motion_num = 0;
+		for (auto &s : controller().slavePool())if (dynamic_cast<aris::control::Motion*>(&s))++motion_num;
+		for (auto &g : motionGroupPool())group_motions.push_back(g.motions());
+		if (group_motions.empty())
+		{
+			group_motions.push_back(std::vector<aris::Size>(motion_num));
+			for (aris::Size i = 0; i < motion_num; ++i)group_motions.back()[i] = i;
+		}
+		if (group_motions.size() > Imp::MAX_GROUP_NUM)
+		{
+			LOG_AND_THROW(std::runtime_error("failed to start server, because there are more than " + std::to_string(Imp::MAX_GROUP_NUM) + " motion groups"));
+		}
+		std::vector<int> motion_group_count(motion_num, 0);
+		for (auto &motions : group_motions)for (auto id : motions)if (id < motion_num)++motion_group_count[id]; else motion_group_count.push_back(2);
+		if (std::any_of(motion_group_count.begin(), motion_group_count.end(), [](int c) { return c != 1; }))
+		{
+			LOG_AND_THROW(std::runtime_error("failed to start server, because each motion must belong to exactly one motion group"));
+		}
+		recorder().start(controller(), model()); // 通道可能越界，需要在修改任何状态之前启动 //
 
-		// 得到电机向量以及数据 //
-		imp_->last_pvc.clear();
-		imp_->last_pvc.resize(controller().slavePool().size(), Imp::PVC{ 0,0,0 });
-		imp_->last_last_pvc.clear();
-		imp_->last_last_pvc.resize(controller().slavePool().size(), Imp::PVC{ 0,0,0 });
+		// 得到电机限位，并清空历史数据 //
+		for (aris::Size g = 0; g < group_motions.size(); ++g)
+		{
+			auto &group = imp_->groups_[g];
+			group.motions_ = group_motions[g];
+			group.checker_.bind(controller(), group.motions_);
+			group.cmd_now_.store(0);
+			group.last_cmd_now_ = 0;
+			group.cmd_end_.store(0);
+			group.cmd_collect_.store(0);
+			group.cmd_reserve_.store(0);
+			group.count_ = 1;
+			group.idle_error_code_ = 0;
+			group.error_code_ = 0;
+			group.is_correcting_ = false;
+			group.is_blending_ = false;
+			group.blend_pos_.assign(group.motions_.size(), 0.0);
+			group.blend_offset_.assign(group.motions_.size(), 0.0);
+			group.executed_cmd_count_.store(0);
+			group.failed_cmd_count_.store(0);
+			group.busy_count_.store(0);
+		}
+		imp_->group_num_.store(group_motions.size());
 
-		controller().setControlStrategy([this]() {this->imp_->tg(); }); // controller可能被reset，因此这里必须重新设置//
+		// 按运动组、电机和杆件数分配快照，实时线程中不再分配内存 //
+		imp_->snapshot_published_.store(-1);
+		imp_->snapshot_notifier_.wait([&]() { return imp_->snapshot_reading_num_.load() == 0; });
+		imp_->snapshot_items_running_ = imp_->snapshot_items_;
+		for (auto &slot : imp_->snapshot_)
+		{
+			auto &s = slot.data_;
+			auto items = imp_->snapshot_items_running_;
+			auto n = items & (RtSnapshot::MOTION_STATE | RtSnapshot::MOTION_ACTUAL) ? motion_num : 0;
+			s.global_count = 0;
+			s.command_id.assign(group_motions.size(), 0);
+			s.error_code.assign(group_motions.size(), 0);
+			s.status_word.assign(items & RtSnapshot::MOTION_STATE ? n : 0, 0);
+			s.target_pos.assign(items & RtSnapshot::MOTION_STATE ? n : 0, 0.0);
+			s.target_vel.assign(items & RtSnapshot::MOTION_STATE ? n : 0, 0.0);
+			s.target_cur.assign(items & RtSnapshot::MOTION_STATE ? n : 0, 0.0);
+			s.actual_pos.assign(n, 0.0);
+			s.actual_vel.assign(n, 0.0);
+			s.actual_cur.assign(items & RtSnapshot::MOTION_ACTUAL ? n : 0, 0.0);
+			s.part_pm.assign(items & RtSnapshot::PART_PM ? model().partPool().size() * 16 : 0, 0.0);
+		}
 
-		imp_->cmd_now_.store(0);
-		imp_->cmd_end_.store(0);
-		imp_->cmd_collect_.store(0);
+		controller().setControlStrategy([this]() {this->imp_->tg(); }); // controller可能被reset，因此这里必须重新设置//
 
 		// start collect thread //
 		imp_->is_collect_running_ = true;
 		imp_->collect_thread_ = std::thread([this]()
 		{
+			// 依次收集各运动组的指令 //
+			auto has_uncollected = [this]()
+			{
+				for (aris::Size g = 0; g < imp_->group_num_.load(); ++g)
+					if (imp_->groups_[g].cmd_collect_.load() < imp_->groups_[g].cmd_now_.load())return true;
+				return false;
+			};
 			while (this->imp_->is_collect_running_)
 			{
-				auto cmd_collect = imp_->cmd_collect_.load();//原子操作
-				auto cmd_now = imp_->cmd_now_.load();//原子操作
+				imp_->rt_notifier_.wait([&]() { return !imp_->is_collect_running_ || has_uncollected(); });
 
-				if (cmd_collect < cmd_now)
+				for (aris::Size g = 0; g < imp_->group_num_.load(); ++g)
 				{
-					auto internal_data = imp_->internal_data_queue_[cmd_collect % Imp::CMD_POOL_SIZE];
-					auto &target = *internal_data->target;
+					auto &group = imp_->groups_[g];
+					auto cmd_collect = group.cmd_collect_.load();//原子操作
+					if (cmd_collect >= group.cmd_now_.load())continue;
 
-					while (globalCount() < target.begin_global_count + target.count) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+					auto &target = *group.target_queue_[cmd_collect % Imp::CMD_POOL_SIZE];
+					imp_->rt_notifier_.wait([&]() { return globalCount() >= target.begin_global_count + target.count; });
 					LOG_INFO << "cmd " << target.command_id << " stastics:" << std::endl
 						<< std::setw(aris::core::LOG_SPACE_WIDTH) << '|' << std::setw(20) << "avg time(ns):" << std::int64_t(target.rt_stastic.avg_time_consumed) << std::endl
 						<< std::setw(aris::core::LOG_SPACE_WIDTH) << '|' << std::setw(20) << "max time(ns):" << target.rt_stastic.max_time_consumed << std::endl
@@ -681,18 +870,18 @@ namespace aris::server
 						LOG_INFO << "server collect cmd " << target.command_id << std::endl;
 						target.plan->collectNrt(target);
 					}
-					internal_data->ret_promise.set_value();
-					imp_->cmd_collect_.store(cmd_collect + 1);
-				}
-				else
-				{
-					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					target.finished.finish();
+					group.cmd_collect_.store(cmd_collect + 1);
+					imp_->collect_notifier_.notify();
 				}
 			}
 		});
 
 		sensorRoot().start();
 		controller().start();
+
+		// 所有状态就绪后才允许提交指令 //
+		imp_->is_running_ = true;
 	}
 	auto ControlServer::stop()->void
 	{
@@ -700,26 +889,60 @@ namespace aris::server
 		if (!imp_->is_running_)LOG_AND_THROW(std::runtime_error("failed to stop server, because it is not running"));
 		imp_->is_running_ = false;
 
+		// 等待正在提交的指令 //
+		imp_->collect_notifier_.notify();
+		imp_->submit_notifier_.wait([&]() { return imp_->submitting_num_.load() == 0; });
+
 		// 清除所有指令，并回收所有指令 //
-		imp_->cmd_now_.store(imp_->cmd_end_.load());
-		while (imp_->cmd_collect_.load() < imp_->cmd_end_.load()) { std::this_thread::yield(); }
+		for (aris::Size g = 0; g < imp_->group_num_.load(); ++g)
+		{
+			auto &group = imp_->groups_[g];
+			group.cmd_now_.store(group.cmd_end_.load());
+			imp_->rt_notifier_.notify();
+			imp_->collect_notifier_.wait([&]() { return group.cmd_collect_.load() >= group.cmd_end_.load(); });
+		}
 		imp_->is_collect_running_ = false;
+		imp_->rt_notifier_.notify();
 		imp_->collect_thread_.join();
 
 		// 停止控制器 //
 		controller().stop();
 		sensorRoot().stop();
+		recorder().stop();
 	}
 	auto ControlServer::running()->bool { return imp_->is_running_; }
 	auto ControlServer::waitForAllExecution()->void 
 	{
-		auto cmd_end = imp_->cmd_end_.load();//原子操作
-		while (cmd_end != imp_->cmd_now_.load())std::this_thread::sleep_for(std::chrono::milliseconds(1));//原子操作
+		for (aris::Size g = 0; g < imp_->group_num_.load(); ++g)
+		{
+			auto &group = imp_->groups_[g];
+			auto cmd_end = group.cmd_end_.load();//原子操作
+			imp_->waitRt(imp_->rt_notifier_, [&]() { return cmd_end <= group.cmd_now_.load(); }, []() { return true; });//原子操作
+		}
 	}
 	auto ControlServer::waitForAllCollection()->void 
 	{
-		auto cmd_end = imp_->cmd_end_.load();//原子操作
-		while (cmd_end != imp_->cmd_collect_.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));//原子操作
+		for (aris::Size g = 0; g < imp_->group_num_.load(); ++g)
+		{
+			auto &group = imp_->groups_[g];
+			auto cmd_end = group.cmd_end_.load();//原子操作
+			imp_->waitRt(imp_->collect_notifier_, [&]() { return cmd_end <= group.cmd_collect_.load(); }, [&]() { return imp_->collectNeedRt(group); });//原子操作
+		}
+	}
+	auto ControlServer::motionGroupPool()->aris::core::ObjectPool<MotionGroup>& { return *imp_->motion_group_pool_; }
+	auto ControlServer::motionGroupStastics(aris::Size motion_group)->MotionGroup::Stastics
+	{
+		if (motion_group >= imp_->group_num_.load())LOG_AND_THROW(std::runtime_error("failed to get motion group stastics, because motion group does not exist"));
+		auto &group = imp_->groups_[motion_group];
+		auto cmd_now = group.cmd_now_.load();
+		auto cmd_end = group.cmd_end_.load();
+		return MotionGroup::Stastics
+		{
+			group.executed_cmd_count_.load(),
+			group.failed_cmd_count_.load(),
+			group.busy_count_.load(),
+			cmd_now < cmd_end ? static_cast<std::int64_t>(group.target_queue_[cmd_now % Imp::CMD_POOL_SIZE]->command_id) : 0
+		};
 	}
 	auto ControlServer::getRtData(const std::function<void(ControlServer&, std::any&)>& get_func, std::any& data)->void
 	{
@@ -732,10 +955,44 @@ namespace aris::server
 		imp_->if_get_data_ready_.store(false);
 		imp_->if_get_data_.store(true);
 
-		while (!imp_->if_get_data_ready_.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		imp_->waitRt(imp_->rt_notifier_, [&]() { return imp_->if_get_data_ready_.load(); }, []() { return true; });
 
 		imp_->if_get_data_ready_.store(false);
 	}
+	auto ControlServer::setStepOnRtWait(bool is_step)->void { imp_->is_step_on_rt_wait_ = is_step; }
+	auto ControlServer::stepOnRtWait()const->bool { return imp_->is_step_on_rt_wait_; }
+	auto ControlServer::setRtSnapshotItems(std::uint32_t items)->void { imp_->snapshot_items_ = items; }
+	auto ControlServer::rtSnapshotItems()const->std::uint32_t { return imp_->snapshot_items_; }
+	auto ControlServer::rtSnapshot(RtSnapshot &snapshot)->bool
+	{
+		// 登记后再次检查是否运行，复制期间 start() 不会重新分配快照 //
+		// 停止后新的读取者在登记前即返回，start() 的等待不会被持续读取的线程饿死 //
+		if (!imp_->is_running_)return false;
+
+		struct ReadGuard
+		{
+			Imp *imp;
+			~ReadGuard() { if (--imp->snapshot_reading_num_ == 0)imp->snapshot_notifier_.notify(); }
+		};
+		++imp_->snapshot_reading_num_;
+		ReadGuard read_guard{ imp_.get() };
+
+		if (!imp_->is_running_)return false;
+
+		for (;;)
+		{
+			auto idx = imp_->snapshot_published_.load(std::memory_order_acquire);
+			if (idx < 0)return false;
+
+			// 复制期间实时线程再次写入这份缓冲区时，序号改变，重新复制 //
+			auto &slot = imp_->snapshot_[idx];
+			auto seq = slot.seq_.load(std::memory_order_acquire);
+			if (seq & 1)continue;
+			snapshot = slot.data_;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.seq_.load(std::memory_order_relaxed) == seq)return true;
+		}
+	}
 	ControlServer::~ControlServer() = default;
 	ControlServer::ControlServer() :imp_(new Imp(this))
 	{
@@ -749,5 +1006,10 @@ namespace aris::server
 		children().push_back_ptr(ins);
 		imp_->interface_root_ = ins;
 		this->interfaceRoot().loadXmlStr("<InterfaceRoot/>");
+
+		imp_->recorder_ = &add<Recorder>("recorder");
+
+		aris::core::Object::registerTypeGlobal<aris::core::ObjectPool<MotionGroup> >();
+		imp_->motion_group_pool_ = &add<aris::core::ObjectPool<MotionGroup> >("motion_group_pool");
 	}
 }
@@ -3,6 +3,12 @@
 #include <iomanip>
 #include <algorithm>
 #include <thread>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
 #include <aris/control/control.hpp>
 #include "test_control_ethercat.h"
 
@@ -412,9 +418,372 @@ void test_sdo_code()
 
 }
 
+void test_pdo_binding()
+{
+	try
+	{
+		std::cout << "test pdo binding" << std::endl;
+
+		aris::control::EthercatController mst;
+
+		// 第一个entry只有1位，使后续entry都不是字节对齐的 //
+		std::string xml_str =
+			"<EthercatMotion phy_id=\"0\" product_code=\"0x0\" vendor_id=\"0x000002E1\" revision_num=\"0x29001\" dc_assign_activate=\"0x0300\" pos_factor=\"100\">"
+			"	<SyncManagerPoolObject>"
+			"		<SyncManager is_tx=\"false\">"
+			"			<Pdo index=\"0x1600\" is_tx=\"false\">"
+			"				<PdoEntry name=\"bit\" index=\"0x2000\" subindex=\"0x00\" size=\"1\"/>"
+			"				<PdoEntry name=\"control_word\" index=\"0x6040\" subindex=\"0x00\" size=\"16\"/>"
+			"				<PdoEntry name=\"target_pos\" index=\"0x607A\" subindex=\"0x00\" size=\"32\"/>"
+			"			</Pdo>"
+			"		</SyncManager>"
+			"		<SyncManager is_tx=\"true\">"
+			"			<Pdo index=\"0x1A00\" is_tx=\"true\">"
+			"				<PdoEntry name=\"status_word\" index=\"0x6041\" subindex=\"0x00\" size=\"16\"/>"
+			"				<PdoEntry name=\"pos_actual_value\" index=\"0x6064\" subindex=\"0x00\" size=\"32\"/>"
+			"			</Pdo>"
+			"		</SyncManager>"
+			"	</SyncManagerPoolObject>"
+			"</EthercatMotion>";
+		auto &mot = mst.slavePool().add<aris::control::EthercatMotion>();
+		mot.loadXmlStr(xml_str);
+
+		std::atomic_int count{ 0 };
+		mst.setControlStrategy([&]()
+		{
+			if (count > 10) return;
+			
+			mot.setControlWord(0x0F);
+			mot.setTargetPos(count * 0.5);
+			
+			std::uint16_t control_word;
+			std::int32_t target_pos;
+			mot.readPdo(0x6040, 0x00, control_word);
+			mot.readPdo(0x607A, 0x00, target_pos);
+			if (control_word != 0x0F || target_pos != count * 50) std::cout << "pdo binding failed" << std::endl;
+
+			mot.writePdo(mot.pdoBinding(0x6064, 0x00), static_cast<std::int32_t>(count * 100));
+			if (std::abs(mot.actualPos() - count) > 1e-10)std::cout << "pdo binding failed" << std::endl;
+			
+			++count;
+		});
+		mst.start();
+		while (count < 10) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		mst.stop();
+	}
+	catch (std::exception &e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+
+void test_simulated_drive()
+{
+	try
+	{
+		std::cout << "test simulated drive" << std::endl;
+
+		aris::control::EthercatController mst;
+		mst.setVirtualTime(true);
+		mst.setSimulationFollowingRatio(0.5);
+		mst.setSimulationHomeCount(10);
+
+		std::string xml_str =
+			" product_code=\"0x0\" vendor_id=\"0x000002E1\" revision_num=\"0x29001\" dc_assign_activate=\"0x0300\" max_pos=\"10\" min_pos=\"-10\" pos_factor=\"1000\">"
+			"	<SyncManagerPoolObject>"
+			"		<SyncManager is_tx=\"false\">"
+			"			<Pdo index=\"0x1600\" is_tx=\"false\">"
+			"				<PdoEntry name=\"control_word\" index=\"0x6040\" subindex=\"0x00\" size=\"16\"/>"
+			"				<PdoEntry name=\"mode_of_operation\" index=\"0x6060\" subindex=\"0x00\" size=\"8\"/>"
+			"				<PdoEntry name=\"target_pos\" index=\"0x607A\" subindex=\"0x00\" size=\"32\"/>"
+			"				<PdoEntry name=\"target_vel\" index=\"0x60FF\" subindex=\"0x00\" size=\"32\"/>"
+			"			</Pdo>"
+			"		</SyncManager>"
+			"		<SyncManager is_tx=\"true\">"
+			"			<Pdo index=\"0x1A00\" is_tx=\"true\">"
+			"				<PdoEntry name=\"status_word\" index=\"0x6041\" subindex=\"0x00\" size=\"16\"/>"
+			"				<PdoEntry name=\"mode_of_display\" index=\"0x6061\" subindex=\"0x00\" size=\"8\"/>"
+			"				<PdoEntry name=\"pos_actual_value\" index=\"0x6064\" subindex=\"0x00\" size=\"32\"/>"
+			"				<PdoEntry name=\"vel_actual_value\" index=\"0x606C\" subindex=\"0x00\" size=\"32\"/>"
+			"			</Pdo>"
+			"		</SyncManager>"
+			"	</SyncManagerPoolObject>"
+			"</EthercatMotion>";
+		const int motion_num = 64;
+		for (int i = 0; i < motion_num; ++i)
+		{
+			auto &mot = mst.slavePool().add<aris::control::EthercatMotion>();
+			mot.loadXmlStr("<EthercatMotion phy_id=\"" + std::to_string(i) + "\"" + xml_str);
+		}
+
+		// 0:使能 1:运动到1.0 2:电机0回零 3:去使能 4:结束 //
+		std::atomic_int state{ 0 };
+		mst.setControlStrategy([&]()
+		{
+			int ret = 0;
+			switch (state)
+			{
+			case 0:
+				for (auto &m : mst.motionPool())ret += std::abs(m.mode(8)) + std::abs(m.enable());
+				if (ret == 0)++state;
+				break;
+			case 1:
+				for (auto &m : mst.motionPool())m.setTargetPos(1.0);
+				if (std::all_of(mst.motionPool().begin(), mst.motionPool().end(), [](auto &m) { return std::abs(m.actualPos() - 1.0) < 1e-3; }))++state;
+				break;
+			case 2:
+				if (mst.motionPool()[0].home() == 0)++state;
+				break;
+			case 3:
+				for (auto &m : mst.motionPool())ret += std::abs(m.disable());
+				if (ret == 0)++state;
+				break;
+			default:
+				break;
+			}
+		});
+
+		mst.start();
+		std::int64_t state_count[4]{ 0 };
+		for (int i = 0; i < 1000 && state < 4; ++i)
+		{
+			auto last_state = state.load();
+			mst.step();
+			if (state != last_state) state_count[last_state] = mst.cycleCount();
+		}
+
+		// 使能需要经过状态机的三次转换以及 EthercatMotion 的等待，半比例跟随时约10个周期到位，回零需要等待仿真的周期 //
+		if (state != 4
+			|| state_count[0] < 20 || state_count[0] > 40
+			|| state_count[1] - state_count[0] < 8 || state_count[1] - state_count[0] > 14
+			|| state_count[2] - state_count[1] < 10
+			|| std::abs(mst.motionPool()[0].actualPos()) > 1e-10
+			|| std::abs(mst.motionPool()[1].actualPos() - 1.0) > 1e-3
+			|| std::any_of(mst.motionPool().begin(), mst.motionPool().end(), [](auto &m) { return (m.statusWord() & 0x6F) != 0x23; }))
+			std::cout << "simulated drive failed" << std::endl;
+
+		mst.stop();
+	}
+	catch (std::exception &e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+
+void test_dc_sync()
+{
+	try
+	{
+		std::cout << "test dc sync" << std::endl;
+
+		aris::control::EthercatMaster mst;
+		mst.setSimulationClockDriftPpm(100.0);
+
+		// 参考时钟每周期比主站快100ns，修正后主站的时间基准每周期前移100ns，实时时钟上的周期相应缩短 //
+		mst.setDcCorrection(true);
+		mst.setDcCorrectionGain(0.2, 0.02);
+		mst.start();
+		while (mst.dcSyncStatistics().count < 400) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		mst.stop();
+
+		auto stastics = mst.dcSyncStatistics();
+		if (std::abs(stastics.offset_ns) > 2 || std::abs(stastics.correction_ns - 100) > 2 || stastics.max_abs_offset_ns < 100 || stastics.max_abs_jitter_ns < 100
+			|| stastics.time_base_ns < 30000)
+			std::cout << "dc sync failed" << std::endl;
+
+		// 不修正时，参考时钟每周期被改写为主站时间，offset 为一个周期内的漂移 //
+		mst.setDcCorrection(false);
+		mst.start();
+		while (mst.dcSyncStatistics().count < 100) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		mst.stop();
+
+		stastics = mst.dcSyncStatistics();
+		if (std::abs(stastics.offset_ns - 100) > 2 || stastics.max_abs_offset_ns > 102 || stastics.correction_ns != 0 || stastics.time_base_ns != 0)
+			std::cout << "dc sync failed" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+
+void test_sdo_async()
+{
+	try
+	{
+		std::cout << "test sdo async" << std::endl;
+
+		aris::control::EthercatMaster mst;
+		mst.setSimulationSdoLatency(std::chrono::milliseconds(5));
+		mst.setSdoWorkerNum(4);
+		const int slave_num = 20;
+		for (int i = 0; i < slave_num; ++i) mst.slavePool().add<aris::control::EthercatSlave>("slave_" + std::to_string(i), static_cast<std::uint16_t>(i));
+		auto &s0 = dynamic_cast<aris::control::EthercatSlave&>(mst.slavePool()[0]);
+
+		// 同步读写，不存在的对象抛出异常 //
+		std::int32_t value{ 0 };
+		s0.writeSdo(0x607C, 0x00, static_cast<std::int32_t>(-100));
+		s0.readSdo(0x607C, 0x00, value);
+		if (value != -100) std::cout << "sdo async failed" << std::endl;
+		try
+		{
+			s0.readSdo(0x6099, 0x01, value);
+			std::cout << "sdo async failed" << std::endl;
+		}
+		catch (std::runtime_error &) {}
+
+		// 批量下载，不同从站同时进行，同一从站按顺序 //
+		std::atomic_int callback_count{ 0 };
+		std::vector<std::shared_ptr<aris::control::SdoRequest>> reads;
+		auto begin = std::chrono::steady_clock::now();
+		for (auto &sla : mst.slavePool())
+		{
+			auto &ec_sla = dynamic_cast<aris::control::EthercatSlave&>(sla);
+			for (std::uint8_t sub = 1; sub <= 3; ++sub)
+			{
+				ec_sla.writeSdoAsync(0x2000, sub, static_cast<std::int32_t>(sla.phyId() * 10 + sub), [&](aris::control::SdoRequest &) { ++callback_count; });
+				reads.push_back(ec_sla.readSdoAsync(0x2000, sub, sizeof(std::int32_t), [&](aris::control::SdoRequest &) { ++callback_count; }));
+			}
+		}
+		mst.waitSdo();
+		auto elapsed = std::chrono::steady_clock::now() - begin;
+
+		if (callback_count != slave_num * 6 || elapsed > std::chrono::milliseconds(slave_num * 6 * 5 * 2 / 3))
+			std::cout << "sdo async failed" << std::endl;
+		for (aris::Size i = 0; i < reads.size(); ++i)
+		{
+			if (!reads[i]->finished.isFinished() || reads[i]->state != aris::control::SdoRequest::SUCCESS || reads[i]->value<std::int32_t>() != static_cast<std::int32_t>(i / 3 * 10 + i % 3 + 1))
+				std::cout << "sdo async failed" << std::endl;
+		}
+
+		// 从站拒绝时返回 abort code，在队列中等待超时的请求不再执行 //
+		auto missing = s0.readSdoAsync(0x6099, 0x01, sizeof(std::int32_t));
+		s0.writeSdoAsync(0x2001, 0x00, static_cast<std::int32_t>(1));
+		auto expired = s0.writeSdoAsync(0x2001, 0x00, static_cast<std::int32_t>(2), nullptr, std::chrono::milliseconds(0));
+		missing->finished.wait();
+		expired->finished.wait();
+		s0.readSdo(0x2001, 0x00, value);
+		if (missing->state != aris::control::SdoRequest::FAILED || missing->abort_code != 0x06020000 || expired->state != aris::control::SdoRequest::TIMEOUT || value != 1)
+			std::cout << "sdo async failed" << std::endl;
+
+		// 主站析构时队列中的请求以 ABORTED 结束，只等待正在执行的请求 //
+		std::vector<std::shared_ptr<aris::control::SdoRequest>> pending;
+		std::atomic_int aborted_count{ 0 };
+		begin = std::chrono::steady_clock::now();
+		{
+			aris::control::EthercatMaster tmp;
+			tmp.setSimulationSdoLatency(std::chrono::milliseconds(20));
+			tmp.setSdoWorkerNum(1);
+			tmp.slavePool().add<aris::control::EthercatSlave>("slave", 0);
+			auto &sla = dynamic_cast<aris::control::EthercatSlave&>(tmp.slavePool()[0]);
+			for (std::int32_t i = 0; i < 10; ++i)
+				pending.push_back(sla.writeSdoAsync(0x2000, 0x01, i, [&](aris::control::SdoRequest &r) { if (r.state == aris::control::SdoRequest::ABORTED) ++aborted_count; }));
+		}
+		elapsed = std::chrono::steady_clock::now() - begin;
+
+		int aborted_state_count{ 0 };
+		for (auto &r : pending)
+		{
+			if (!r->finished.isFinished() || r->state == aris::control::SdoRequest::PENDING) std::cout << "sdo async failed" << std::endl;
+			if (r->state == aris::control::SdoRequest::ABORTED) ++aborted_state_count;
+		}
+		if (aborted_count < 9 || aborted_state_count != aborted_count || elapsed > std::chrono::milliseconds(100))
+			std::cout << "sdo async failed" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+
+void test_scan_cache()
+{
+	try
+	{
+		std::cout << "test scan cache" << std::endl;
+
+		auto cache_path = (std::filesystem::temp_directory_path() / "aris_test_scan_cache.xml").string();
+		std::filesystem::remove(cache_path);
+
+		// 总线上两种型号的从站交替排列 //
+		auto make_bus = [](aris::control::EthercatMaster &mst, int changed_position)
+		{
+			mst.simulationBus().clear();
+			for (int i = 0; i < 8; ++i)
+			{
+				std::uint32_t product_code = i == changed_position ? 0x30 : (i % 2 ? 0x20 : 0x10);
+				auto &sla = mst.simulationBus().add<aris::control::EthercatSlave>("sla", static_cast<std::uint16_t>(i), 0x9a, product_code, 0x01);
+				auto &sm = sla.smPool().add<aris::control::SyncManager>("sm", true);
+				for (std::uint16_t p = 0; p < product_code / 0x10; ++p)
+				{
+					auto &pdo = sm.add<aris::control::Pdo>("pdo", static_cast<std::uint16_t>(0x1A00 + p));
+					pdo.add<aris::control::PdoEntry>("entry", 0x6041, 0x00, 16);
+					pdo.add<aris::control::PdoEntry>("entry", static_cast<std::uint16_t>(0x6064 + p), 0x00, 32);
+				}
+			}
+		};
+		auto check_slaves = [](aris::control::EthercatMaster &mst)
+		{
+			if (mst.slavePool().size() != mst.simulationBus().size()) return false;
+			for (aris::Size i = 0; i < mst.slavePool().size(); ++i)
+			{
+				auto &sla = dynamic_cast<aris::control::EthercatSlave&>(mst.slavePool()[i]);
+				auto &bus_sla = dynamic_cast<aris::control::EthercatSlave&>(mst.simulationBus()[i]);
+				if (sla.phyId() != i || sla.productCode() != bus_sla.productCode() || sla.smPool().size() != 1 || sla.smPool()[0].size() != bus_sla.smPool()[0].size()) return false;
+				for (aris::Size p = 0; p < sla.smPool()[0].size(); ++p)
+					if (sla.smPool()[0][p].index() != bus_sla.smPool()[0][p].index() || sla.smPool()[0][p][1].index() != bus_sla.smPool()[0][p][1].index()) return false;
+			}
+			return true;
+		};
+
+		aris::control::EthercatMaster mst;
+		mst.setScanCachePath(cache_path);
+		mst.setSimulationSdoLatency(std::chrono::milliseconds(2));
+		make_bus(mst, -1);
+
+		// 每种型号只读取一次 //
+		auto stastics = mst.scan();
+		if (stastics.kept_count != 0 || stastics.rebuilt_count != 8 || stastics.fetched_count != 2 || !check_slaves(mst))
+			std::cout << "scan cache failed" << std::endl;
+
+		// 总线没有变化 //
+		stastics = mst.scan();
+		if (stastics.kept_count != 8 || stastics.rebuilt_count != 0 || stastics.fetched_count != 0 || !check_slaves(mst))
+			std::cout << "scan cache failed" << std::endl;
+
+		// 第5个从站换成新型号，之前的从站保持不变 //
+		auto first_slave = &mst.slavePool()[0];
+		make_bus(mst, 5);
+		stastics = mst.scan();
+		if (stastics.kept_count != 5 || stastics.rebuilt_count != 3 || stastics.fetched_count != 1 || !check_slaves(mst) || first_slave != &mst.slavePool()[0])
+			std::cout << "scan cache failed" << std::endl;
+
+		// 新的主站从磁盘上的缓存中读取所有型号 //
+		aris::control::EthercatMaster mst2;
+		mst2.setScanCachePath(cache_path);
+		make_bus(mst2, 5);
+		stastics = mst2.scan();
+		if (stastics.kept_count != 0 || stastics.rebuilt_count != 8 || stastics.fetched_count != 0 || !check_slaves(mst2))
+			std::cout << "scan cache failed" << std::endl;
+
+		std::filesystem::remove(cache_path);
+	}
+	catch (std::exception &e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+
 void test_control_ethercat()
 {
 	test_bit();
+	test_pdo_binding();
+#ifndef ARIS_USE_ETHERLAB
+	test_simulated_drive();
+	test_dc_sync();
+	test_sdo_async();
+	test_scan_cache();
+#endif
 	test_scan();
 	//test_pdo();
 	//test_pdo_xml();
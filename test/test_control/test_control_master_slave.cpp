@@ -2,6 +2,9 @@
 #include <aris/control/control.hpp>
 #include <atomic>
 #include <thread>
+#include <iomanip>
+#include <cmath>
+#include <sstream>
 #include "test_control_master_slave.h"
 
 using namespace aris::control;
@@ -46,11 +49,87 @@ void test_construct()
 		std::cout << "overruns   :" << stastics[i].overrun_count << std::endl;
 	}
 
+	const char *phase_names[aris::control::Master::RT_PHASE_SIZE]{ "recv", "strategy", "sync", "send", "flush log", "wait jitter", "total" };
+	for (int i = 0; i < aris::control::Master::RT_PHASE_SIZE; ++i)
+	{
+		aris::control::Master::RtPhaseHistogram histogram;
+		m.rtPhaseHistogram(static_cast<aris::control::Master::RtPhase>(i), &histogram);
+		std::cout << std::setw(12) << phase_names[i] << "  p50:" << std::setw(10) << histogram.percentile(0.5) 
+			<< "  p99:" << std::setw(10) << histogram.percentile(0.99) << "  max:" << std::setw(10) << histogram.max_time << std::endl;
+	}
+
 	m.stop();
 	std::cout << m.xmlString() << std::endl;
 }
+void test_phase_histogram()
+{
+	using Histogram = aris::control::Master::RtPhaseHistogram;
+	for (std::int64_t ns : {0, 1, 31, 32, 33, 47, 48, 1000, 999999, 1000000, 123456789})
+	{
+		auto bucket = Histogram::bucketIndex(ns);
+		if (Histogram::bucketLowerBound(bucket) > ns || Histogram::bucketLowerBound(bucket + 1) <= ns)std::cout << "phase histogram bucket failed" << std::endl;
+		if (bucket > 0 && Histogram::bucketIndex(Histogram::bucketLowerBound(bucket) - 1) != bucket - 1)std::cout << "phase histogram bucket failed" << std::endl;
+	}
+	
+	Histogram h{};
+	for (std::int64_t ns = 1; ns <= 1000; ++ns)
+	{
+		++h.count[Histogram::bucketIndex(ns * 1000)];
+		++h.total_count;
+		h.max_time = ns * 1000;
+	}
+	if (std::abs(h.percentile(0.5) - 500000) > 500000 / 16 || h.percentile(1.0) != 1000000)std::cout << "phase histogram percentile failed" << std::endl;
+}
+
+void test_multi_rate()
+{
+	aris::control::Master m;
+	m.loadXmlStr("<Master sample_period_ns=\"250000\"/>");
+	if (m.samplePeriodNs() != 250000)std::cout << "master sample period failed" << std::endl;
+
+	std::atomic_int count{ 0 };
+	int count_1ms{ 0 }, count_10ms{ 0 }, first_10ms{ -1 };
+	m.setControlStrategy([&]() { ++count; });
+	m.addSubRateTask([&]() { ++count_1ms; }, 4);
+	m.addSubRateTask([&]() { if (first_10ms < 0)first_10ms = count; ++count_10ms; }, 40, 3);
+	m.start();
+	while (count < 400)std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	m.stop();
+
+	// stop 时count可能已经超过400 //
+	if (count_1ms != (count + 3) / 4 || count_10ms != (count + 36) / 40 || first_10ms != 4)std::cout << "master sub rate task failed" << std::endl;
+}
+
+void test_record()
+{
+	aris::control::Master m;
+
+	std::atomic_int count{ 0 };
+	m.setControlStrategy([&]() 
+	{
+		if (count < 3)m.moutRecord("record count:{} value:{} flag:{}\n", count.load(), count * 0.5, count % 2 == 0);
+		++count;
+	});
+
+	// mout线程在stop时会把pipe中剩余的记录全部写出，因此stop后即可检查输出 //
+	std::stringstream ss;
+	auto cout_buf = std::cout.rdbuf(ss.rdbuf());
+	m.start();
+	while (count < 10)std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	m.stop();
+	std::cout.rdbuf(cout_buf);
+
+	std::string records, line;
+	int record_num{ 0 };
+	while (std::getline(ss, line))if (line.compare(0, 7, "record ") == 0) { records += line + "\n"; ++record_num; }
+	if (record_num != 3 || records != "record count:0 value:0 flag:1\nrecord count:1 value:0.5 flag:0\nrecord count:2 value:1 flag:1\n")
+		std::cout << "master record failed" << std::endl;
+}
 
 void test_control_master_slave()
 {
+	test_record();
+	test_phase_histogram();
+	test_multi_rate();
 	test_construct();
 }
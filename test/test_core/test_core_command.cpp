@@ -1,4 +1,6 @@
 ﻿#include <iostream>
+#include <thread>
+#include <atomic>
 #include <aris/core/core.hpp>
 #include "test_core_command.h"
 
@@ -299,11 +301,79 @@ void test_command_code()
 	}
 }
 
+void test_command_concurrent_parse()
+{
+	try
+	{
+		CommandParser parser;
+		parser.loadXmlStr(
+			"<CommandParser>"
+			"	<CommandPoolObject>"
+			"		<Command name=\"move\">"
+			"			<GroupParam>"
+			"				<Param name=\"pos\" abbreviation=\"p\" default=\"0\"/>"
+			"				<Param name=\"vel\" abbreviation=\"v\" default=\"1\"/>"
+			"			</GroupParam>"
+			"		</Command>"
+			"	</CommandPoolObject>"
+			"</CommandParser>");
+		parser.init();
+
+		// 同一个 parser 在多个线程中同时解析 //
+		std::atomic_int error_count{ 0 };
+		std::vector<std::thread> threads;
+		for (int i = 0; i < 4; ++i)
+		{
+			threads.push_back(std::thread([&, i]()
+			{
+				for (int j = 0; j < 1000; ++j)
+				{
+					std::string cmd;
+					std::map<std::string, std::string> params;
+					auto value = std::to_string(i * 1000 + j);
+					parser.parse("move -p=" + value, cmd, params);
+					if (cmd != "move" || params.size() != 2 || params.at("pos") != value || params.at("vel") != "1")++error_count;
+
+					try { parser.parse("move -p=1 -p=2", cmd, params); ++error_count; }
+					catch (std::exception &) {}
+				}
+			}));
+		}
+		for (auto &t : threads)t.join();
+		if (error_count)std::cout << "test command concurrent parse failed" << std::endl;
+
+		// 新增的命令在下一次解析时自动加入索引 //
+		parser.commandPool().add<Command>("stop");
+		std::string cmd;
+		std::map<std::string, std::string> params;
+		parser.parse("stop", cmd, params);
+		if (cmd != "stop" || !params.empty())std::cout << "test command concurrent parse failed" << std::endl;
+
+		// 修改已有命令的参数后，下一次解析使用新的定义 //
+		auto &move = parser.commandPool().at(0);
+		move.findParam("pos")->setAbbreviation('x');
+		move.findParam("vel")->setDefaultValue("2");
+		parser.parse("move -x=3", cmd, params);
+		if (cmd != "move" || params.at("pos") != "3" || params.at("vel") != "2")std::cout << "test command concurrent parse failed" << std::endl;
+
+		// 替换同名命令后使用新的命令 //
+		parser.commandPool().clear();
+		parser.commandPool().add<Command>("move").add<Param>("acc", "5", 'a');
+		parser.parse("move", cmd, params);
+		if (cmd != "move" || params.size() != 1 || params.at("acc") != "5")std::cout << "test command concurrent parse failed" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cout << "test command concurrent parse failed:" << e.what() << std::endl;
+	}
+}
+
 void test_command()
 {
 	std::cout << std::endl << "-----------------test command---------------------" << std::endl;
 	test_command_xml();
 	test_command_code();
+	test_command_concurrent_parse();
 	std::cout << "-----------------test command finished------------" << std::endl << std::endl;
 }
 
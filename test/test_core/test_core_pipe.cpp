@@ -2,6 +2,7 @@
 #include <thread>
 #include <future>
 #include <sstream>
+#include <algorithm>
 
 #include <aris/core/core.hpp>
 #include "test_core_pipe.h"
@@ -65,9 +66,103 @@ void test_pipe_multi_thread()
 	fu.wait();
 }
 
+void test_pipe_reserve_and_drain()
+{
+	// pool 很小，使消息频繁从尾部折返 //
+	aris::core::Pipe pipe("pipe", 256);
+
+	auto fu = std::async(std::launch::async, [&pipe]()
+	{
+		for (std::uint32_t i = 0; i < 10000; ++i)
+		{
+			auto size = static_cast<aris::core::MsgSize>(i % 37);
+			aris::core::MsgHeader *header;
+			while (!(header = pipe.reserveMsg(size))) std::this_thread::yield();
+			header->msg_id_ = i;
+			std::fill_n(reinterpret_cast<char*>(header) + sizeof(aris::core::MsgHeader), size, static_cast<char>(i));
+			pipe.commitMsg();
+		}
+	});
+
+	std::uint32_t round{ 0 };
+	while (round < 10000)
+	{
+		auto num = pipe.drainMsg([&](const aris::core::MsgHeader &header, const char *data)
+		{
+			if (header.msg_id_ != round || header.msg_size_ != round % 37)std::cout << __FILE__ << __LINE__ << "test_pipe failed" << std::endl;
+			if (std::any_of(data, data + header.msg_size_, [&](char c) { return c != static_cast<char>(round); }))std::cout << __FILE__ << __LINE__ << "test_pipe failed" << std::endl;
+			++round;
+		});
+		if (num == 0)std::this_thread::yield();
+	}
+
+	fu.wait();
+
+	// 满时预留失败 //
+	if (pipe.reserveMsg(256))std::cout << __FILE__ << __LINE__ << "test_pipe failed" << std::endl;
+}
+
+void test_pipe_empty_at_any_offset()
+{
+	// 空管道中，大于 pool 一半的消息在任意起点都能写入，最多等消费者跳过一次跳转 //
+	// 消息至少包含一个header，因此 (0, sizeof(MsgHeader)) 中的位置不会成为起点 //
+	const std::size_t pool_size = 16384;
+	aris::core::Msg big, received;
+	big.resize(8192);
+	for (std::size_t offset = 0; offset < pool_size; offset += 8)
+	{
+		if (offset > 0 && offset < sizeof(aris::core::MsgHeader)) continue;
+
+		aris::core::Pipe pipe("pipe", pool_size);
+		if (offset > 0)
+		{
+			aris::core::Msg filler;
+			filler.resize(static_cast<aris::core::MsgSize>(offset - sizeof(aris::core::MsgHeader)));
+			if (!pipe.sendMsg(filler) || !pipe.recvMsg(received))std::cout << __FILE__ << __LINE__ << "test_pipe failed" << std::endl;
+		}
+
+		big.setMsgID(static_cast<aris::core::MsgID>(offset));
+		std::fill_n(big.data(), big.size(), static_cast<char>(offset / 8));
+		if (!pipe.sendMsg(big) && (pipe.recvMsg(received) || !pipe.sendMsg(big)))
+		{
+			std::cout << __FILE__ << __LINE__ << "test_pipe failed at offset " << offset << std::endl;
+			continue;
+		}
+		if (!pipe.recvMsg(received) || received.size() != big.size() || received.msgID() != big.msgID() || !std::equal(big.data(), big.data() + big.size(), received.data()))
+			std::cout << __FILE__ << __LINE__ << "test_pipe failed at offset " << offset << std::endl;
+	}
+}
+void test_notifier()
+{
+	aris::core::Notifier notifier;
+	std::atomic<int> value{ 0 };
+
+	// 生产者每次只加1并通知，消费者等待每一个值，任何一次通知丢失都会导致死锁 //
+	auto consumer = std::async(std::launch::async, [&]()
+	{
+		for (int i = 1; i <= 10000; ++i)notifier.wait([&]() { return value.load() >= i; });
+	});
+
+	for (int i = 1; i <= 10000; ++i)
+	{
+		value.store(i);
+		notifier.notify();
+		if (i % 100 == 0)std::this_thread::yield();
+	}
+
+	if (consumer.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+	{
+		std::cout << "test notifier failed" << std::endl;
+		notifier.notify();
+	}
+	consumer.get();
+}
 void test_pipe()
 {
 	std::cout << std::endl << "-----------------test pipe---------------------" << std::endl;
 	test_pipe_multi_thread();
+	test_pipe_reserve_and_drain();
+	test_pipe_empty_at_any_offset();
+	test_notifier();
 	std::cout << "-----------------test pipe finished------------" << std::endl << std::endl;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 ﻿#include "test_dynamic_matrix.h"
 #include <iostream>
+#include <vector>
 #include <aris/dynamic/dynamic.hpp>
 
 using namespace aris::dynamic;
@@ -537,6 +538,41 @@ void test_multiply()
 	s_mms(2, 4, 3, ma18a, 6, ma18b, 6, oa18_before, 5);
 	if (!s_is_equal(10, oa18_before, oa18, error))std::cout << "\"s_mms with ld\" failed" << std::endl;
 
+	// 编译期确定维数的版本 //
+	double fixed01[]{ 1,2,3,4,5,6,7,8 };
+	s_mma<2, 4, 3>(ma01a, ma01b, fixed01);
+	if (!s_is_equal(8, fixed01, oa01, error))std::cout << "\"s_mma fixed size\" failed" << std::endl;
+
+	double fixed06[]{ 1,2,3,4,0,5,6,7,8,0 };
+	s_mma<2, 4, 3>(ma06a, ColMajor{ 5 }, ma06b, RowMajor{ 6 }, fixed06, RowMajor{ 5 });
+	if (!s_is_equal(10, fixed06, oa06, error))std::cout << "\"s_mmaTN fixed size\" failed" << std::endl;
+
+	double fixed17[]{ 1,2,3,4,5,6,7,8 };
+	s_mms<2, 4, 3>(ma17a, ma17b, fixed17);
+	if (!s_is_equal(8, fixed17, oa17, error))std::cout << "\"s_mms fixed size\" failed" << std::endl;
+
+	// 6x6 与 6x1 由运行期的版本转到展开的版本，须与逐项计算一致 //
+	double a66[36], b66[36], c66[36], d66[36];
+	const double zero66[36]{ 0 };
+	for (int i = 0; i < 36; ++i) { a66[i] = std::sin(i + 1.0); b66[i] = std::cos(i + 1.0); }
+	for (int i = 0; i < 6; ++i)for (int j = 0; j < 6; ++j)
+	{
+		d66[i * 6 + j] = 0.0;
+		for (int u = 0; u < 6; ++u)d66[i * 6 + j] += a66[i * 6 + u] * b66[j * 6 + u];
+	}
+	s_mm(6, 6, 6, a66, 6, b66, ColMajor{ 6 }, c66, 6);
+	if (!s_is_equal(36, c66, d66, error))std::cout << "\"s_mm 6x6\" failed" << std::endl;
+	s_mmi<6, 6, 6>(a66, 6, b66, ColMajor{ 6 }, c66, 6);
+	s_ma(6, 6, d66, c66);
+	if (!s_is_equal(36, c66, zero66, error))std::cout << "\"s_mmi 6x6\" failed" << std::endl;
+	s_mm(6, 1, 6, a66, b66, c66);
+	for (int i = 0; i < 6; ++i)
+	{
+		d66[i] = 0.0;
+		for (int u = 0; u < 6; ++u)d66[i] += a66[i * 6 + u] * b66[u];
+	}
+	if (!s_is_equal(6, c66, d66, error))std::cout << "\"s_mm 6x1\" failed" << std::endl;
+
 	const double v01[]{ 0.3500,0.1966,0.2511,0.6160,0.4733,0.3517,0.8308,0.5853,0.5497,0.9172 };
 	const double v02[]{ 0.8308,0.3517,0.3500,0.6160,0.5853,0.4733,0.2511,0.1966,0.5497,0.9172 };
 	aris::Size p[10]{ 6,5,0,3,7,4,2,1,8,9 };
@@ -1216,6 +1252,80 @@ void test_householder()
 
 
 
+void test_blocked()
+{
+	using aris::Size;
+
+	// 大矩阵的乘法，维数不是分块的整数倍，B 按列存储 //
+	{
+		const Size m = 130, n = 70, k = 90;
+		std::vector<double> A(m * (k + 3)), B(k * n), C(m * n), C_before(m * n), C_expect(m * n);
+		for (Size i = 0; i < A.size(); ++i)A[i] = std::sin(0.37 * i + 0.1);
+		for (Size i = 0; i < B.size(); ++i)B[i] = std::cos(0.53 * i + 0.2);
+		for (Size i = 0; i < C.size(); ++i)C_before[i] = std::sin(0.11 * i);
+
+		const double alpha{ 0.75 };
+		for (Size i = 0; i < m; ++i)for (Size j = 0; j < n; ++j)
+		{
+			double value{ 0.0 };
+			for (Size u = 0; u < k; ++u)value += A[i * (k + 3) + u] * B[j * k + u];
+			C_expect[i * n + j] = C_before[i * n + j] + alpha * value;
+		}
+
+		C = C_before;
+		s_mma(m, n, k, alpha, A.data(), k + 3, B.data(), ColMajor{ k }, C.data(), n);
+		if (!s_is_equal(m * n, C.data(), C_expect.data(), error))std::cout << "\"s_mma blocked\" failed" << std::endl;
+
+		s_mm(m, n, k, A.data(), k + 3, B.data(), ColMajor{ k }, C.data(), n);
+		s_ma(m, n, C_before.data(), C.data());
+		s_nm(m, n, alpha, C.data());
+		s_va(m * n, (1.0 - alpha), C_before.data(), C.data());
+		if (!s_is_equal(m * n, C.data(), C_expect.data(), error))std::cout << "\"s_mm blocked\" failed" << std::endl;
+
+		// 多线程的版本只能显式调用 //
+		C = C_before;
+		s_mma_parallel(m, n, k, alpha, A.data(), to_stride(k + 3), B.data(), to_stride(ColMajor{ k }), C.data(), to_stride(n), 3);
+		if (!s_is_equal(m * n, C.data(), C_expect.data(), error))std::cout << "\"s_mma_parallel\" failed" << std::endl;
+	}
+
+	// 大矩阵的列主元 householder 分解，与逐列计算的版本比较，第5列与第2、3列线性相关 //
+	{
+		const Size m = 600, n = 20;
+		std::vector<double> A(m * n), U(m * n), U_expect(m * n), tau(m), tau_expect(m), b(m), x(m), x_expect(m);
+		std::vector<Size> p(m), p_expect(m);
+		for (Size i = 0; i < m; ++i)
+		{
+			for (Size j = 0; j < n; ++j)A[i * n + j] = std::sin(0.7 * i * (j + 1) + 0.3 * j);
+			A[i * n + 5] = A[i * n + 2] + 2.0 * A[i * n + 3];
+			b[i] = std::cos(0.9 * i);
+		}
+
+		Size rank, rank_expect;
+		s_householder_utp(m, n, A.data(), U.data(), tau.data(), p.data(), rank);
+		s_householder_utp(m, n, A.data(), RowMajor{ n }, U_expect.data(), RowMajor{ n }, tau_expect.data(), 1, p_expect.data(), rank_expect);
+		if (rank != n - 1 || rank != rank_expect || !std::equal(p.begin(), p.begin() + n, p_expect.begin())
+			|| !s_is_equal(rank, tau.data(), tau_expect.data(), 1e-9))
+			std::cout << "\"s_householder_utp blocked\" failed" << std::endl;
+		for (Size i = 0; i < m; ++i)for (Size j = 0; j < n; ++j)
+			if ((j < rank || i < rank) && !s_is_equal(U[i * n + j], U_expect[i * n + j], 1e-9)) { std::cout << "\"s_householder_utp blocked\" failed" << std::endl; i = m; break; }
+
+		s_householder_utp_sov(m, n, 1, rank, U.data(), tau.data(), p.data(), b.data(), x.data());
+		s_householder_utp_sov(m, n, 1, rank_expect, U_expect.data(), tau_expect.data(), p_expect.data(), b.data(), x_expect.data());
+		if (!s_is_equal(n, x.data(), x_expect.data(), 1e-9))std::cout << "\"s_householder_utp_sov blocked\" failed" << std::endl;
+
+		// 多线程的版本在 U 上原地分解 //
+		Size rank_parallel;
+		std::vector<double> U_parallel(A), tau_parallel(m);
+		std::vector<Size> p_parallel(m);
+		s_householder_utp_parallel(m, n, U_parallel.data(), n, tau_parallel.data(), 1, p_parallel.data(), rank_parallel, 1e-10, 3);
+		if (rank_parallel != rank_expect || !std::equal(p_parallel.begin(), p_parallel.begin() + n, p_expect.begin())
+			|| !s_is_equal(rank, tau_parallel.data(), tau_expect.data(), 1e-9))
+			std::cout << "\"s_householder_utp_parallel\" failed" << std::endl;
+		for (Size i = 0; i < m; ++i)for (Size j = 0; j < n; ++j)
+			if ((j < rank || i < rank) && !s_is_equal(U_parallel[i * n + j], U_expect[i * n + j], 1e-9)) { std::cout << "\"s_householder_utp_parallel\" failed" << std::endl; i = m; break; }
+	}
+}
+
 void test_matrix()
 {
 	std::cout << std::endl << "-----------------test matrix--------------------" << std::endl;
@@ -1225,6 +1335,7 @@ void test_matrix()
 	test_multiply();
 	test_llt();
 	test_householder();
+	test_blocked();
 	
 
 	std::cout << "-----------------test matrix finished-----------" << std::endl << std::endl;
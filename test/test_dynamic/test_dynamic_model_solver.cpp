@@ -1988,6 +1988,194 @@ void test_multi_systems()
 		std::cout << e.what() << std::endl;
 	}
 }
+void test_warm_start(const char *xml_file, const double *ipo, const double *ipt, const double *opt)
+{
+	// 冷启动与热启动的两个模型，沿同一条轨迹求正解 //
+	Model cold, warm;
+	cold.loadXmlStr(xml_file);
+	warm.loadXmlStr(xml_file);
+	for (auto m : { &cold, &warm })
+	{
+		for (auto &fce : m->forcePool())fce.activate(false);
+		for (auto &mot : m->motionPool())mot.activate(true);
+		for (auto &gm : m->generalMotionPool())gm.activate(false);
+		m->solverPool().at(0).allocateMemory();
+	}
+	auto &warm_solver = dynamic_cast<UniversalSolver&>(warm.solverPool().at(0));
+	warm_solver.setWarmStart(true);
+	if (!warm_solver.warmStart())std::cout << "UniversalSolver::setWarmStart() failed" << std::endl;
+
+	auto check = [&](Model &m, const double *pm, const char *msg)
+	{
+		for (aris::Size k = 0; k < m.generalMotionPool().size(); ++k)
+		{
+			double result[16];
+			m.generalMotionPool().at(k).updMpm();
+			m.generalMotionPool().at(k).getMpm(result);
+			if (!s_is_equal(16, result, pm + 16 * k, 1e-10)) 
+			{
+				std::cout << msg << std::endl;
+				return;
+			}
+		}
+	};
+
+	const aris::Size n = 500;
+	aris::Size cold_iter{ 0 }, warm_iter{ 0 };
+	std::vector<double> cold_pm(16 * cold.generalMotionPool().size());
+	for (aris::Size i = 0; i <= n; ++i)
+	{
+		const double s = 0.5 - 0.5 * std::cos(aris::PI * i / n);
+		for (auto m : { &cold, &warm })
+		{
+			for (aris::Size j = 0; j < m->motionPool().size(); ++j)m->motionPool().at(j).setMp(ipo[j] + s * (ipt[j] - ipo[j]));
+			if (!m->solverPool().at(0).kinPos())std::cout << "UniversalSolver::kinPos() warm start failed at " << i << std::endl;
+		}
+		cold_iter += cold.solverPool().at(0).iterCount();
+		warm_iter += warm.solverPool().at(0).iterCount();
+
+		for (aris::Size k = 0; k < cold.generalMotionPool().size(); ++k)
+		{
+			cold.generalMotionPool().at(k).updMpm();
+			cold.generalMotionPool().at(k).getMpm(cold_pm.data() + 16 * k);
+		}
+		check(warm, cold_pm.data(), "UniversalSolver::kinPos() warm start result failed");
+	}
+	check(warm, opt, "UniversalSolver::kinPos() warm start final pos failed");
+	std::cout << "iter count cold:" << cold_iter << "  warm:" << warm_iter << std::endl;
+
+	// 跳变的输入，外推的初值及旧的分解都不再适用，也要能够收敛 //
+	for (aris::Size j = 0; j < warm.motionPool().size(); ++j)warm.motionPool().at(j).setMp(ipo[j]);
+	if (!warm_solver.kinPos())std::cout << "UniversalSolver::kinPos() warm start jump failed" << std::endl;
+
+	// 外部修改了杆件位姿，不能再外推 //
+	for (auto &prt : warm.partPool())prt.setPm(*cold.partPool().at(prt.id()).pm());
+	for (aris::Size j = 0; j < warm.motionPool().size(); ++j)warm.motionPool().at(j).setMp(ipt[j]);
+	if (!warm_solver.kinPos())std::cout << "UniversalSolver::kinPos() warm start reset failed" << std::endl;
+	check(warm, opt, "UniversalSolver::kinPos() warm start reset pos failed");
+}
+void test_warm_start()
+{
+	try
+	{
+		std::cout << "test warm start:" << std::endl;
+
+		const double stewart_input_origin_p[6]{ 2.0 , 2.0 , 2.0 , 2.0 , 2.0 , 2.0 };
+		const double stewart_input_p[6]{ 2.15,2.03,1.98,1.68,2.22,2.01 };
+		const double stewart_output_pm[16]{ 0.654617242227831, -0.16813527373803,0.737025641279234,0.0674004103296998,
+			0.286892301165042,0.957269694021347, -0.0364354283699648,1.66351811346172,
+			-0.699406229390514,0.235298241883176,0.674881962758251,0.907546391448817,
+			0,0,0,1 };
+		test_warm_start(xml_file_stewart, stewart_input_origin_p, stewart_input_p, stewart_output_pm);
+
+		// 多个子系统，各自保留分解结果 //
+		const double multi_input_origin_p[15]{ 0.0 , 0.0 , 0.0
+			,0.0 , 0.0 , 0.0 , 0.0 , 0.0 , 0.0
+			,2.0 , 2.0 , 2.0 , 2.0 , 2.0 , 2.0 };
+		const double multi_input_p[15]{ -0.0648537067263432, -0.4611742608347527,0.5260279675610960
+			,-0.084321840829742,0.111235847475406,0.163501201249858,0.41316722587035, -0.0861578092597486,0.229246197281016
+			,2.15,2.03,1.98,1.68,2.22,2.01 };
+		const double multi_output_pm[48]{ -1.0 , 0.0 , 0.0 , 0.5 ,
+			0.0 , -1.0 , 0.0, 0.8,
+			0.0 , 0.0 , 1.0 , 0.0,
+			0.0 , 0.0 , 0.0 , 1.0
+			,0.863013488544127, -0.284074444773496,   0.417743256579356, -0.137731283515364,
+			0.387677110267304,   0.902605554641921, -0.187108714132569, -0.343275971674581,
+			-0.323904579723239,   0.323426842664891,   0.889089928341408, -0.0474940394315194,
+			0,   0,   0,   1
+			,0.654617242227831, -0.16813527373803,0.737025641279234,0.0674004103296998,
+			0.286892301165042,0.957269694021347, -0.0364354283699648,1.66351811346172,
+			-0.699406229390514,0.235298241883176,0.674881962758251,0.907546391448817,
+			0,0,0,1 };
+		test_warm_start(xml_file_multi, multi_input_origin_p, multi_input_p, multi_output_pm);
+	}
+	catch (std::exception&e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
+void test_multi_thread()
+{
+	try
+	{
+		std::cout << "test multi thread:" << std::endl;
+
+		const double input_p[15]{ -0.0648537067263432, -0.4611742608347527,0.5260279675610960
+			,-0.084321840829742,0.111235847475406,0.163501201249858,0.41316722587035, -0.0861578092597486,0.229246197281016
+			,2.15,2.03,1.98,1.68,2.22,2.01 };
+		const double input_v[15]{ 0.2647720948695498, -0.5918279267633222,   0.6270558318937725
+			,0.93426722257942, -0.024823760537999, -0.89419018046124,   0.245922301638701, -1.23100367003297, -0.48185561218356
+			,0.687,1.521,-0.325,0.665,1.225,-0.999 };
+		const double input_a[15]{ 0.8080984807847047, -0.7798913328042270,   0.1717928520195222
+			,0.70807836306709, -0.496581922752884, -0.159513727427361, -0.590163055515337,   0.131806583011732, -1.65802060177352
+			,1.687,0.521,-1.325,1.665,0.225,-1.999 };
+
+		// 单线程与多线程的两个模型，各子系统的计算完全相同，结果应该逐位相等 //
+		Model serial, parallel;
+		serial.loadXmlStr(xml_file_multi);
+		parallel.loadXmlStr(xml_file_multi);
+		auto &parallel_solver = dynamic_cast<UniversalSolver&>(parallel.solverPool().at(0));
+		parallel_solver.setThreadNum(4);
+		if (parallel_solver.threadNum() != 4)std::cout << "UniversalSolver::setThreadNum() failed" << std::endl;
+		parallel_solver.setThreadCpus({ 0, 0, 0 });
+		if (parallel_solver.threadCpus() != std::vector<int>{ 0, 0, 0 } || parallel_solver.threadPriority() != 0)std::cout << "UniversalSolver::setThreadCpus() failed" << std::endl;
+		for (auto m : { &serial, &parallel })
+		{
+			for (auto &fce : m->forcePool())fce.activate(false);
+			for (auto &mot : m->motionPool())mot.activate(true);
+			for (auto &gm : m->generalMotionPool())gm.activate(false);
+			m->solverPool().at(0).allocateMemory();
+			dynamic_cast<UniversalSolver&>(m->solverPool().at(0)).setWarmStart(true);
+		}
+
+		for (aris::Size i = 0; i <= 100; ++i)
+		{
+			for (auto m : { &serial, &parallel })
+			{
+				for (aris::Size j = 0; j < m->motionPool().size(); ++j)
+				{
+					m->motionPool().at(j).setMp(input_p[j] + 0.001 * i * input_v[j]);
+					m->motionPool().at(j).setMv(input_v[j]);
+					m->motionPool().at(j).setMa(input_a[j]);
+				}
+				if (!m->solverPool().at(0).kinPos())std::cout << "UniversalSolver::kinPos() multi thread failed at " << i << std::endl;
+				m->solverPool().at(0).kinVel();
+				m->solverPool().at(0).dynAccAndFce();
+			}
+
+			if (serial.solverPool().at(0).iterCount() != parallel.solverPool().at(0).iterCount()
+				|| serial.solverPool().at(0).error() != parallel.solverPool().at(0).error())
+				std::cout << "UniversalSolver::kinPos() multi thread iter count failed at " << i << std::endl;
+			for (aris::Size k = 0; k < serial.partPool().size(); ++k)
+			{
+				if (!std::equal(*serial.partPool().at(k).pm(), *serial.partPool().at(k).pm() + 16, *parallel.partPool().at(k).pm()))std::cout << "UniversalSolver::kinPos() multi thread failed at " << i << std::endl;
+				if (!std::equal(serial.partPool().at(k).vs(), serial.partPool().at(k).vs() + 6, parallel.partPool().at(k).vs()))std::cout << "UniversalSolver::kinVel() multi thread failed at " << i << std::endl;
+				if (!std::equal(serial.partPool().at(k).as(), serial.partPool().at(k).as() + 6, parallel.partPool().at(k).as()))std::cout << "UniversalSolver::dynAccAndFce() multi thread acc failed at " << i << std::endl;
+			}
+			for (aris::Size k = 0; k < serial.motionPool().size(); ++k)
+				if (serial.motionPool().at(k).mf() != parallel.motionPool().at(k).mf())std::cout << "UniversalSolver::dynAccAndFce() multi thread fce failed at " << i << std::endl;
+		}
+
+		// 拷贝的求解器需要重新 allocateMemory //
+		UniversalSolver copied(parallel_solver);
+		if (copied.threadNum() != 4 || copied.threadCpus() != parallel_solver.threadCpus())std::cout << "UniversalSolver copy thread num failed" << std::endl;
+
+#ifdef UNIX
+		// 无法绑定的核，allocateMemory 时抛出异常 //
+		try
+		{
+			parallel_solver.setThreadCpus({ 0, 1023 });
+			parallel_solver.allocateMemory();
+			std::cout << "UniversalSolver::setThreadCpus() invalid cpu failed" << std::endl;
+		}
+		catch (std::runtime_error &) {}
+#endif
+	}
+	catch (std::exception&e)
+	{
+		std::cout << e.what() << std::endl;
+	}
+}
 void bench_3R()
 {
 	try
@@ -2404,6 +2592,8 @@ void test_model_solver()
 	test_stewart();
 	test_ur5_on_stewart();
 	test_multi_systems();
+	test_warm_start();
+	test_multi_thread();
 
 	bench_3R();
 	bench_ur5();
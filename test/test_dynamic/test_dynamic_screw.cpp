@@ -1837,6 +1837,45 @@ void test_solve()
 	
 }
 
+void test_fixed_size_kernels()
+{
+	// 连续存储的定长版本（可能使用simd）须与带行间距的通用版本一致 //
+	const double pe[6]{ 0.1, 0.2, 0.3, 0.4, -0.5, 0.6 }, vs[6]{ 0.7, -0.8, 0.9, 1.0, 1.1, -1.2 }, vs2[6]{ -0.3, 0.5, 0.2, -0.9, 0.4, 0.8 };
+	const double iv[10]{ 1.5, 0.1, -0.2, 0.3, 2.0, 2.5, 3.0, 0.1, 0.2, -0.3 };
+	double pm[16], pm2[16], result[36], expect[36];
+	s_pe2pm(pe, pm);
+	s_pe2pm(vs, pm2);
+
+	s_mm(4, 4, 4, pm, pm2, expect);
+	if (!s_is_equal(16, s_pm_dot_pm(pm, pm2, result), expect, error))std::cout << "\"s_pm_dot_pm fixed size\" failed" << std::endl;
+	if (!s_is_equal(16, s_pm2pm(pm, pm2, result), expect, error))std::cout << "\"s_pm2pm fixed size\" failed" << std::endl;
+
+	s_inv_pm_dot_v3(pm, vs, 1, expect, 1);
+	if (!s_is_equal(3, s_inv_pm_dot_v3(pm, vs, result), expect, error))std::cout << "\"s_inv_pm_dot_v3 fixed size\" failed" << std::endl;
+
+	s_tv(pm, vs, 1, expect, 1);
+	s_tv(pm, vs, result);
+	if (!s_is_equal(6, result, expect, error))std::cout << "\"s_tv fixed size\" failed" << std::endl;
+
+	s_tf(pm, vs, 1, expect, 1);
+	s_tf(pm, vs, result);
+	if (!s_is_equal(6, result, expect, error))std::cout << "\"s_tf fixed size\" failed" << std::endl;
+
+	s_cv(vs, 1, vs2, 1, expect, 1);
+	s_cv(vs, vs2, result);
+	if (!s_is_equal(6, result, expect, error))std::cout << "\"s_cv fixed size\" failed" << std::endl;
+
+	s_cf(vs, 1, vs2, 1, expect, 1);
+	s_cf(vs, vs2, result);
+	if (!s_is_equal(6, result, expect, error))std::cout << "\"s_cf fixed size\" failed" << std::endl;
+
+	double im[36];
+	s_iv2im(iv, im);
+	s_im2im(pm, im, expect);
+	s_iv2im(s_iv2iv(pm, iv, result), im);
+	if (!s_is_equal(36, im, expect, error))std::cout << "\"s_iv2iv fixed size\" failed" << std::endl;
+}
+
 void test_screw()
 {
 	std::cout << std::endl << "-----------------test screw--------------------" << std::endl;
@@ -1849,6 +1888,7 @@ void test_screw()
 	test_variable_change();
 	test_coordinate_transform();
 	test_solve();
+	test_fixed_size_kernels();
 
 	std::cout << "-----------------test screw finished-----------" << std::endl << std::endl;
 }
\ No newline at end of file
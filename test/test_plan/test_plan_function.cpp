@@ -288,9 +288,39 @@ void test_moveAbsolute2()
 	//}
 }
 
+void test_plan_root_parse()
+{
+	try
+	{
+		PlanRoot root;
+		auto &plan = root.planPool().add<Plan>("move");
+		plan.command().add<aris::core::Param>("vel", "1", 'v');
+
+		std::map<std::string, std::string> params;
+		if (root.parse("move", params) != &plan || params.at("vel") != "1")std::cout << "test plan root parse failed" << std::endl;
+		auto parser = root.planParser();
+
+		// 修改已有命令的参数或命令名后，下一次解析使用新的定义 //
+		plan.command().findParam("vel")->setDefaultValue("2");
+		if (root.parse("move -v", params) != &plan || params.at("vel") != "2")std::cout << "test plan root parse failed" << std::endl;
+		plan.command().setName("go");
+		if (root.parse("go", params) != &plan || root.findPlan("move") != nullptr)std::cout << "test plan root parse failed" << std::endl;
+
+		// 之前取得的解析器在索引重建后仍然可用 //
+		std::string cmd;
+		parser->parse("move", cmd, params);
+		if (cmd != "move" || params.at("vel") != "1")std::cout << "test plan root parse failed" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cout << "test plan root parse failed:" << e.what() << std::endl;
+	}
+}
+
 void test_function()
 {
 	std::cout << std::endl << "-----------------test function---------------------" << std::endl;
+	test_plan_root_parse();
 	//test_optimal();
 	test_moveAbsolute2();
 	std::cout << "-----------------test function finished------------" << std::endl << std::endl;
@@ -1,6 +1,11 @@
 ﻿#include <iostream>
+#include <set>
+#include <array>
+#include <sstream>
 #include <condition_variable>
 #include <future>
+#include <fstream>
+#include <filesystem>
 #include <aris.hpp>
 
 #include "test_control_server.h"
@@ -381,8 +386,899 @@ void test_server_option()
 
 
 
+void test_recorder()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	auto &mot = cs.controller().slavePool().add<aris::control::EthercatMotion>();
+	mot.loadXmlStr(
+		"<EthercatMotion phy_id=\"0\" product_code=\"0x0\" vendor_id=\"0x000002E1\" revision_num=\"0x29001\" dc_assign_activate=\"0x0300\" pos_factor=\"100\">"
+		"	<SyncManagerPoolObject>"
+		"		<SyncManager is_tx=\"false\">"
+		"			<Pdo index=\"0x1600\" is_tx=\"false\">"
+		"				<PdoEntry name=\"control_word\" index=\"0x6040\" subindex=\"0x00\" size=\"16\"/>"
+		"				<PdoEntry name=\"target_pos\" index=\"0x607A\" subindex=\"0x00\" size=\"32\"/>"
+		"			</Pdo>"
+		"		</SyncManager>"
+		"		<SyncManager is_tx=\"true\">"
+		"			<Pdo index=\"0x1A00\" is_tx=\"true\">"
+		"				<PdoEntry name=\"status_word\" index=\"0x6041\" subindex=\"0x00\" size=\"16\"/>"
+		"				<PdoEntry name=\"pos_actual_value\" index=\"0x6064\" subindex=\"0x00\" size=\"32\"/>"
+		"			</Pdo>"
+		"		</SyncManager>"
+		"	</SyncManagerPoolObject>"
+		"</EthercatMotion>");
+
+	auto dir = std::filesystem::temp_directory_path() / "aris_test_recorder";
+	cs.recorder().loadXmlStr("<Recorder name=\"recorder\" capacity=\"256\" block_rows=\"32\" channels=\"target_pos actual_pos:0\"/>");
+	cs.recorder().setFileDirectory(dir);
+	if (cs.recorder().channels().size() != 2)std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("test", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		param.controller->motionPool().at(0).setTargetPos(param.count * 0.01);
+		return 100 - param.count;
+	}, nullptr, "<Command name=\"test_recorder\"/>");
+
+	cs.start();
+
+	aris::core::Msg cmd("test_recorder");
+	cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION | aris::plan::Plan::WAIT_FOR_EXECUTION;
+	auto target = cs.executeCmd(cmd);
+	cs.recorder().flush();
+
+	if (cs.recorder().writtenRows() != 100 || cs.recorder().droppedRows() != 0)std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+
+	// 直接按文件格式读取 //
+	std::ifstream file(cs.recorder().lastFile(), std::ios::binary);
+	std::vector<char> buf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	aris::server::Recorder::FileHeader header;
+	std::memcpy(&header, buf.data(), sizeof(header));
+	if (std::string(header.magic) != "ARISREC" || header.column_size != 2 || header.block_rows != 32 || header.command_id != target->command_id)
+		std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+	if (std::string(buf.data() + sizeof(header)) != "target_pos.0" || std::string(buf.data() + sizeof(header) + header.name_size) != "actual_pos.0")
+		std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+	if (static_cast<std::int64_t>(buf.size()) != header.data_offset + 4 * header.block_bytes)
+		std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+
+	for (std::int64_t k = 0, row = 0; k < 4; ++k)
+	{
+		auto block = buf.data() + header.data_offset + k * header.block_bytes;
+		std::int64_t row_count;
+		std::memcpy(&row_count, block, 8);
+		if (row_count != (k < 3 ? 32 : 4))std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+
+		for (std::int64_t i = 0; i < row_count; ++i, ++row)
+		{
+			std::int64_t count;
+			double target_pos;
+			std::memcpy(&count, block + 8 + 8 * i, 8);
+			std::memcpy(&target_pos, block + 8 + 8 * (header.block_rows + i), 8);
+			if (count != target->begin_global_count + row || std::abs(target_pos - (row + 1) * 0.01) > 1e-9)
+				std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+		}
+	}
+	cs.stop();
+
+	// 两个运动组同时执行时，每条指令的数据写入该指令自己的文件 //
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("short", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 30 - param.count;
+	}, nullptr, "<Command name=\"test_recorder_short\"/>");
+	cs.motionGroupPool().add<aris::server::MotionGroup>("arm", std::vector<aris::Size>{ 0 });
+	cs.motionGroupPool().add<aris::server::MotionGroup>("conveyor");
+	cs.start();
+
+	aris::core::Msg short_cmd("test_recorder_short");
+	cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION;
+	short_cmd.header().reserved1_ = cmd.header().reserved1_;
+	auto arm_target = cs.executeCmd(cmd, "arm");
+	auto conveyor_target = cs.executeCmd(short_cmd, "conveyor");
+	arm_target->finished.wait();
+	conveyor_target->finished.wait();
+	cs.recorder().flush();
+
+	if (cs.recorder().writtenRows() != 130 || cs.recorder().failedRows() != 0)std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+	for (auto &[t, rows] : std::vector<std::pair<std::shared_ptr<aris::plan::PlanTarget>, std::int64_t>>{ { arm_target, 100 }, { conveyor_target, 30 } })
+	{
+		auto suffix = "--" + std::to_string(t->command_id) + ".arec";
+		std::filesystem::path path;
+		for (auto &entry : std::filesystem::directory_iterator(dir))
+		{
+			auto name = entry.path().filename().string();
+			if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)path = entry.path();
+		}
+
+		std::ifstream f(path, std::ios::binary);
+		std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+		aris::server::Recorder::FileHeader h{};
+		if (data.size() >= sizeof(h))std::memcpy(&h, data.data(), sizeof(h));
+		if (data.size() < sizeof(h) || h.command_id != t->command_id)
+		{
+			std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+			continue;
+		}
+
+		// 每一行的 global count 都属于该指令的执行区间 //
+		std::int64_t row = 0;
+		for (auto pos = h.data_offset; pos + h.block_bytes <= static_cast<std::int64_t>(data.size()); pos += h.block_bytes)
+		{
+			std::int64_t row_count;
+			std::memcpy(&row_count, data.data() + pos, 8);
+			for (std::int64_t i = 0; i < row_count; ++i, ++row)
+			{
+				std::int64_t count;
+				std::memcpy(&count, data.data() + pos + 8 + 8 * i, 8);
+				if (count != t->begin_global_count + row)std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+			}
+		}
+		if (row != rows)std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+	}
+	cs.stop();
+	cs.motionGroupPool().clear();
+
+	// 文件无法打开时，数据计入 failedRows 并给出错误信息 //
+	std::ofstream(dir / "blocker").put('0');
+	cs.recorder().setFileDirectory(dir / "blocker" / "sub");
+	cs.start();
+	cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION | aris::plan::Plan::WAIT_FOR_EXECUTION;
+	cs.executeCmd(cmd);
+	cs.recorder().flush();
+	if (cs.recorder().writtenRows() != 0 || cs.recorder().failedRows() != 100 || cs.recorder().lastError().empty())
+		std::cout << __FILE__ << " " << __LINE__ << ":test recorder failed" << std::endl;
+	cs.stop();
+
+	cs.recorder().clearChannels();
+	cs.recorder().setFileDirectory("");
+	std::filesystem::remove_all(dir);
+}
+
+void test_concurrent_execute()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	// 实时线程中按执行顺序记录指令id //
+	std::vector<std::uint64_t> executed_ids;
+	executed_ids.reserve(1000);
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("motion", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		if (param.count == 1)executed_ids.push_back(param.command_id);
+		return 5 - param.count;
+	}, nullptr, "<Command name=\"test_motion\"/>");
+
+	std::atomic_int status_count{ 0 };
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("status", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &)->void
+	{
+		++status_count;
+	}, nullptr, nullptr, "<Command name=\"test_status\"/>");
+
+	cs.start();
+
+	const std::uint64_t quiet = aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	std::vector<std::vector<std::uint64_t>> submitted_ids(4);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.push_back(std::thread([&, i]()
+		{
+			aris::core::Msg cmd("test_motion");
+			cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION | quiet;
+			for (int j = 0; j < 20; ++j)submitted_ids[i].push_back(cs.executeCmd(cmd)->command_id);
+		}));
+		threads.push_back(std::thread([&]()
+		{
+			aris::core::Msg cmd("test_status");
+			cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_EXECUTE_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION | quiet;
+			for (int j = 0; j < 50; ++j)cs.executeCmd(cmd);
+		}));
+	}
+	for (auto &t : threads)t.join();
+	cs.waitForAllCollection();
+	cs.stop();
+
+	if (status_count != 200 || executed_ids.size() != 80)std::cout << __FILE__ << " " << __LINE__ << ":test concurrent execute failed" << std::endl;
+
+	// 每个线程提交的指令按提交顺序执行 //
+	for (auto &ids : submitted_ids)
+	{
+		std::vector<std::uint64_t> order;
+		for (auto id : executed_ids)if (std::find(ids.begin(), ids.end(), id) != ids.end())order.push_back(id);
+		if (order != ids)std::cout << __FILE__ << " " << __LINE__ << ":test concurrent execute failed" << std::endl;
+	}
+}
+
+void test_target_completion()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("motion", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 3 - param.count;
+	}, nullptr, "<Command name=\"test_motion\"/>");
+
+	cs.start();
+
+	aris::core::Msg cmd("test_motion");
+	cmd.header().reserved1_ = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+
+	// 连续执行远多于指令池大小的指令，PlanTarget 由内存池反复复用 //
+	std::set<const void*> addresses;
+	for (int i = 0; i < 1500; ++i)
+	{
+		auto target = cs.executeCmd(cmd);
+		target->finished.wait();
+		if (!target->finished.isFinished() || target->ret_code != aris::plan::PlanTarget::SUCCESS)
+		{
+			std::cout << __FILE__ << " " << __LINE__ << ":test target completion failed" << std::endl;
+			break;
+		}
+		addresses.insert(target.get());
+	}
+	cs.stop();
+
+	if (addresses.size() >= 1500)std::cout << __FILE__ << " " << __LINE__ << ":test target completion failed" << std::endl;
+}
+
+void test_motion_checker()
+{
+	using MC = aris::server::MotionChecker;
+
+	MC checker;
+	checker.resize(4);
+	for (aris::Size i = 0; i < 4; ++i)checker.setLimits(i, MC::Limits{ 1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 0.1, 0.1 });
+
+	// 0:位置模式 1:速度模式 2:电流模式 3:未使能 //
+	checker.setState(0, MC::State{ 0x27, 8, 8, 0.0, 0.0, 0.0, 0.0, 0.0 });
+	checker.setState(1, MC::State{ 0x27, 9, 9, 0.0, 0.0, 0.0, 0.0, 0.0 });
+	checker.setState(2, MC::State{ 0x27, 10, 10, 0.0, 0.0, 0.0, 0.0, 0.0 });
+	checker.setState(3, MC::State{ 0x00, 8, 8, 5.0, 5.0, 0.0, 0.0, 0.0 });
+	if (checker.check(0, 1) != 0 || checker.firstAxis() != 4)std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+	checker.commit();
+
+	// 位置跳变，同时超出最大值并有跟随误差 //
+	checker.setState(0, MC::State{ 0x27, 8, 8, 1.5, 0.0, 0.0, 0.0, 0.0 });
+	checker.setState(2, MC::State{ 0x27, 10, 10, 0.0, 0.0, 0.0, 0.0, -2.0 });
+	auto all = checker.check(0, 5);
+	if (checker.firstAxis() != 0
+		|| checker.violation(0) != (MC::POS_MAX | MC::POS_CONTINUOUS | MC::POS_CONTINUOUS_SECOND_ORDER | MC::POS_FOLLOWING_ERROR)
+		|| checker.violation(1) != 0
+		|| checker.violation(2) != (MC::VEL_MIN | MC::VEL_CONTINUOUS)
+		|| checker.violation(3) != 0
+		|| all != (checker.violation(0) | checker.violation(2)))
+		std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+
+	if (std::string(MC::violationName(checker.violation(0) & (0u - checker.violation(0)))) != "position beyond MAX")
+		std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+
+	// 通过 option 关闭检查，起始阶段使用 AT_START 选项 //
+	const auto pos_off = aris::plan::Plan::NOT_CHECK_POS_MAX | aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS | aris::plan::Plan::NOT_CHECK_POS_CONTINUOUS_SECOND_ORDER | aris::plan::Plan::NOT_CHECK_POS_FOLLOWING_ERROR;
+	checker.check(pos_off, 5);
+	if (checker.violation(0) != 0 || checker.firstAxis() != 2)std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+	checker.check(pos_off, 1);
+	if (checker.violation(0) != (MC::POS_CONTINUOUS | MC::POS_CONTINUOUS_SECOND_ORDER))std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+
+	// 改正后历史数据被重置 //
+	checker.resetHistory(0, 0.5, 0.0, 0.0);
+	if (checker.lastPvc(0)[0] != 0.5 || checker.lastLastPvc(0)[0] != 0.5)std::cout << __FILE__ << " " << __LINE__ << ":test motion checker failed" << std::endl;
+}
+
+void test_motion_group()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("long", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 300 - param.count;
+	}, nullptr, "<Command name=\"test_long\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("short", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 3 - param.count;
+	}, nullptr, "<Command name=\"test_short\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("error", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return -1;
+	}, nullptr, "<Command name=\"test_error\"/>");
+
+	// 电机不属于任何运动组时不能启动 //
+	cs.motionGroupPool().add<aris::server::MotionGroup>("arm", std::vector<aris::Size>{ 0 });
+	try
+	{
+		cs.start();
+		std::cout << __FILE__ << " " << __LINE__ << ":test motion group failed" << std::endl;
+		cs.stop();
+	}
+	catch (std::exception &) {}
+
+	cs.motionGroupPool().clear();
+	cs.motionGroupPool().add<aris::server::MotionGroup>("arm");
+	cs.motionGroupPool().add<aris::server::MotionGroup>("conveyor");
+
+	// 出错指令会在实时线程中打印错误信息，这里截获输出，检查结束后再打印测试结果 //
+	std::vector<int> failed_lines;
+	std::stringstream mout;
+	auto cout_buf = std::cout.rdbuf(mout.rdbuf());
+	cs.start();
+
+	const std::uint64_t option = aris::plan::Plan::NOT_RUN_PREPAIR_FUNCTION | aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION
+		| aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	aris::core::Msg long_cmd("test_long"), short_cmd("test_short"), error_cmd("test_error");
+	long_cmd.header().reserved1_ = option;
+	short_cmd.header().reserved1_ = option;
+	error_cmd.header().reserved1_ = option;
+
+	// 一个运动组中的长指令不阻塞另一个运动组，出错也只清空本组的队列 //
+	auto long_target = cs.executeCmd(long_cmd, "arm");
+	auto short_target = cs.executeCmd(short_cmd, "conveyor");
+	auto error_target = cs.executeCmd(error_cmd, "conveyor");
+	auto cancelled_target = cs.executeCmd(short_cmd, "conveyor");
+	cancelled_target->finished.wait();
+	short_target->finished.wait();
+
+	if (long_target->finished.isFinished()
+		|| cs.currentExecuteId(0) != static_cast<std::int64_t>(long_target->command_id)
+		|| short_target->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| error_target->ret_code != aris::plan::PlanTarget::ERROR
+		|| cancelled_target->ret_code != aris::plan::PlanTarget::CANCELLED
+		|| short_target->motion_group != 1)
+		failed_lines.push_back(__LINE__);
+
+	long_target->finished.wait();
+	cs.waitForAllCollection();
+	auto arm = cs.motionGroupStastics(0);
+	auto conveyor = cs.motionGroupStastics(1);
+	if (long_target->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| arm.executed_cmd_count != 1 || arm.failed_cmd_count != 0 || arm.busy_count != 300
+		|| conveyor.executed_cmd_count != 1 || conveyor.failed_cmd_count != 2 || conveyor.current_execute_id != 0)
+		failed_lines.push_back(__LINE__);
+
+	try
+	{
+		cs.executeCmd(short_cmd, "gripper");
+		failed_lines.push_back(__LINE__);
+	}
+	catch (std::exception &) {}
+
+	cs.stop();
+	cs.motionGroupPool().clear();
+	std::cout.rdbuf(cout_buf);
+
+	if (mout.str().find("cmd queue cleared") == std::string::npos)failed_lines.push_back(__LINE__);
+
+	// 长指令执行期间开始的指令不切换 rt log 文件，只在长指令的文件中标记 //
+	std::filesystem::path long_log;
+	auto long_suffix = "--" + std::to_string(long_target->command_id) + ".txt";
+	for (auto &entry : std::filesystem::directory_iterator(aris::core::logDirPath()))
+	{
+		auto name = entry.path().filename().string();
+		if (name.size() > long_suffix.size() && name.compare(name.size() - long_suffix.size(), long_suffix.size(), long_suffix) == 0
+			&& (long_log.empty() || entry.last_write_time() > std::filesystem::last_write_time(long_log)))
+			long_log = entry.path();
+	}
+	std::ifstream long_log_file(long_log);
+	std::string long_log_str((std::istreambuf_iterator<char>(long_log_file)), std::istreambuf_iterator<char>());
+	if (long_log_str.find("cmd " + std::to_string(short_target->command_id) + " of motion group 1 begins") == std::string::npos)failed_lines.push_back(__LINE__);
+	for (auto line : failed_lines)std::cout << __FILE__ << " " << line << ":test motion group failed" << std::endl;
+}
+
+void test_blend()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	auto blend = [](const std::map<std::string, std::string> &params, aris::plan::PlanTarget &target) { target.blend_count = 50; };
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("first", blend, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 200 - param.count;
+	}, nullptr, "<Command name=\"test_first\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("second", blend, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 100 - param.count;
+	}, nullptr, "<Command name=\"test_second\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("short", blend, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 20 - param.count;
+	}, nullptr, "<Command name=\"test_short\"/>");
+
+	cs.start();
+
+	const std::uint64_t option = aris::plan::Plan::NOT_RUN_COLLECT_FUNCTION
+		| aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	aris::core::Msg first_cmd("test_first"), second_cmd("test_second"), short_cmd("test_short");
+	first_cmd.header().reserved1_ = option;
+	second_cmd.header().reserved1_ = option;
+	short_cmd.header().reserved1_ = option;
+
+	// 后一条指令在前一条指令剩余 50 个周期时开始执行，之后接着执行剩余部分 //
+	auto first = cs.executeCmd(first_cmd);
+	auto second = cs.executeCmd(second_cmd);
+	second->finished.wait();
+	if (first->ret_code != aris::plan::PlanTarget::SUCCESS || second->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| second->begin_global_count - first->begin_global_count != 149)
+		std::cout << __FILE__ << " " << __LINE__ << ":test blend failed" << std::endl;
+
+	// 后一条指令在混合区内就已结束时，与前一条指令一起结束 //
+	first = cs.executeCmd(first_cmd);
+	auto short_target = cs.executeCmd(short_cmd);
+	short_target->finished.wait();
+	if (first->ret_code != aris::plan::PlanTarget::SUCCESS || short_target->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| short_target->begin_global_count - first->begin_global_count != 149)
+		std::cout << __FILE__ << " " << __LINE__ << ":test blend failed" << std::endl;
+
+	cs.waitForAllCollection();
+	auto stastics = cs.motionGroupStastics(0);
+	if (stastics.executed_cmd_count != 4 || stastics.failed_cmd_count != 0 || stastics.busy_count != 249 + 200)
+		std::cout << __FILE__ << " " << __LINE__ << ":test blend failed" << std::endl;
+
+	cs.stop();
+}
+
+void test_blend_move_l()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	// 六个仿真电机，控制器以虚拟时间运行，便于逐周期记录指令位置 //
+	auto controller = new aris::control::Controller;
+	for (std::uint16_t i = 0; i < 6; ++i)
+		controller->slavePool().add<aris::control::SimulatedMotion>("m" + std::to_string(i), i, 10.0, -10.0, 10.0, -10.0, 1000.0, -1000.0, 1.0, 1.0);
+	controller->setVirtualTime(true);
+	cs.resetController(controller);
+	cs.resetModel(aris::robot::createModelRokaeXB4().release());
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	const std::uint64_t option = aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("enable", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		target.option |= option | aris::plan::Plan::NOT_CHECK_OPERATION_ENABLE;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		int ret = 0;
+		for (auto &m : param.controller->motionPool())ret += std::abs(m.enable()) + std::abs(m.mode(8));
+		return ret;
+	}, nullptr, "<Command name=\"test_enable\"/>");
+	cs.planRoot().planPool().add<aris::plan::MoveAbsJ>();
+	cs.planRoot().planPool().add<aris::plan::MoveL>();
+
+	auto run = [&](const std::string &cmd_str)
+	{
+		aris::core::Msg msg(cmd_str);
+		msg.header().reserved1_ = option;
+		auto target = cs.executeCmd(msg);
+		while (!target->finished.isFinished())cs.controller().step(1);
+		return target;
+	};
+
+	// 先以关节运动离开腕部奇异位形，起点模型由 mvl 正解同步 //
+	cs.start();
+	run("test_enable");
+	run("mvaj -a --pos={0.1,0.3,-0.4,0.2,0.8,0.1} --vel=0.5 --acc=1.0 --dec=1.0");
+
+	// 在独立模型中算出起点位姿，目标为起点附近的两段直线 //
+	auto model = aris::robot::createModelRokaeXB4();
+	auto fk = [&](const double *q, double *pq)
+	{
+		for (aris::Size i = 0; i < 6; ++i)model->motionPool()[i].setMp(q[i]);
+		model->solverPool()[1].kinPos();
+		model->generalMotionPool()[0].getMpq(pq);
+	};
+	const double q0[6]{ 0.1,0.3,-0.4,0.2,0.8,0.1 };
+	double pq0[7], pq1[7], pq2[7];
+	fk(q0, pq0);
+	std::copy(pq0, pq0 + 7, pq1);
+	std::copy(pq0, pq0 + 7, pq2);
+	pq1[0] += 0.05;
+	pq2[0] += 0.05;
+	pq2[1] += 0.05;
+	auto mvl = [&](const double *pq)
+	{
+		std::string s = "mvl --vel=0.1 --acc=0.5 --dec=0.5 --blend_count=200 --pq={";
+		for (int i = 0; i < 7; ++i)s += std::to_string(pq[i]) + (i == 6 ? "}" : ",");
+		aris::core::Msg msg(s);
+		msg.header().reserved1_ = option;
+		return cs.executeCmd(msg);
+	};
+
+	// 两段直线在拐角处混合，逐周期记录指令位置 //
+	auto first = mvl(pq1);
+	auto second = mvl(pq2);
+	std::vector<std::array<double, 6>> q;
+	while (!second->finished.isFinished())
+	{
+		cs.controller().step(1);
+		std::array<double, 6> now;
+		for (aris::Size i = 0; i < 6; ++i)now[i] = cs.controller().motionPool()[i].targetPos();
+		q.push_back(now);
+	}
+
+	// 混合区内位置与速度连续：相邻周期的速度变化很小，且在拐角处不会停下 //
+	double max_acc{ 0.0 }, min_vel{ 1.0 };
+	for (aris::Size k = 2; k + 2 < q.size(); ++k)
+	{
+		double vel{ 0.0 };
+		for (aris::Size i = 0; i < 6; ++i)
+		{
+			max_acc = std::max(max_acc, std::abs(q[k][i] - 2 * q[k - 1][i] + q[k - 2][i]));
+			vel = std::max(vel, std::abs(q[k][i] - q[k - 1][i]));
+		}
+		if (k > q.size() / 4 && k < q.size() * 3 / 4)min_vel = std::min(min_vel, vel);
+	}
+
+	double pq_end[7];
+	fk(q.back().data(), pq_end);
+	if (first->ret_code != aris::plan::PlanTarget::SUCCESS || second->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| max_acc > 1e-5 || min_vel < 1e-5
+		|| std::abs(pq_end[0] - pq2[0]) > 1e-5 || std::abs(pq_end[1] - pq2[1]) > 1e-5 || std::abs(pq_end[2] - pq2[2]) > 1e-5)
+		std::cout << __FILE__ << " " << __LINE__ << ":test blend move l failed" << std::endl;
+
+	cs.stop();
+}
+
+void test_stream_move()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(aris::robot::createModelRokaeXB4().release());
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+	cs.planRoot().planPool().add<aris::plan::StreamMove>();
+
+	cs.start();
+
+	// 开启后提交失败时释放流模式，此后不接受设定点，且可以再次开启 //
+	try
+	{
+		cs.executeCmd(aris::core::Msg("stm --start"), 7);
+		std::cout << __FILE__ << " " << __LINE__ << ":test stream move failed" << std::endl;
+	}
+	catch (std::exception &) {}
+	if (aris::plan::StreamMove::pushSetpoint(std::vector<double>(6, 0.0).data()) != 0)std::cout << __FILE__ << " " << __LINE__ << ":test stream move failed" << std::endl;
+
+	// 每 4 个周期一个设定点，依次执行完后终止 //
+	auto start = cs.executeCmd(aris::core::Msg("stm --start --interval=4 --underrun_limit=0"));
+	std::vector<double> setpoints;
+	for (int k = 1; k < 10; ++k)for (int i = 0; i < 6; ++i)setpoints.push_back(0.01 * k);
+	if (aris::plan::StreamMove::pushSetpoint(setpoints.data(), 9) != 9)std::cout << __FILE__ << " " << __LINE__ << ":test stream move failed" << std::endl;
+	cs.executeCmd(aris::core::Msg("stm --data={0.1,0.1,0.1,0.1,0.1,0.1}"));
+	while (aris::plan::StreamMove::pendingSetpoint())std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	cs.executeCmd(aris::core::Msg("stm --stop"));
+	start->finished.wait();
+	if (start->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| std::abs(cs.model().motionPool()[5].mp() - 0.1) > 1e-10
+		|| aris::plan::StreamMove::droppedCount() != 0
+		|| aris::plan::StreamMove::pushSetpoint(setpoints.data()) != 0)
+		std::cout << __FILE__ << " " << __LINE__ << ":test stream move failed" << std::endl;
+
+	// 积压的设定点超过 max_latency 时丢弃旧的设定点，队列为空超过 underrun_limit 时自动结束 //
+	start = cs.executeCmd(aris::core::Msg("stm --start --interval=50 --max_latency=2 --underrun_limit=10"));
+	aris::plan::StreamMove::pushSetpoint(setpoints.data(), 9);
+	start->finished.wait();
+	if (start->ret_code != aris::plan::PlanTarget::SUCCESS
+		|| std::abs(cs.model().motionPool()[0].mp() - 0.09) > 1e-10
+		|| aris::plan::StreamMove::droppedCount() < 6
+		|| aris::plan::StreamMove::underrunCount() < 10)
+		std::cout << __FILE__ << " " << __LINE__ << ":test stream move failed" << std::endl;
+
+	cs.stop();
+}
+
+void test_stream_move_pose()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	auto controller = new aris::control::Controller;
+	for (std::uint16_t i = 0; i < 6; ++i)
+		controller->slavePool().add<aris::control::SimulatedMotion>("m" + std::to_string(i), i, 10.0, -10.0, 10.0, -10.0, 1000.0, -1000.0, 1.0, 1.0);
+	controller->setVirtualTime(true);
+	cs.resetController(controller);
+	cs.resetModel(aris::robot::createModelRokaeXB4().release());
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	const std::uint64_t option = aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("enable", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		target.option |= option | aris::plan::Plan::NOT_CHECK_OPERATION_ENABLE;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		int ret = 0;
+		for (auto &m : param.controller->motionPool())ret += std::abs(m.enable()) + std::abs(m.mode(8));
+		return ret;
+	}, nullptr, "<Command name=\"test_enable\"/>");
+	cs.planRoot().planPool().add<aris::plan::MoveAbsJ>();
+	cs.planRoot().planPool().add<aris::plan::StreamMove>();
+
+	auto run = [&](const std::string &cmd_str)
+	{
+		auto target = cs.executeCmd(aris::core::Msg(cmd_str));
+		while (!target->finished.isFinished())cs.controller().step(1);
+	};
+
+	// 先以关节运动离开腕部奇异位形，机器人仍在 xz 平面内 //
+	cs.start();
+	run("test_enable");
+	run("mvaj -a --pos={0,0.3,-0.4,0,0.8,0} --vel=0.5 --acc=1.0 --dec=1.0");
+
+	auto model = aris::robot::createModelRokaeXB4();
+	const double q0[6]{ 0,0.3,-0.4,0,0.8,0 };
+	for (aris::Size i = 0; i < 6; ++i)model->motionPool()[i].setMp(q0[i]);
+	model->solverPool()[1].kinPos();
+	double pe0[6];
+	model->generalMotionPool()[0].getMpe(pe0, "312");
+
+	// 312 欧拉角的第一个角为 0，设定点越过 0 即 2π 处，姿态插值不能绕一整圈 //
+	auto start = cs.executeCmd(aris::core::Msg("stm --start --space=pe --eul_type=312 --interval=50 --underrun_limit=0"));
+	const double pe[12]
+	{
+		pe0[0], pe0[1], pe0[2], 2 * aris::PI - 0.01, pe0[4], pe0[5],
+		pe0[0], pe0[1], pe0[2], 2 * aris::PI - 0.02, pe0[4], pe0[5],
+	};
+	if (aris::plan::StreamMove::pushSetpoint(pe, 2) != 2)std::cout << __FILE__ << " " << __LINE__ << ":test stream move pose failed" << std::endl;
+
+	double max_step{ 0.0 }, last[6]{ 0,0,0,0,0,0 };
+	for (int k = 0; k < 120; ++k)
+	{
+		cs.controller().step(1);
+		for (aris::Size i = 0; i < 6; ++i)
+		{
+			auto p = cs.controller().motionPool()[i].targetPos();
+			if (k > 0)max_step = std::max(max_step, std::abs(p - last[i]));
+			last[i] = p;
+		}
+	}
+	cs.executeCmd(aris::core::Msg("stm --stop"));
+	while (!start->finished.isFinished())cs.controller().step(1);
+
+	double end_pe[6];
+	cs.model().generalMotionPool()[0].updMpm();
+	cs.model().generalMotionPool()[0].getMpe(end_pe, "312");
+	if (start->ret_code != aris::plan::PlanTarget::SUCCESS || max_step > 1e-3 || std::abs(std::remainder(end_pe[3] + 0.02, 2 * aris::PI)) > 1e-6 || std::abs(end_pe[5] - pe0[5]) > 1e-6)
+		std::cout << __FILE__ << " " << __LINE__ << ":test stream move pose failed" << std::endl;
+
+	cs.stop();
+}
+
+void test_rt_snapshot()
+{
+	auto&cs = aris::server::ControlServer::instance();
+
+	cs.resetController(new aris::control::EthercatController);
+	cs.resetModel(aris::robot::createModelRokaeXB4().release());
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("long", nullptr, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 500 - param.count;
+	}, nullptr, "<Command name=\"test_long\"/>");
+	cs.planRoot().planPool().add<aris::plan::GetPartPq>();
+
+	aris::server::RtSnapshot snapshot;
+	if (cs.rtSnapshot(snapshot))std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+
+	// 杆件位姿默认不在快照中 //
+	if (cs.rtSnapshotItems() != aris::server::RtSnapshot::MOTION_STATE)std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+	cs.setRtSnapshotItems(aris::server::RtSnapshot::MOTION_STATE | aris::server::RtSnapshot::PART_PM);
+
+	cs.start();
+	aris::core::Msg long_cmd("test_long");
+	long_cmd.header().reserved1_ = aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	auto target = cs.executeCmd(long_cmd);
+
+	// 多个线程同时读取，每个线程读到的全局计数单调不减，且能读到正在执行的指令 //
+	// 读取到指令执行结束为止，避免负载较高时读取线程先于指令开始而结束 //
+	std::atomic_bool is_failed{ false }, is_found{ false }, is_finished{ false };
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 4; ++t)readers.push_back(std::thread([&]()
+	{
+		aris::server::RtSnapshot s;
+		std::int64_t last_count{ 0 };
+		while (!is_finished)
+		{
+			if (!cs.rtSnapshot(s)) { std::this_thread::yield(); continue; }
+			if (s.global_count < last_count || s.command_id.size() != 1 || s.part_pm.size() != cs.model().partPool().size() * 16)is_failed = true;
+			if (s.command_id[0] == static_cast<std::int64_t>(target->command_id))is_found = true;
+			last_count = s.global_count;
+		}
+	}));
+	target->finished.wait();
+	is_finished = true;
+	for (auto &r : readers)r.join();
+
+	if (is_failed || !is_found || target->ret_code != aris::plan::PlanTarget::SUCCESS)
+		std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+
+	// get_part_pq 从快照中读取 //
+	auto pq_target = cs.executeCmd(aris::core::Msg("get_part_pq"));
+	pq_target->finished.wait();
+	if (std::any_cast<std::string>(pq_target->ret).size() != cs.model().partPool().size() * 7 * sizeof(double))
+		std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+	cs.stop();
+
+	// 快照内容在启动时生效 //
+	cs.setRtSnapshotItems(0);
+	cs.start();
+	while (!cs.rtSnapshot(snapshot))std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	if (!snapshot.part_pm.empty() || !snapshot.target_pos.empty() || snapshot.error_code.size() != 1)
+		std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+	cs.stop();
+
+	// 读取的同时反复停止、启动并改变快照内容，读到的快照总是完整的 //
+	is_failed = false;
+	is_finished = false;
+	readers.clear();
+	for (int t = 0; t < 4; ++t)readers.push_back(std::thread([&]()
+	{
+		aris::server::RtSnapshot s;
+		while (!is_finished)
+		{
+			if (!cs.rtSnapshot(s))continue;
+			if (s.command_id.size() != 1 || (!s.part_pm.empty() && s.part_pm.size() != cs.model().partPool().size() * 16))is_failed = true;
+		}
+	}));
+	for (int i = 0; i < 10; ++i)
+	{
+		cs.setRtSnapshotItems(i % 2 ? aris::server::RtSnapshot::MOTION_STATE : aris::server::RtSnapshot::MOTION_STATE | aris::server::RtSnapshot::PART_PM);
+		cs.start();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		cs.stop();
+	}
+	is_finished = true;
+	for (auto &r : readers)r.join();
+	if (is_failed)std::cout << __FILE__ << " " << __LINE__ << ":test rt snapshot failed" << std::endl;
+
+	cs.setRtSnapshotItems(aris::server::RtSnapshot::MOTION_STATE);
+}
+
+void test_replay()
+{
+	auto&cs = aris::server::ControlServer::instance();
+	auto reset = [&]()
+	{
+		// 两个仿真电机，控制器以虚拟时间运行 //
+		auto controller = new aris::control::Controller;
+		controller->slavePool().add<aris::control::SimulatedMotion>("m0", 0, 10.0, -10.0, 10.0, -10.0, 1000.0, -1000.0, 1.0, 1.0);
+		controller->slavePool().add<aris::control::SimulatedMotion>("m1", 1, 10.0, -10.0, 10.0, -10.0, 1000.0, -1000.0, 1.0, 1.0);
+		controller->setVirtualTime(true);
+		cs.resetController(controller);
+	};
+	reset();
+	cs.resetModel(new aris::dynamic::Model);
+	cs.resetSensorRoot(new aris::sensor::SensorRoot);
+	cs.resetPlanRoot(new aris::plan::PlanRoot);
+
+	const std::uint64_t option = aris::plan::Plan::NOT_PRINT_CMD_INFO | aris::plan::Plan::NOT_PRINT_EXECUTE_COUNT | aris::plan::Plan::NOT_LOG_CMD_INFO;
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("enable", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		target.option |= option | aris::plan::Plan::NOT_CHECK_OPERATION_ENABLE;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		int ret = 0;
+		for (auto &m : param.controller->motionPool())ret += std::abs(m.enable()) + std::abs(m.mode(8));
+		return ret;
+	}, nullptr, "<Command name=\"test_enable\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("move", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		target.option |= option;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		auto &m = param.controller->motionPool()[0];
+		m.setTargetPos(m.targetPos() + 0.0001);
+		return 100 - param.count;
+	}, nullptr, "<Command name=\"test_move\"/>");
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("wait", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		target.option |= option | aris::plan::Plan::WAIT_FOR_COLLECTION;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		return 10 - param.count;
+	}, nullptr, "<Command name=\"test_wait\"/>");
+
+	std::stringstream ss("# enable, then move twice\n0 test_enable\n\n5 test_move\n20 test_wait\n30 test_move\n40 test_unknown\n");
+	auto script = aris::server::loadReplayScript(ss);
+	if (script.size() != 5 || script[1].count != 5 || script[1].cmd != "test_move")
+		std::cout << __FILE__ << " " << __LINE__ << ":test replay failed" << std::endl;
+
+	// 同一脚本回放两次，周期数和结果完全相同 //
+	std::int64_t total_count[2];
+	double pos[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		cs.start();
+		auto result = aris::server::replay(cs, script);
+		total_count[i] = result.total_count;
+		pos[i] = cs.controller().motionPool()[0].actualPos();
+
+		if (result.targets.size() != 5 || result.targets[4] != nullptr
+			|| std::any_of(result.targets.begin(), result.targets.begin() + 4, [](auto &t) { return !t || t->ret_code != aris::plan::PlanTarget::SUCCESS; }))
+			std::cout << __FILE__ << " " << __LINE__ << ":test replay failed" << std::endl;
+		cs.stop();
+		reset();
+	}
+	if (total_count[0] != total_count[1] || std::abs(pos[0] - 0.02) > 1e-10 || std::abs(pos[1] - 0.02) > 1e-10)
+		std::cout << __FILE__ << " " << __LINE__ << ":test replay failed" << std::endl;
+
+	// prepairNrt 耗时不同时，每个周期的指令位置仍完全相同 //
+	int slow_ms{ 0 };
+	std::vector<std::array<double, 3>> trace;
+	cs.planRoot().planPool().add<aris::plan::UniversalPlan>("slow", [&](const std::map<std::string, std::string> &, aris::plan::PlanTarget &target)->void
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(slow_ms));
+		target.option |= option | aris::plan::Plan::WAIT_FOR_EXECUTION;
+	}, [&](const aris::plan::PlanTarget &param)->int
+	{
+		auto &m0 = param.controller->motionPool()[0];
+		auto &m1 = param.controller->motionPool()[1];
+		m1.setTargetPos(m1.targetPos() + 0.0001);
+		trace.push_back({ static_cast<double>(param.controller->cycleCount()), m0.targetPos(), m1.targetPos() });
+		return 30 - param.count;
+	}, nullptr, "<Command name=\"test_slow\"/>");
+
+	std::stringstream slow_ss("0 test_enable\n5 test_move\n10 test_slow\n11 test_slow\n12 test_move\n");
+	auto slow_script = aris::server::loadReplayScript(slow_ss);
+	std::vector<std::array<double, 3>> traces[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		slow_ms = i == 0 ? 1 : 30;
+		trace.clear();
+		trace.reserve(1000);
+		cs.start();
+		total_count[i] = aris::server::replay(cs, slow_script).total_count;
+		traces[i] = trace;
+		cs.stop();
+		reset();
+	}
+	if (total_count[0] != total_count[1] || traces[0].size() != 60 || traces[0] != traces[1])
+		std::cout << __FILE__ << " " << __LINE__ << ":test replay failed" << std::endl;
+
+	// 没有以虚拟时间启动时不能回放 //
+	cs.controller().setVirtualTime(false);
+	cs.start();
+	try
+	{
+		aris::server::replay(cs, script);
+		std::cout << __FILE__ << " " << __LINE__ << ":test replay failed" << std::endl;
+	}
+	catch (std::exception &) {}
+	cs.stop();
+}
+
 void test_control_server()
 {
 	test_server_option();
+	test_recorder();
+	test_concurrent_execute();
+	test_target_completion();
+	test_motion_checker();
+	test_motion_group();
+	test_blend();
+	test_blend_move_l();
+	test_stream_move();
+	test_stream_move_pose();
+	test_rt_snapshot();
+	test_replay();
 }
 